@@ -8,6 +8,9 @@
 package com.facebook.react.fabric;
 
 import android.annotation.SuppressLint;
+import android.content.Context;
+import android.content.pm.PackageManager;
+import android.os.Build;
 import androidx.annotation.NonNull;
 import com.facebook.jni.HybridData;
 import com.facebook.proguard.annotations.DoNotStrip;
@@ -16,6 +19,9 @@ import com.facebook.react.bridge.RuntimeExecutor;
 import com.facebook.react.bridge.queue.MessageQueueThread;
 import com.facebook.react.fabric.events.EventBeatManager;
 import com.facebook.react.uimanager.PixelUtil;
+import java.io.File;
+import java.util.Arrays;
+import java.util.Locale;
 
 @DoNotStrip
 @SuppressLint("MissingNativeLoadLibrary")
@@ -25,6 +31,8 @@ public class Binding {
     FabricSoLoader.staticInit();
   }
 
+  private static final String TEXT_MEASURE_CACHE_FILE_NAME = "fabric_text_measure_cache";
+
   @DoNotStrip private final HybridData mHybridData;
 
   private static native HybridData initHybrid();
@@ -39,7 +47,9 @@ public class Binding {
       EventBeatManager eventBeatManager,
       MessageQueueThread jsMessageQueueThread,
       ComponentFactory componentsRegistry,
-      Object reactNativeConfig);
+      Object reactNativeConfig,
+      String textMeasureCachePath,
+      long textMeasureCacheFontFingerprint);
 
   public native void startSurface(
       int surfaceId, @NonNull String moduleName, @NonNull NativeMap initialProps);
@@ -76,6 +86,12 @@ public class Binding {
 
   public native void driveCxxAnimations();
 
+  /**
+   * Writes the text measurements made so far to the file they are loaded from on the next start.
+   * Returns immediately; the file is written on a background thread.
+   */
+  public native void saveTextMeasureCache();
+
   // TODO (T67721598) Remove the jsContext param once we've migrated to using RuntimeExecutor
   public void register(
       @NonNull RuntimeExecutor runtimeExecutor,
@@ -85,16 +101,41 @@ public class Binding {
       @NonNull ComponentFactory componentFactory,
       @NonNull ReactNativeConfig reactNativeConfig) {
     fabricUIManager.setBinding(this);
+    Context context = fabricUIManager.getReactApplicationContext();
     installFabricUIManager(
         runtimeExecutor,
         fabricUIManager,
         eventBeatManager,
         jsMessageQueueThread,
         componentFactory,
-        reactNativeConfig);
+        reactNativeConfig,
+        new File(context.getCacheDir(), TEXT_MEASURE_CACHE_FILE_NAME).getPath(),
+        getTextMeasureCacheFontFingerprint(context));
     setPixelDensity(PixelUtil.getDisplayMetricDensity());
   }
 
+  /**
+   * Identifies everything stored text measurements depend on besides the text itself: the fonts
+   * bundled with the app (which change with its updates), the system fonts (which change with
+   * system updates), the locale and the font scale.
+   */
+  private static long getTextMeasureCacheFontFingerprint(Context context) {
+    long appUpdateTime = 0;
+    try {
+      appUpdateTime =
+          context.getPackageManager().getPackageInfo(context.getPackageName(), 0).lastUpdateTime;
+    } catch (PackageManager.NameNotFoundException e) {
+      // Measurements are then only invalidated by the other fields.
+    }
+    return Arrays.hashCode(
+        new Object[] {
+          appUpdateTime,
+          Build.FINGERPRINT,
+          Locale.getDefault().toString(),
+          context.getResources().getConfiguration().fontScale
+        });
+  }
+
   private native void uninstallFabricUIManager();
 
   public void unregister() {
@@ -53,6 +53,7 @@ import com.facebook.react.bridge.UIManager;
 import com.facebook.react.bridge.UIManagerListener;
 import com.facebook.react.bridge.UiThreadUtil;
 import com.facebook.react.bridge.WritableMap;
+import com.facebook.react.bridge.WritableNativeArray;
 import com.facebook.react.config.ReactFeatureFlags;
 import com.facebook.react.fabric.events.EventBeatManager;
 import com.facebook.react.fabric.events.EventEmitterWrapper;
@@ -473,6 +474,58 @@ public class FabricUIManager implements UIManager, LifecycleEventListener {
             PixelUtil.toPixelFromDIP(width));
   }
 
+  /**
+   * Measures lines of a batch of attributed strings, saving a JNI call per string.
+   *
+   * @param requests {@link ReadableArray} of maps with "attributedString", "paragraphAttributes",
+   *     "width" and "height" keys.
+   * @return {@link NativeArray} of the results of {@link #measureLines} for each request.
+   */
+  @DoNotStrip
+  @SuppressWarnings("unused")
+  private NativeArray measureLinesBatch(ReadableArray requests) {
+    WritableNativeArray linesMeasurements = new WritableNativeArray();
+    for (int i = 0; i < requests.size(); i++) {
+      ReadableMap request = requests.getMap(i);
+      linesMeasurements.pushArray(
+          TextLayoutManager.measureLines(
+              mReactApplicationContext,
+              request.getMap("attributedString"),
+              request.getMap("paragraphAttributes"),
+              PixelUtil.toPixelFromDIP((float) request.getDouble("width"))));
+    }
+    return linesMeasurements;
+  }
+
+  /**
+   * Measures a batch of attributed strings (without attachments), saving a JNI call per string.
+   *
+   * @param requests {@link ReadableArray} of maps with "attributedString", "paragraphAttributes",
+   *     "minWidth", "maxWidth", "minHeight" and "maxHeight" keys.
+   * @return the results of {@link #measure} for each request.
+   */
+  @DoNotStrip
+  @SuppressWarnings("unused")
+  private long[] measureBatch(ReadableArray requests) {
+    long[] measurements = new long[requests.size()];
+    for (int i = 0; i < requests.size(); i++) {
+      ReadableMap request = requests.getMap(i);
+      measurements[i] =
+          measure(
+              -1,
+              "RCTText",
+              request.getMap("attributedString"),
+              request.getMap("paragraphAttributes"),
+              null,
+              (float) request.getDouble("minWidth"),
+              (float) request.getDouble("maxWidth"),
+              (float) request.getDouble("minHeight"),
+              (float) request.getDouble("maxHeight"),
+              null);
+    }
+    return measurements;
+  }
+
   @DoNotStrip
   @SuppressWarnings("unused")
   private long measure(
@@ -1027,6 +1080,11 @@ public class FabricUIManager implements UIManager, LifecycleEventListener {
     Systrace.endSection(Systrace.TRACE_TAG_REACT_JAVA_BRIDGE);
   }
 
+  @NonNull
+  ReactApplicationContext getReactApplicationContext() {
+    return mReactApplicationContext;
+  }
+
   public void setBinding(Binding binding) {
     mBinding = binding;
   }
@@ -1097,6 +1155,11 @@ public class FabricUIManager implements UIManager, LifecycleEventListener {
   public void onHostPause() {
     ReactChoreographer.getInstance()
         .removeFrameCallback(ReactChoreographer.CallbackType.DISPATCH_UI, mDispatchUIFrameCallback);
+
+    // The app may be killed in background, so this is the last chance to store the measurements.
+    if (mBinding != null) {
+      mBinding.saveTextMeasureCache();
+    }
   }
 
   @Override
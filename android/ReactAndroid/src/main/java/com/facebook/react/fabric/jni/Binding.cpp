@@ -25,11 +25,14 @@
 #include <react/renderer/scheduler/Scheduler.h>
 #include <react/renderer/scheduler/SchedulerDelegate.h>
 #include <react/renderer/scheduler/SchedulerToolbox.h>
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
 #include <react/renderer/uimanager/primitives.h>
 #include <react/utils/ContextContainer.h>
 
 #include <glog/logging.h>
 
+#include <thread>
+
 using namespace facebook::jni;
 using namespace facebook::jsi;
 
@@ -386,7 +389,9 @@ void Binding::installFabricUIManager(
     EventBeatManager *eventBeatManager,
     jni::alias_ref<JavaMessageQueueThread::javaobject> jsMessageQueueThread,
     ComponentFactory *componentsRegistry,
-    jni::alias_ref<jobject> reactNativeConfig) {
+    jni::alias_ref<jobject> reactNativeConfig,
+    jni::alias_ref<jstring> textMeasureCachePath,
+    jlong textMeasureCacheFontFingerprint) {
   SystraceSection s("FabricUIManagerBinding::installFabricUIManager");
 
   std::shared_ptr<const ReactNativeConfig> config =
@@ -435,6 +440,19 @@ void Binding::installFabricUIManager(
   contextContainer->insert("ReactNativeConfig", config);
   contextContainer->insert("FabricUIManager", javaUIManager_);
 
+  // Text layout managers share the cache (see `PersistentTextMeasureCache`),
+  // which `saveTextMeasureCache` writes when the app goes to background.
+  enablePersistentTextMeasureCache_ = textMeasureCachePath &&
+      config->getBool(
+          "react_fabric:enable_persistent_text_measure_cache_android");
+  if (enablePersistentTextMeasureCache_) {
+    contextContainer->insert(
+        "TextMeasureCachePath", textMeasureCachePath->toStdString());
+    contextContainer->insert(
+        "TextMeasureCacheFontFingerprint",
+        static_cast<int64_t>(textMeasureCacheFontFingerprint));
+  }
+
   // Keep reference to config object and cache some feature flags here
   reactNativeConfig_ = config;
   collapseDeleteCreateMountingInstructions_ =
@@ -1520,6 +1538,15 @@ void Binding::driveCxxAnimations() {
   scheduler_->animationTick();
 }
 
+void Binding::saveTextMeasureCache() {
+  if (!enablePersistentTextMeasureCache_) {
+    return;
+  }
+
+  // Called on the UI thread; writing the file doesn't need to block it.
+  std::thread([]() { PersistentTextMeasureCache::saveShared(); }).detach();
+}
+
 void Binding::schedulerDidRequestPreliminaryViewAllocation(
     const SurfaceId surfaceId,
     const ShadowView &shadowView) {
@@ -1646,6 +1673,7 @@ void Binding::registerNatives() {
        makeNativeMethod("setConstraints", Binding::setConstraints),
        makeNativeMethod("setPixelDensity", Binding::setPixelDensity),
        makeNativeMethod("driveCxxAnimations", Binding::driveCxxAnimations),
+       makeNativeMethod("saveTextMeasureCache", Binding::saveTextMeasureCache),
        makeNativeMethod(
            "uninstallFabricUIManager", Binding::uninstallFabricUIManager)});
 }
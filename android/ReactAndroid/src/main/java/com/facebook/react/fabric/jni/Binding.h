@@ -100,7 +100,9 @@ class Binding : public jni::HybridClass<Binding>,
       EventBeatManager *eventBeatManager,
       jni::alias_ref<JavaMessageQueueThread::javaobject> jsMessageQueueThread,
       ComponentFactory *componentsRegistry,
-      jni::alias_ref<jobject> reactNativeConfig);
+      jni::alias_ref<jobject> reactNativeConfig,
+      jni::alias_ref<jstring> textMeasureCachePath,
+      jlong textMeasureCacheFontFingerprint);
 
   void startSurface(
       jint surfaceId,
@@ -148,6 +150,8 @@ class Binding : public jni::HybridClass<Binding>,
 
   void driveCxxAnimations();
 
+  void saveTextMeasureCache();
+
   void uninstallFabricUIManager();
 
   // Private member variables
@@ -175,6 +179,8 @@ class Binding : public jni::HybridClass<Binding>,
   bool disableVirtualNodePreallocation_{false};
   bool enableFabricLogs_{false};
 
+  bool enablePersistentTextMeasureCache_{false};
+
  private:
   void schedulerDidFinishTransactionIntBuffer(
       MountingCoordinator::Shared const &mountingCoordinator);
@@ -46,6 +46,7 @@ bool Fragment::operator!=(const Fragment &rhs) const {
 
 void AttributedString::appendFragment(const Fragment &fragment) {
   ensureUnsealed();
+  hasLayoutWiseHash_ = false;
 
   if (fragment.string.empty()) {
     return;
@@ -56,6 +57,7 @@ void AttributedString::appendFragment(const Fragment &fragment) {
 
 void AttributedString::prependFragment(const Fragment &fragment) {
   ensureUnsealed();
+  hasLayoutWiseHash_ = false;
 
   if (fragment.string.empty()) {
     return;
@@ -67,6 +69,7 @@ void AttributedString::prependFragment(const Fragment &fragment) {
 void AttributedString::appendAttributedString(
     const AttributedString &attributedString) {
   ensureUnsealed();
+  hasLayoutWiseHash_ = false;
   fragments_.insert(
       fragments_.end(),
       attributedString.fragments_.begin(),
@@ -76,6 +79,7 @@ void AttributedString::appendAttributedString(
 void AttributedString::prependAttributedString(
     const AttributedString &attributedString) {
   ensureUnsealed();
+  hasLayoutWiseHash_ = false;
   fragments_.insert(
       fragments_.begin(),
       attributedString.fragments_.begin(),
@@ -87,9 +91,17 @@ Fragments const &AttributedString::getFragments() const {
 }
 
 Fragments &AttributedString::getFragments() {
+  hasLayoutWiseHash_ = false;
   return fragments_;
 }
 
+void AttributedString::setFragmentLayoutMetrics(
+    size_t fragmentIndex,
+    LayoutMetrics const &layoutMetrics) {
+  ensureUnsealed();
+  fragments_.at(fragmentIndex).parentShadowView.layoutMetrics = layoutMetrics;
+}
+
 std::string AttributedString::getString() const {
   auto string = std::string{};
   for (const auto &fragment : fragments_) {
@@ -126,6 +138,25 @@ bool AttributedString::operator!=(const AttributedString &rhs) const {
   return !(*this == rhs);
 }
 
+void AttributedString::sealWithLayoutWiseHash() const {
+  layoutWiseHash_ = getLayoutWiseHash();
+  hasLayoutWiseHash_ = true;
+  Sealable::seal();
+}
+
+size_t AttributedString::getLayoutWiseHash() const {
+  if (hasLayoutWiseHash_) {
+    return layoutWiseHash_;
+  }
+
+  auto seed = size_t{0};
+  for (auto const &fragment : fragments_) {
+    seed =
+        folly::hash::hash_combine(seed, textAttributesHashLayoutWise(fragment));
+  }
+  return seed;
+}
+
 #pragma mark - DebugStringConvertible
 
 #if RN_DEBUG_STRING_CONVERTIBLE
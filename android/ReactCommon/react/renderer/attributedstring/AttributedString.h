@@ -82,6 +82,15 @@ class AttributedString : public Sealable, public DebugStringConvertible {
    */
   Fragments &getFragments();
 
+  /*
+   * Sets the layout metrics of the attachment of the fragment at
+   * `fragmentIndex`. Unlike other mutating methods, keeps the stored
+   * layout-wise hash, which doesn't take layout metrics into account.
+   */
+  void setFragmentLayoutMetrics(
+      size_t fragmentIndex,
+      LayoutMetrics const &layoutMetrics);
+
   /*
    * Returns a string constructed from all strings in all fragments.
    */
@@ -100,6 +109,22 @@ class AttributedString : public Sealable, public DebugStringConvertible {
   bool operator==(const AttributedString &rhs) const;
   bool operator!=(const AttributedString &rhs) const;
 
+  /*
+   * Seals the string and stores its layout-wise hash, so the string and all
+   * its copies don't need to compute it again.
+   * A separate method because `Sealable::seal()` is not virtual: sealing a
+   * string through a `Sealable` reference must not look like it stored the
+   * hash.
+   */
+  void sealWithLayoutWiseHash() const;
+
+  /*
+   * Returns a hash of the fragments which takes into account only what
+   * affects the layout of the string (see `textAttributesHashLayoutWise`).
+   * Until the string is sealed, the hash is computed on every call.
+   */
+  size_t getLayoutWiseHash() const;
+
 #pragma mark - DebugStringConvertible
 
 #if RN_DEBUG_STRING_CONVERTIBLE
@@ -108,8 +133,44 @@ class AttributedString : public Sealable, public DebugStringConvertible {
 
  private:
   Fragments fragments_;
+
+  /*
+   * Stored by `sealWithLayoutWiseHash()` and kept by copies; reset by all
+   * mutating methods.
+   */
+  mutable size_t layoutWiseHash_{0};
+  mutable bool hasLayoutWiseHash_{false};
 };
 
+inline size_t textAttributesHashLayoutWise(
+    TextAttributes const &textAttributes) {
+  // Taking into account the same props as
+  // `areTextAttributesEquivalentLayoutWise` mentions.
+  return folly::hash::hash_combine(
+      0,
+      textAttributes.fontFamily,
+      textAttributes.fontSize,
+      textAttributes.fontSizeMultiplier,
+      textAttributes.fontWeight,
+      textAttributes.fontStyle,
+      textAttributes.fontVariant,
+      textAttributes.allowFontScaling,
+      textAttributes.letterSpacing,
+      textAttributes.lineHeight,
+      textAttributes.alignment);
+}
+
+inline size_t textAttributesHashLayoutWise(
+    AttributedString::Fragment const &fragment) {
+  // Here we are not taking `isAttachment` and `layoutMetrics` into account
+  // because they are logically interdependent and this can break an invariant
+  // between hash and equivalence functions (and cause cache misses).
+  return folly::hash::hash_combine(
+      0,
+      fragment.string,
+      textAttributesHashLayoutWise(fragment.textAttributes));
+}
+
 } // namespace react
 } // namespace facebook
 
@@ -46,5 +46,65 @@ TEST(AttributedStringTest, testToDynamic) {
 
 #endif
 
+TEST(AttributedStringTest, testLayoutWiseHash) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = "test";
+  fragment.textAttributes.fontSize = 12;
+
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  auto hash = attributedString.getLayoutWiseHash();
+
+  // Attributes which don't affect layout don't affect the hash.
+  auto coloredFragment = fragment;
+  coloredFragment.textAttributes.foregroundColor =
+      colorFromComponents({1.0, 0.0, 0.0, 1.0});
+  auto coloredAttributedString = AttributedString{};
+  coloredAttributedString.appendFragment(coloredFragment);
+  EXPECT_EQ(coloredAttributedString.getLayoutWiseHash(), hash);
+
+  // Copies of a sealed string keep its hash until they are mutated.
+  attributedString.sealWithLayoutWiseHash();
+  EXPECT_EQ(attributedString.getLayoutWiseHash(), hash);
+  auto copy = attributedString;
+  EXPECT_EQ(copy.getLayoutWiseHash(), hash);
+  copy.appendFragment(fragment);
+  EXPECT_NE(copy.getLayoutWiseHash(), hash);
+
+  auto expected = AttributedString{};
+  expected.appendFragment(fragment);
+  expected.appendFragment(fragment);
+  EXPECT_EQ(copy.getLayoutWiseHash(), expected.getLayoutWiseHash());
+}
+
+TEST(AttributedStringTest, testFragmentLayoutMetrics) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = "test";
+
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  attributedString.appendFragment(fragment);
+  attributedString.sealWithLayoutWiseHash();
+  auto hash = attributedString.getLayoutWiseHash();
+
+  auto layoutMetrics = LayoutMetrics{};
+  layoutMetrics.frame.size = Size{10, 20};
+
+  // Layout metrics don't affect the hash, so the copy keeps it.
+  auto copy = attributedString;
+  copy.setFragmentLayoutMetrics(1, layoutMetrics);
+  EXPECT_EQ(copy.getLayoutWiseHash(), hash);
+
+  auto const &constCopy = copy;
+  auto const &fragments = constCopy.getFragments();
+  EXPECT_EQ(fragments[0].parentShadowView.layoutMetrics, LayoutMetrics{});
+  EXPECT_EQ(fragments[1].parentShadowView.layoutMetrics, layoutMetrics);
+
+  auto const &original = attributedString;
+  EXPECT_EQ(
+      original.getFragments()[1].parentShadowView.layoutMetrics,
+      LayoutMetrics{});
+}
+
 } // namespace react
 } // namespace facebook
@@ -33,6 +33,10 @@ bool RootShadowNode::layoutIfNeeded(
   return true;
 }
 
+void RootShadowNode::prepareLayout() const {
+  prepareLayoutTree(getConcreteProps().layoutContext);
+}
+
 Transform RootShadowNode::getTransform() const {
   auto viewportOffset = getConcreteProps().layoutContext.viewportOffset;
   return Transform::Translate(viewportOffset.x, viewportOffset.y, 0);
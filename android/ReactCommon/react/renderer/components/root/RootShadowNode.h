@@ -47,6 +47,12 @@ class RootShadowNode final
   bool layoutIfNeeded(
       std::vector<LayoutableShadowNode const *> *affectedNodes = {});
 
+  /*
+   * Prepares the shadow tree to be laid out later, possibly on another thread
+   * (see `prepareLayoutTree`).
+   */
+  void prepareLayout() const;
+
   /*
    * Clones the node with given `layoutConstraints` and `layoutContext`.
    */
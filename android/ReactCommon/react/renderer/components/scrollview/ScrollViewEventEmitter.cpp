@@ -10,9 +10,13 @@
 namespace facebook {
 namespace react {
 
-static jsi::Value scrollViewMetricsPayload(
+static_assert(
+    EventPayload::isStoredInline<ScrollViewMetrics>(),
+    "`ScrollViewMetrics` payloads must be stored inline.");
+
+jsi::Value toEventPayloadValue(
     jsi::Runtime &runtime,
-    const ScrollViewMetrics &scrollViewMetrics) {
+    ScrollViewMetrics const &scrollViewMetrics) {
   auto payload = jsi::Object(runtime);
 
   {
@@ -60,9 +64,8 @@ static jsi::Value scrollViewMetricsPayload(
 
 void ScrollViewEventEmitter::onScroll(
     const ScrollViewMetrics &scrollViewMetrics) const {
-  dispatchUniqueEvent("scroll", [scrollViewMetrics](jsi::Runtime &runtime) {
-    return scrollViewMetricsPayload(runtime, scrollViewMetrics);
-  });
+  static auto const type = EventType("scroll");
+  dispatchUniqueEvent(type, EventPayload(scrollViewMetrics));
 }
 
 void ScrollViewEventEmitter::onScrollBeginDrag(
@@ -86,15 +89,10 @@ void ScrollViewEventEmitter::onMomentumScrollEnd(
 }
 
 void ScrollViewEventEmitter::dispatchScrollViewEvent(
-    const std::string &name,
+    const EventType &type,
     const ScrollViewMetrics &scrollViewMetrics,
     EventPriority priority) const {
-  dispatchEvent(
-      name,
-      [scrollViewMetrics](jsi::Runtime &runtime) {
-        return scrollViewMetricsPayload(runtime, scrollViewMetrics);
-      },
-      priority);
+  dispatchEvent(type, EventPayload(scrollViewMetrics), priority);
 }
 
 } // namespace react
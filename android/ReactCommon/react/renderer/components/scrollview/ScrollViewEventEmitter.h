@@ -26,6 +26,14 @@ class ScrollViewMetrics {
   Float zoomScale;
 };
 
+/*
+ * Converts `ScrollViewMetrics` to the payload of a scroll event (see
+ * `EventPayload`).
+ */
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    ScrollViewMetrics const &scrollViewMetrics);
+
 class ScrollViewEventEmitter : public ViewEventEmitter {
  public:
   using ViewEventEmitter::ViewEventEmitter;
@@ -38,7 +46,7 @@ class ScrollViewEventEmitter : public ViewEventEmitter {
 
  private:
   void dispatchScrollViewEvent(
-      const std::string &name,
+      const EventType &type,
       const ScrollViewMetrics &scrollViewMetrics,
       EventPriority priority = EventPriority::AsynchronousBatched) const;
 };
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "ParagraphMeasurePrefetcher.h"
 #include "ParagraphShadowNode.h"
 
 #include <react/config/ReactNativeConfig.h>
@@ -29,6 +30,21 @@ class ParagraphComponentDescriptor final
     // Every single `ParagraphShadowNode` will have a reference to
     // a shared `TextLayoutManager`.
     textLayoutManager_ = std::make_shared<TextLayoutManager>(contextContainer_);
+
+    measurePrefetcher_ = ParagraphMeasurePrefetcher::create(
+        contextContainer_, textLayoutManager_);
+  }
+
+  /*
+   * Returns the stats of measurements prefetched for the nodes created by
+   * the descriptor, or `nullopt` if prefetching is disabled.
+   */
+  better::optional<ParagraphMeasurePrefetcher::Stats> getMeasurePrefetchStats()
+      const {
+    if (!measurePrefetcher_) {
+      return {};
+    }
+    return measurePrefetcher_->getStats();
   }
 
   virtual SharedProps interpolateProps(
@@ -55,6 +71,10 @@ class ParagraphComponentDescriptor final
     // and communicate text rendering metrics to mounting layer.
     paragraphShadowNode->setTextLayoutManager(textLayoutManager_);
 
+    // Nodes of committed trees which are laid out in the background start
+    // measuring their text ahead of layout.
+    paragraphShadowNode->setMeasurePrefetcher(measurePrefetcher_);
+
     paragraphShadowNode->dirtyLayout();
 
     // All `ParagraphShadowNode`s must have leaf Yoga nodes with properly
@@ -64,6 +84,7 @@ class ParagraphComponentDescriptor final
 
  private:
   SharedTextLayoutManager textLayoutManager_;
+  ParagraphMeasurePrefetcher::Shared measurePrefetcher_;
 };
 
 } // namespace react
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ParagraphMeasurePrefetcher.h"
+
+namespace facebook {
+namespace react {
+
+// Enough for the text visible on a few screens.
+static size_t const kPredictionCountCap = 1024;
+
+constexpr size_t ParagraphMeasurePrefetcher::kDefaultMaximumPendingCount;
+
+static bool operator==(
+    ParagraphMeasurePrefetcher::Prediction const &lhs,
+    ParagraphMeasurePrefetcher::Prediction const &rhs) {
+  return lhs.contentHash == rhs.contentHash &&
+      lhs.layoutConstraints == rhs.layoutConstraints;
+}
+
+ParagraphMeasurePrefetcher::Shared ParagraphMeasurePrefetcher::create(
+    ContextContainer::Shared const &contextContainer,
+    SharedTextLayoutManager textLayoutManager) {
+  if (!contextContainer) {
+    return nullptr;
+  }
+
+  auto backgroundExecutor = contextContainer->find<BackgroundExecutor>(
+      "TextMeasurePrefetchExecutor");
+  if (!backgroundExecutor || !*backgroundExecutor) {
+    return nullptr;
+  }
+
+  return std::make_shared<ParagraphMeasurePrefetcher const>(
+      *backgroundExecutor, std::move(textLayoutManager));
+}
+
+ParagraphMeasurePrefetcher::ParagraphMeasurePrefetcher(
+    BackgroundExecutor backgroundExecutor,
+    SharedTextLayoutManager textLayoutManager,
+    size_t maximumPendingCount)
+    : backgroundExecutor_(std::move(backgroundExecutor)),
+      textLayoutManager_(std::move(textLayoutManager)),
+      maximumPendingCount_(maximumPendingCount),
+      predictions_(kPredictionCountCap),
+      prefetched_(kPredictionCountCap) {}
+
+better::optional<ParagraphMeasurePrefetcher::Prediction>
+ParagraphMeasurePrefetcher::getPrediction(Tag tag) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iterator = predictions_.find(tag);
+  if (iterator == predictions_.end()) {
+    return {};
+  }
+  return iterator->second;
+}
+
+void ParagraphMeasurePrefetcher::prefetch(
+    Tag tag,
+    Prediction const &prediction,
+    RequestBuilder requestBuilder) const {
+  if (pendingCount_.fetch_add(1) >= maximumPendingCount_) {
+    pendingCount_.fetch_sub(1);
+    droppedCount_++;
+    return;
+  }
+
+  submittedCount_++;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pendingPrefetches_.push_back({tag, prediction, std::move(requestBuilder)});
+    if (isMeasuring_) {
+      return;
+    }
+    isMeasuring_ = true;
+  }
+
+  auto self = shared_from_this();
+  backgroundExecutor_([self] { self->measurePendingPrefetches(); });
+}
+
+void ParagraphMeasurePrefetcher::measurePendingPrefetches() const {
+  while (true) {
+    auto prefetches = std::vector<PendingPrefetch>{};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (pendingPrefetches_.empty()) {
+        isMeasuring_ = false;
+        return;
+      }
+      std::swap(prefetches, pendingPrefetches_);
+    }
+
+    auto requests = std::vector<TextMeasureRequest>{};
+    requests.reserve(prefetches.size());
+    for (auto const &prefetch : prefetches) {
+      auto prediction = prefetch.prediction;
+      auto request = prefetch.requestBuilder(prediction);
+      if (!request) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto iterator = predictions_.find(prefetch.tag);
+      if (iterator == predictions_.end() ||
+          !(iterator->second == prefetch.prediction)) {
+        // Layout measured the family after the prefetch was submitted.
+        continue;
+      }
+
+      prefetched_.set(prefetch.tag, prediction);
+      requests.push_back(std::move(*request));
+    }
+
+    if (!requests.empty()) {
+      textLayoutManager_->measureBatch(requests);
+    }
+    pendingCount_.fetch_sub(prefetches.size());
+  }
+}
+
+void ParagraphMeasurePrefetcher::didMeasure(
+    Tag tag,
+    Prediction const &prediction) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto iterator = prefetched_.find(tag);
+  if (iterator != prefetched_.end()) {
+    if (iterator->second == prediction) {
+      hitCount_++;
+    } else {
+      missCount_++;
+    }
+    prefetched_.erase(tag);
+  }
+
+  predictions_.set(tag, prediction);
+}
+
+ParagraphMeasurePrefetcher::Stats ParagraphMeasurePrefetcher::getStats()
+    const {
+  auto stats = Stats{};
+  stats.submittedCount = submittedCount_.load(std::memory_order_relaxed);
+  stats.droppedCount = droppedCount_.load(std::memory_order_relaxed);
+  stats.hitCount = hitCount_.load(std::memory_order_relaxed);
+  stats.missCount = missCount_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace react
+} // namespace facebook
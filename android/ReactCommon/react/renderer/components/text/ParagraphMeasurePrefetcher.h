@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <better/optional.h>
+#include <folly/container/EvictingCacheMap.h>
+#include <react/renderer/attributedstring/AttributedString.h>
+#include <react/renderer/attributedstring/ParagraphAttributes.h>
+#include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/core/LayoutContext.h>
+#include <react/renderer/core/ReactPrimitives.h>
+#include <react/renderer/textlayoutmanager/TextLayoutManager.h>
+#include <react/renderer/uimanager/primitives.h>
+#include <react/utils/ContextContainer.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Measures the text of `ParagraphShadowNode`s in the background ahead of
+ * layout, so layout finds the measurements in the cache of
+ * `TextLayoutManager` (or waits for the one in progress instead of starting
+ * another).
+ * Layout constraints are predicted from the previous measurement of the same
+ * family; a node whose family wasn't measured yet is not prefetched.
+ * Mispredicted measurements are simply not used.
+ * Strings to measure are built in the background too, from sealed nodes of
+ * a committed tree (see `YogaLayoutableShadowNode::prefetchLayoutTree`).
+ * Prefetched strings are measured in batches (see
+ * `TextLayoutManager::measureBatch`): the strings submitted while a batch is
+ * being measured are measured together next.
+ * Can be used from any thread.
+ */
+class ParagraphMeasurePrefetcher final
+    : public std::enable_shared_from_this<ParagraphMeasurePrefetcher> {
+ public:
+  using Shared = std::shared_ptr<ParagraphMeasurePrefetcher const>;
+
+  /*
+   * What the previous measurement of a family was done with.
+   */
+  struct Prediction {
+    LayoutConstraints layoutConstraints;
+    Float fontSizeMultiplier;
+    LayoutDirection layoutDirection;
+    size_t contentHash;
+  };
+
+  /*
+   * Builds the request measuring the content of a node with `prediction` and
+   * sets `prediction.contentHash` to the hash of the content, or returns
+   * `nullopt` if there is nothing worth measuring. Called in the background.
+   * The attributed string of the request must be sealed with
+   * `sealWithLayoutWiseHash()`.
+   */
+  using RequestBuilder = std::function<better::optional<TextMeasureRequest>(
+      Prediction &prediction)>;
+
+  /*
+   * A prefetched measurement is a hit if layout measured the same content
+   * with the same layout constraints, and a miss otherwise. Submissions are
+   * dropped when too many measurements are pending.
+   */
+  struct Stats {
+    size_t submittedCount{0};
+    size_t droppedCount{0};
+    size_t hitCount{0};
+    size_t missCount{0};
+  };
+
+  /*
+   * Creates a prefetcher running measurements with the `BackgroundExecutor`
+   * stored in `contextContainer` with the "TextMeasurePrefetchExecutor" key,
+   * or returns `nullptr` if there is none (prefetching is disabled).
+   */
+  static Shared create(
+      ContextContainer::Shared const &contextContainer,
+      SharedTextLayoutManager textLayoutManager);
+
+  static constexpr size_t kDefaultMaximumPendingCount = 64;
+
+  ParagraphMeasurePrefetcher(
+      BackgroundExecutor backgroundExecutor,
+      SharedTextLayoutManager textLayoutManager,
+      size_t maximumPendingCount = kDefaultMaximumPendingCount);
+
+  /*
+   * Returns the prediction for the next measurement of the family with
+   * a given `tag`, if the family was measured before.
+   */
+  better::optional<Prediction> getPrediction(Tag tag) const;
+
+  /*
+   * Schedules building a request with `requestBuilder` and measuring it for
+   * the family with a given `tag`. `prediction` is the one `getPrediction`
+   * returned; the request is not measured if layout measured the family
+   * in the meantime.
+   */
+  void prefetch(
+      Tag tag,
+      Prediction const &prediction,
+      RequestBuilder requestBuilder) const;
+
+  /*
+   * Must be called by layout when it measures the content of the family with
+   * a given `tag`; updates the prediction and the stats.
+   */
+  void didMeasure(Tag tag, Prediction const &prediction) const;
+
+  Stats getStats() const;
+
+ private:
+  struct PendingPrefetch {
+    Tag tag;
+    Prediction prediction;
+    RequestBuilder requestBuilder;
+  };
+
+  /*
+   * Builds and measures batches of pending prefetches until there are none
+   * left.
+   */
+  void measurePendingPrefetches() const;
+
+  BackgroundExecutor const backgroundExecutor_;
+  SharedTextLayoutManager const textLayoutManager_;
+  size_t const maximumPendingCount_;
+
+  mutable std::mutex mutex_;
+  // Protected by `mutex_`.
+  mutable folly::EvictingCacheMap<Tag, Prediction> predictions_;
+  // Prefetched measurements which layout hasn't reached yet.
+  // Protected by `mutex_`.
+  mutable folly::EvictingCacheMap<Tag, Prediction> prefetched_;
+  // Protected by `mutex_`.
+  mutable std::vector<PendingPrefetch> pendingPrefetches_;
+  // Indicates that a task measuring `pendingPrefetches_` is scheduled or
+  // running. Protected by `mutex_`.
+  mutable bool isMeasuring_{false};
+
+  mutable std::atomic<size_t> pendingCount_{0};
+  mutable std::atomic<size_t> submittedCount_{0};
+  mutable std::atomic<size_t> droppedCount_{0};
+  mutable std::atomic<size_t> hitCount_{0};
+  mutable std::atomic<size_t> missCount_{0};
+};
+
+} // namespace react
+} // namespace facebook
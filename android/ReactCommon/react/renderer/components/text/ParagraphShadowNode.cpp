@@ -14,6 +14,7 @@
 #include <react/renderer/components/view/conversions.h>
 #include <react/renderer/graphics/rounding.h>
 #include <react/renderer/mounting/TransactionTelemetry.h>
+#include <react/renderer/textlayoutmanager/TextMeasureCache.h>
 
 #include "ParagraphState.h"
 
@@ -22,6 +23,37 @@ namespace react {
 
 using Content = ParagraphShadowNode::Content;
 
+namespace {
+
+/*
+ * The content of a paragraph as the shared Yoga measure cache compares it.
+ */
+class ParagraphMeasureContentKey final : public YGMeasureCache::Content {
+ public:
+  ParagraphMeasureContentKey(
+      ComponentHandle componentHandle,
+      Content const &content)
+      : componentHandle_(componentHandle),
+        attributedString_(content.attributedString),
+        paragraphAttributes_(content.paragraphAttributes) {}
+
+  bool isEqual(YGMeasureCache::Content const &other) const override {
+    auto otherKey = dynamic_cast<ParagraphMeasureContentKey const *>(&other);
+    return otherKey != nullptr &&
+        componentHandle_ == otherKey->componentHandle_ &&
+        paragraphAttributes_ == otherKey->paragraphAttributes_ &&
+        areAttributedStringsEquivalentLayoutWise(
+            attributedString_, otherKey->attributedString_);
+  }
+
+ private:
+  ComponentHandle componentHandle_;
+  AttributedString attributedString_;
+  ParagraphAttributes paragraphAttributes_;
+};
+
+} // namespace
+
 char const ParagraphComponentName[] = "Paragraph";
 
 Content const &ParagraphShadowNode::getContent(
@@ -32,21 +64,43 @@ Content const &ParagraphShadowNode::getContent(
 
   ensureUnsealed();
 
+  content_ =
+      buildContent(layoutContext.fontSizeMultiplier, getLayoutDirection());
+  return content_.value();
+}
+
+Content ParagraphShadowNode::buildContent(
+    Float fontSizeMultiplier,
+    LayoutDirection layoutDirection) const {
   auto textAttributes = TextAttributes::defaultTextAttributes();
-  textAttributes.fontSizeMultiplier = layoutContext.fontSizeMultiplier;
+  textAttributes.fontSizeMultiplier = fontSizeMultiplier;
   textAttributes.apply(getConcreteProps().textAttributes);
-  textAttributes.layoutDirection =
-      YGNodeLayoutGetDirection(&yogaNode_) == YGDirectionRTL
-      ? LayoutDirection::RightToLeft
-      : LayoutDirection::LeftToRight;
+  textAttributes.layoutDirection = layoutDirection;
   auto attributedString = AttributedString{};
   auto attachments = Attachments{};
   buildAttributedString(textAttributes, *this, attributedString, attachments);
 
-  content_ = Content{
+  auto content = Content{
       attributedString, getConcreteProps().paragraphAttributes, attachments};
 
-  return content_.value();
+  // Sealing stores the layout-wise hash of the string which is then shared by
+  // all copies of it (measurements, cache keys and the state).
+  content.attributedString.sealWithLayoutWiseHash();
+
+  return content;
+}
+
+LayoutDirection ParagraphShadowNode::getLayoutDirection() const {
+  return YGNodeLayoutGetDirection(&yogaNode_) == YGDirectionRTL
+      ? LayoutDirection::RightToLeft
+      : LayoutDirection::LeftToRight;
+}
+
+size_t ParagraphShadowNode::contentHash(Content const &content) {
+  return folly::hash::hash_combine(
+      0,
+      content.attributedString.getLayoutWiseHash(),
+      content.paragraphAttributes);
 }
 
 Content ParagraphShadowNode::getContentWithMeasuredAttachments(
@@ -63,8 +117,6 @@ Content ParagraphShadowNode::getContentWithMeasuredAttachments(
   // Having enforced minimum size for text fragments doesn't make much sense.
   localLayoutConstraints.minimumSize = Size{0, 0};
 
-  auto &fragments = content.attributedString.getFragments();
-
   for (auto const &attachment : content.attachments) {
     auto laytableShadowNode =
         traitCast<LayoutableShadowNode const *>(attachment.shadowNode);
@@ -84,8 +136,8 @@ Content ParagraphShadowNode::getContentWithMeasuredAttachments(
     auto fragmentLayoutMetrics = LayoutMetrics{};
     fragmentLayoutMetrics.pointScaleFactor = layoutContext.pointScaleFactor;
     fragmentLayoutMetrics.frame.size = size;
-    fragments[attachment.fragmentIndex].parentShadowView.layoutMetrics =
-        fragmentLayoutMetrics;
+    content.attributedString.setFragmentLayoutMetrics(
+        attachment.fragmentIndex, fragmentLayoutMetrics);
   }
 
   return content;
@@ -97,6 +149,12 @@ void ParagraphShadowNode::setTextLayoutManager(
   textLayoutManager_ = textLayoutManager;
 }
 
+void ParagraphShadowNode::setMeasurePrefetcher(
+    ParagraphMeasurePrefetcher::Shared measurePrefetcher) {
+  ensureUnsealed();
+  measurePrefetcher_ = measurePrefetcher;
+}
+
 void ParagraphShadowNode::updateStateIfNeeded(Content const &content) {
   ensureUnsealed();
 
@@ -143,6 +201,15 @@ Size ParagraphShadowNode::measureContent(
     telemetry->didMeasureText();
   }
 
+  if (measurePrefetcher_ && content.attachments.empty()) {
+    measurePrefetcher_->didMeasure(
+        getTag(),
+        {layoutConstraints,
+         layoutContext.fontSizeMultiplier,
+         getLayoutDirection(),
+         contentHash(content)});
+  }
+
   return textLayoutManager_
       ->measure(
           AttributedStringBox{attributedString},
@@ -151,6 +218,78 @@ Size ParagraphShadowNode::measureContent(
       .size;
 }
 
+void ParagraphShadowNode::prefetchLayout(
+    ShadowNode::Shared const &shadowNode) const {
+  if (!measurePrefetcher_) {
+    return;
+  }
+
+  auto prediction = measurePrefetcher_->getPrediction(getTag());
+  if (!prediction) {
+    return;
+  }
+
+  // The node is sealed, so its content can be built on another thread.
+  auto paragraphShadowNode =
+      std::static_pointer_cast<ParagraphShadowNode const>(shadowNode);
+  auto requestBuilder =
+      [paragraphShadowNode](
+          ParagraphMeasurePrefetcher::Prediction &contentPrediction)
+      -> better::optional<TextMeasureRequest> {
+    auto content = paragraphShadowNode->buildContent(
+        contentPrediction.fontSizeMultiplier,
+        contentPrediction.layoutDirection);
+    if (!content.attachments.empty() ||
+        content.attributedString.isEmpty()) {
+      // Attachments are measured by layout, and empty strings are measured
+      // with a placeholder (see `measureContent`).
+      return {};
+    }
+
+    auto hash = contentHash(content);
+    if (hash == contentPrediction.contentHash) {
+      // The measurement of the same content is already cached.
+      return {};
+    }
+
+    contentPrediction.contentHash = hash;
+    return TextMeasureRequest{content.attributedString,
+                              content.paragraphAttributes,
+                              contentPrediction.layoutConstraints};
+  };
+
+  measurePrefetcher_->prefetch(getTag(), *prediction, requestBuilder);
+}
+
+size_t ParagraphShadowNode::measureContentHash(
+    LayoutContext const &layoutContext) const {
+  auto const &content = getContent(layoutContext);
+  if (!content.attachments.empty() || content.attributedString.isEmpty()) {
+    // Measurements of attachments and of the placeholder used for empty
+    // strings are not part of the content, so they cannot be shared.
+    return 0;
+  }
+
+  return contentHash(content);
+}
+
+std::shared_ptr<YGMeasureCache::Content const>
+ParagraphShadowNode::measureContentKey(
+    LayoutContext const &layoutContext) const {
+  if (measureContentKey_) {
+    return measureContentKey_;
+  }
+
+  auto const &content = getContent(layoutContext);
+  if (!content.attachments.empty() || content.attributedString.isEmpty()) {
+    return nullptr;
+  }
+
+  measureContentKey_ = std::make_shared<ParagraphMeasureContentKey const>(
+      getComponentHandle(), content);
+  return measureContentKey_;
+}
+
 void ParagraphShadowNode::layout(LayoutContext layoutContext) {
   ensureUnsealed();
 
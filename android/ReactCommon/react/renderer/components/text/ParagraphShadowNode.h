@@ -9,6 +9,7 @@
 
 #include <folly/Optional.h>
 #include <react/renderer/components/text/ParagraphEventEmitter.h>
+#include <react/renderer/components/text/ParagraphMeasurePrefetcher.h>
 #include <react/renderer/components/text/ParagraphProps.h>
 #include <react/renderer/components/text/ParagraphState.h>
 #include <react/renderer/components/text/TextShadowNode.h>
@@ -58,12 +59,22 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
    */
   void setTextLayoutManager(SharedTextLayoutManager textLayoutManager);
 
+  /*
+   * Associates a shared `ParagraphMeasurePrefetcher` with the node.
+   */
+  void setMeasurePrefetcher(
+      ParagraphMeasurePrefetcher::Shared measurePrefetcher);
+
 #pragma mark - LayoutableShadowNode
 
   void layout(LayoutContext layoutContext) override;
   Size measureContent(
       LayoutContext const &layoutContext,
       LayoutConstraints const &layoutConstraints) const override;
+  size_t measureContentHash(
+      LayoutContext const &layoutContext) const override;
+  std::shared_ptr<YGMeasureCache::Content const> measureContentKey(
+      LayoutContext const &layoutContext) const override;
 
   /*
    * Internal representation of the nested content of the node in a format
@@ -76,12 +87,39 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
     Attachments attachments;
   };
 
+ protected:
+  /*
+   * Starts building and measuring the content of the node in the background
+   * with the layout constraints of the previous measurement of its family,
+   * so layout will (likely) find the measurement in the cache. Does nothing
+   * if prefetching is disabled or the family wasn't measured before.
+   */
+  void prefetchLayout(ShadowNode::Shared const &shadowNode) const override;
+
  private:
   /*
    * Builds (if needed) and returns a reference to a `Content` object.
    */
   Content const &getContent(LayoutContext const &layoutContext) const;
 
+  /*
+   * Builds and returns a `Content` object without caching it.
+   */
+  Content buildContent(
+      Float fontSizeMultiplier,
+      LayoutDirection layoutDirection) const;
+
+  /*
+   * Returns the layout direction Yoga resolved for the node.
+   */
+  LayoutDirection getLayoutDirection() const;
+
+  /*
+   * Returns a hash of everything measurements of `content` depend on (besides
+   * the layout constraints).
+   */
+  static size_t contentHash(Content const &content);
+
   /*
    * Builds and returns a `Content` object with given `layoutConstraints`.
    */
@@ -97,10 +135,18 @@ class ParagraphShadowNode : public ConcreteViewShadowNode<
 
   SharedTextLayoutManager textLayoutManager_;
 
+  ParagraphMeasurePrefetcher::Shared measurePrefetcher_;
+
   /*
    * Cached content of the subtree started from the node.
    */
   mutable better::optional<Content> content_{};
+
+  /*
+   * Layout-wise copy of `content_` which the shared Yoga measure cache keeps
+   * and compares; built on first request.
+   */
+  mutable std::shared_ptr<YGMeasureCache::Content const> measureContentKey_{};
 };
 
 } // namespace react
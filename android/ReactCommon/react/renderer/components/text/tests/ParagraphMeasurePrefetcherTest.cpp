@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/attributedstring/AttributedStringBox.h>
+#include <react/renderer/componentregistry/ComponentDescriptorProviderRegistry.h>
+#include <react/renderer/components/text/ParagraphComponentDescriptor.h>
+#include <react/renderer/components/text/ParagraphMeasurePrefetcher.h>
+#include <react/renderer/components/text/RawTextComponentDescriptor.h>
+#include <react/renderer/components/text/TextComponentDescriptor.h>
+#include <react/renderer/components/view/ViewComponentDescriptor.h>
+#include <react/renderer/element/ComponentBuilder.h>
+#include <react/renderer/element/Element.h>
+#include <react/renderer/textlayoutmanager/TextLayoutManager.h>
+
+using namespace facebook::react;
+
+static AttributedString attributedString(std::string const &string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = string;
+  fragment.textAttributes.fontSize = 12;
+
+  auto attributedString = AttributedString{};
+  attributedString.appendFragment(fragment);
+  attributedString.sealWithLayoutWiseHash();
+  return attributedString;
+}
+
+static ParagraphMeasurePrefetcher::Prediction prediction(
+    Float width,
+    size_t contentHash) {
+  return {LayoutConstraints{{width, 0},
+                            {width, std::numeric_limits<Float>::infinity()}},
+          1,
+          LayoutDirection::LeftToRight,
+          contentHash};
+}
+
+/*
+ * Returns a request builder which measures `attributedString` as the content
+ * with a given hash.
+ */
+static ParagraphMeasurePrefetcher::RequestBuilder requestBuilder(
+    AttributedString const &attributedString,
+    size_t contentHash) {
+  return [=](ParagraphMeasurePrefetcher::Prediction &prediction)
+             -> better::optional<TextMeasureRequest> {
+    prediction.contentHash = contentHash;
+    return TextMeasureRequest{
+        attributedString, {}, prediction.layoutConstraints};
+  };
+}
+
+static std::shared_ptr<RawTextProps const> rawTextProps(
+    std::string const &text) {
+  auto props = std::make_shared<RawTextProps>();
+  props->text = text;
+  return props;
+}
+
+TEST(ParagraphMeasurePrefetcherTest, testPrefetchedMeasurementIsCached) {
+  auto textLayoutManager = std::make_shared<TextLayoutManager>(nullptr);
+  auto tasks = std::vector<std::function<void()>>{};
+  auto prefetcher = std::make_shared<ParagraphMeasurePrefetcher const>(
+      [&](std::function<void()> &&task) { tasks.push_back(std::move(task)); },
+      textLayoutManager);
+
+  // Families which weren't measured yet have no prediction.
+  EXPECT_FALSE(prefetcher->getPrediction(42).has_value());
+  prefetcher->didMeasure(42, prediction(100, 1));
+  EXPECT_EQ(prefetcher->getPrediction(42)->contentHash, 1);
+
+  auto string = attributedString("Hello, World!");
+  prefetcher->prefetch(
+      42, *prefetcher->getPrediction(42), requestBuilder(string, 2));
+  ASSERT_EQ(tasks.size(), 1);
+  tasks.front()();
+
+  auto missCount = textLayoutManager->getMeasureCacheStats().missCount;
+  textLayoutManager->measure(
+      AttributedStringBox{string}, {}, prediction(100, 2).layoutConstraints);
+  EXPECT_EQ(textLayoutManager->getMeasureCacheStats().missCount, missCount);
+
+  prefetcher->didMeasure(42, prediction(100, 2));
+
+  auto stats = prefetcher->getStats();
+  EXPECT_EQ(stats.submittedCount, 1);
+  EXPECT_EQ(stats.hitCount, 1);
+  EXPECT_EQ(stats.missCount, 0);
+}
+
+TEST(ParagraphMeasurePrefetcherTest, testMispredictionIsMiss) {
+  auto prefetcher = std::make_shared<ParagraphMeasurePrefetcher const>(
+      [](std::function<void()> &&task) { task(); },
+      std::make_shared<TextLayoutManager>(nullptr));
+
+  prefetcher->didMeasure(42, prediction(100, 1));
+  prefetcher->prefetch(
+      42, prediction(100, 1), requestBuilder(attributedString("Hello"), 2));
+  // Layout measured the node with a different width.
+  prefetcher->didMeasure(42, prediction(80, 2));
+  // Layout measured a node which wasn't prefetched.
+  prefetcher->didMeasure(43, prediction(80, 1));
+
+  auto stats = prefetcher->getStats();
+  EXPECT_EQ(stats.hitCount, 0);
+  EXPECT_EQ(stats.missCount, 1);
+  EXPECT_EQ(
+      prefetcher->getPrediction(42)->layoutConstraints.maximumSize.width, 80);
+}
+
+TEST(ParagraphMeasurePrefetcherTest, testLayoutMeasuringFirstCancelsPrefetch) {
+  auto textLayoutManager = std::make_shared<TextLayoutManager>(nullptr);
+  auto tasks = std::vector<std::function<void()>>{};
+  auto prefetcher = std::make_shared<ParagraphMeasurePrefetcher const>(
+      [&](std::function<void()> &&task) { tasks.push_back(std::move(task)); },
+      textLayoutManager);
+
+  prefetcher->didMeasure(42, prediction(100, 1));
+  auto string = attributedString("Hello, World!");
+  prefetcher->prefetch(42, prediction(100, 1), requestBuilder(string, 2));
+
+  // Layout gets to the node before the prefetch runs.
+  prefetcher->didMeasure(42, prediction(100, 2));
+  ASSERT_EQ(tasks.size(), 1);
+  tasks.front()();
+
+  auto missCount = textLayoutManager->getMeasureCacheStats().missCount;
+  textLayoutManager->measure(
+      AttributedStringBox{string}, {}, prediction(100, 2).layoutConstraints);
+  EXPECT_EQ(textLayoutManager->getMeasureCacheStats().missCount, missCount + 1);
+
+  auto stats = prefetcher->getStats();
+  EXPECT_EQ(stats.hitCount, 0);
+  EXPECT_EQ(stats.missCount, 0);
+}
+
+TEST(ParagraphMeasurePrefetcherTest, testSubmissionsAreDroppedWhenBusy) {
+  auto tasks = std::vector<std::function<void()>>{};
+  auto prefetcher = std::make_shared<ParagraphMeasurePrefetcher const>(
+      [&](std::function<void()> &&task) { tasks.push_back(std::move(task)); },
+      std::make_shared<TextLayoutManager>(nullptr),
+      2);
+
+  auto builder = requestBuilder(attributedString("Hello"), 1);
+  for (Tag tag = 1; tag <= 3; tag++) {
+    prefetcher->prefetch(tag, prediction(100, 0), builder);
+  }
+  // Prefetches submitted before the measuring task runs are measured together.
+  EXPECT_EQ(tasks.size(), 1);
+
+  // Finished measurements make room for new ones.
+  tasks.front()();
+  prefetcher->prefetch(4, prediction(100, 0), builder);
+  EXPECT_EQ(tasks.size(), 2);
+
+  auto stats = prefetcher->getStats();
+  EXPECT_EQ(stats.submittedCount, 3);
+  EXPECT_EQ(stats.droppedCount, 1);
+}
+
+TEST(ParagraphMeasurePrefetcherTest, testCommittedTreeIsPrefetched) {
+  auto tasks = std::vector<std::function<void()>>{};
+  auto contextContainer = std::make_shared<ContextContainer>();
+  contextContainer->insert(
+      "TextMeasurePrefetchExecutor",
+      BackgroundExecutor{[&](std::function<void()> &&task) {
+        tasks.push_back(std::move(task));
+      }});
+
+  ComponentDescriptorProviderRegistry componentDescriptorProviderRegistry{};
+  auto componentDescriptorRegistry =
+      componentDescriptorProviderRegistry.createComponentDescriptorRegistry(
+          ComponentDescriptorParameters{
+              EventDispatcher::Shared{}, contextContainer, nullptr});
+  componentDescriptorProviderRegistry.add(
+      concreteComponentDescriptorProvider<ViewComponentDescriptor>());
+  componentDescriptorProviderRegistry.add(
+      concreteComponentDescriptorProvider<ParagraphComponentDescriptor>());
+  componentDescriptorProviderRegistry.add(
+      concreteComponentDescriptorProvider<TextComponentDescriptor>());
+  componentDescriptorProviderRegistry.add(
+      concreteComponentDescriptorProvider<RawTextComponentDescriptor>());
+  auto builder = ComponentBuilder{componentDescriptorRegistry};
+
+  auto const &paragraphComponentDescriptor =
+      static_cast<ParagraphComponentDescriptor const &>(
+          componentDescriptorRegistry->at(ParagraphShadowNode::Handle()));
+
+  auto paragraphShadowNode = std::shared_ptr<ParagraphShadowNode>{};
+
+  // clang-format off
+  auto element =
+      Element<ViewShadowNode>()
+        .tag(1)
+        .props([] {
+          auto sharedProps = std::make_shared<ViewProps>();
+          auto &yogaStyle = sharedProps->yogaStyle;
+          yogaStyle.dimensions()[YGDimensionWidth] = YGValue{200, YGUnitPoint};
+          return sharedProps;
+        })
+        .children({
+          Element<ParagraphShadowNode>()
+            .tag(2)
+            .reference(paragraphShadowNode)
+            .children({
+              Element<RawTextShadowNode>()
+                .tag(3)
+                .props([] { return rawTextProps("Hello"); })
+            })
+        });
+  // clang-format on
+
+  auto viewShadowNode =
+      std::static_pointer_cast<ViewShadowNode>(builder.build(element));
+  viewShadowNode->layoutTree(
+      LayoutContext{}, LayoutConstraints{{0, 0}, {500, 500}});
+  viewShadowNode->sealRecursive();
+
+  /*
+   * React clones the paragraph without children and appends them afterwards,
+   * so the content of the clone is final only once the tree is committed.
+   */
+  auto newParagraphShadowNode = paragraphComponentDescriptor.cloneShadowNode(
+      *paragraphShadowNode,
+      {ShadowNodeFragment::propsPlaceholder(),
+       std::make_shared<ShadowNode::ListOfShared const>()});
+  // clang-format off
+  auto newRawTextShadowNode = builder.build(
+      Element<RawTextShadowNode>()
+        .tag(4)
+        .props([] { return rawTextProps("Hello, World!"); }));
+  // clang-format on
+  paragraphComponentDescriptor.appendChild(
+      newParagraphShadowNode, newRawTextShadowNode);
+
+  auto newViewShadowNode = viewShadowNode->clone(
+      {ShadowNodeFragment::propsPlaceholder(),
+       std::make_shared<ShadowNode::ListOfShared const>(
+           ShadowNode::ListOfShared{newParagraphShadowNode})});
+  EXPECT_TRUE(tasks.empty());
+
+  newViewShadowNode->sealRecursive();
+  static_cast<ViewShadowNode const &>(*newViewShadowNode).prefetchLayoutTree();
+  ASSERT_EQ(tasks.size(), 1);
+  tasks.front()();
+
+  auto laidOutViewShadowNode =
+      std::static_pointer_cast<ViewShadowNode>(newViewShadowNode->clone({}));
+  laidOutViewShadowNode->layoutTree(
+      LayoutContext{}, LayoutConstraints{{0, 0}, {500, 500}});
+
+  auto stats = paragraphComponentDescriptor.getMeasurePrefetchStats();
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->submittedCount, 1);
+  EXPECT_EQ(stats->hitCount, 1);
+  EXPECT_EQ(stats->missCount, 0);
+}
@@ -15,20 +15,10 @@
 namespace facebook {
 namespace react {
 
-AccessibilityProps::AccessibilityProps(
-    AccessibilityProps const &sourceProps,
+AccessibilityDescriptionProps::AccessibilityDescriptionProps(
+    AccessibilityDescriptionProps const &sourceProps,
     RawProps const &rawProps)
-    : accessible(convertRawProp(
-          rawProps,
-          "accessible",
-          sourceProps.accessible,
-          false)),
-      accessibilityTraits(convertRawProp(
-          rawProps,
-          "accessibilityRole",
-          sourceProps.accessibilityTraits,
-          AccessibilityTraits::None)),
-      accessibilityState(convertRawProp(
+    : accessibilityState(convertRawProp(
           rawProps,
           "accessibilityState",
           sourceProps.accessibilityState,
@@ -47,7 +37,22 @@ AccessibilityProps::AccessibilityProps(
           rawProps,
           "accessibilityActions",
           sourceProps.accessibilityActions,
-          {})),
+          {})) {}
+
+AccessibilityProps::AccessibilityProps(
+    AccessibilityProps const &sourceProps,
+    RawProps const &rawProps)
+    : accessible(convertRawProp(
+          rawProps,
+          "accessible",
+          sourceProps.accessible,
+          false)),
+      accessibilityTraits(convertRawProp(
+          rawProps,
+          "accessibilityRole",
+          sourceProps.accessibilityTraits,
+          AccessibilityTraits::None)),
+      accessibilityDescription(sourceProps.accessibilityDescription, rawProps),
       accessibilityViewIsModal(convertRawProp(
           rawProps,
           "accessibilityViewIsModal",
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <react/renderer/components/view/AccessibilityPrimitives.h>
+#include <react/renderer/core/LazyPropsGroup.h>
 #include <react/renderer/core/Props.h>
 #include <react/renderer/core/ReactPrimitives.h>
 #include <react/renderer/debug/DebugStringConvertible.h>
@@ -15,6 +16,23 @@
 namespace facebook {
 namespace react {
 
+/*
+ * Textual and descriptive accessibility props which are only read by the
+ * mounting layer; parsed lazily (see `LazyPropsGroup`).
+ */
+class AccessibilityDescriptionProps {
+ public:
+  AccessibilityDescriptionProps() = default;
+  AccessibilityDescriptionProps(
+      AccessibilityDescriptionProps const &sourceProps,
+      RawProps const &rawProps);
+
+  AccessibilityState accessibilityState;
+  std::string accessibilityLabel{""};
+  std::string accessibilityHint{""};
+  std::vector<std::string> accessibilityActions{};
+};
+
 class AccessibilityProps {
  public:
   AccessibilityProps() = default;
@@ -26,10 +44,7 @@ class AccessibilityProps {
 
   bool accessible{false};
   AccessibilityTraits accessibilityTraits{AccessibilityTraits::None};
-  AccessibilityState accessibilityState;
-  std::string accessibilityLabel{""};
-  std::string accessibilityHint{""};
-  std::vector<std::string> accessibilityActions{};
+  LazyPropsGroup<AccessibilityDescriptionProps> accessibilityDescription{};
   bool accessibilityViewIsModal{false};
   bool accessibilityElementsHidden{false};
   bool accessibilityIgnoresInvertColors{false};
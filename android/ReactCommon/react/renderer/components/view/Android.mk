@@ -21,7 +21,7 @@ LOCAL_CFLAGS += -fexceptions -frtti -std=c++14 -Wall
 
 LOCAL_STATIC_LIBRARIES :=
 
-LOCAL_SHARED_LIBRARIES := libyoga glog libfolly_json libglog_init libreact_render_core libreact_render_debug libreact_render_graphics
+LOCAL_SHARED_LIBRARIES := libyoga glog libfolly_json libglog_init libreact_render_core libreact_render_debug libreact_render_graphics libreact_utils
 
 include $(BUILD_SHARED_LIBRARY)
 
@@ -31,4 +31,5 @@ $(call import-module,fbgloginit)
 $(call import-module,react/renderer/core)
 $(call import-module,react/renderer/debug)
 $(call import-module,react/renderer/graphics)
+$(call import-module,react/utils)
 $(call import-module,yogajni)
@@ -12,6 +12,11 @@ namespace react {
 
 #pragma mark - Touches
 
+// Every `touchMove` is dispatched with a `TouchEvent`.
+static_assert(
+    EventPayload::isStoredInline<TouchEvent>(),
+    "`TouchEvent` payloads must be stored inline.");
+
 static jsi::Value touchPayload(jsi::Runtime &runtime, Touch const &touch) {
   auto object = jsi::Object(runtime);
   object.setProperty(runtime, "locationX", touch.offsetPoint.x);
@@ -38,9 +43,7 @@ static jsi::Value touchesPayload(
   return array;
 }
 
-static jsi::Value touchEventPayload(
-    jsi::Runtime &runtime,
-    TouchEvent const &event) {
+jsi::Value toEventPayloadValue(jsi::Runtime &runtime, TouchEvent const &event) {
   auto object = jsi::Object(runtime);
   object.setProperty(
       runtime, "touches", touchesPayload(runtime, event.touches));
@@ -52,33 +55,32 @@ static jsi::Value touchEventPayload(
 }
 
 void TouchEventEmitter::dispatchTouchEvent(
-    std::string const &type,
+    EventType const &type,
     TouchEvent const &event,
     EventPriority const &priority) const {
-  dispatchEvent(
-      type,
-      [event](jsi::Runtime &runtime) {
-        return touchEventPayload(runtime, event);
-      },
-      priority);
+  dispatchEvent(type, EventPayload(event), priority);
 }
 
+// Discrete touch events are dispatched right away, taking pending `touchMove`
+// events along (see `EventDispatcher`).
 void TouchEventEmitter::onTouchStart(TouchEvent const &event) const {
-  dispatchTouchEvent("touchStart", event, EventPriority::AsynchronousBatched);
+  static auto const type = EventType("touchStart");
+  dispatchTouchEvent(type, event, EventPriority::AsynchronousUnbatched);
 }
 
 void TouchEventEmitter::onTouchMove(TouchEvent const &event) const {
-  dispatchUniqueEvent("touchMove", [event](jsi::Runtime &runtime) {
-    return touchEventPayload(runtime, event);
-  });
+  static auto const type = EventType("touchMove");
+  dispatchUniqueEvent(type, EventPayload(event));
 }
 
 void TouchEventEmitter::onTouchEnd(TouchEvent const &event) const {
-  dispatchTouchEvent("touchEnd", event, EventPriority::AsynchronousBatched);
+  static auto const type = EventType("touchEnd");
+  dispatchTouchEvent(type, event, EventPriority::AsynchronousUnbatched);
 }
 
 void TouchEventEmitter::onTouchCancel(TouchEvent const &event) const {
-  dispatchTouchEvent("touchCancel", event, EventPriority::AsynchronousBatched);
+  static auto const type = EventType("touchCancel");
+  dispatchTouchEvent(type, event, EventPriority::AsynchronousUnbatched);
 }
 
 } // namespace react
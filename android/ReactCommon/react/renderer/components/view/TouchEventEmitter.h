@@ -20,6 +20,11 @@ class TouchEventEmitter;
 
 using SharedTouchEventEmitter = std::shared_ptr<TouchEventEmitter const>;
 
+/*
+ * Converts `TouchEvent` to the payload of a touch event (see `EventPayload`).
+ */
+jsi::Value toEventPayloadValue(jsi::Runtime &runtime, TouchEvent const &event);
+
 class TouchEventEmitter : public EventEmitter {
  public:
   using EventEmitter::EventEmitter;
@@ -31,7 +36,7 @@ class TouchEventEmitter : public EventEmitter {
 
  private:
   void dispatchTouchEvent(
-      std::string const &type,
+      EventType const &type,
       TouchEvent const &event,
       EventPriority const &priority) const;
 };
@@ -34,6 +34,40 @@ void ViewEventEmitter::onAccessibilityEscape() const {
 
 #pragma mark - Layout
 
+namespace {
+
+struct LayoutEventPayload {
+  Rect frame;
+  uint_fast8_t expectedEventCount;
+  std::shared_ptr<std::atomic_uint_fast8_t> eventCounter;
+};
+
+static_assert(
+    EventPayload::isStoredInline<LayoutEventPayload>(),
+    "`LayoutEventPayload` payloads must be stored inline.");
+
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    LayoutEventPayload const &payload) {
+  auto actualEventCount = payload.eventCounter->load();
+  if (payload.expectedEventCount != actualEventCount) {
+    // Drop stale events
+    return jsi::Value::null();
+  }
+
+  auto const &frame = payload.frame;
+  auto layout = jsi::Object(runtime);
+  layout.setProperty(runtime, "x", frame.origin.x);
+  layout.setProperty(runtime, "y", frame.origin.y);
+  layout.setProperty(runtime, "width", frame.size.width);
+  layout.setProperty(runtime, "height", frame.size.height);
+  auto object = jsi::Object(runtime);
+  object.setProperty(runtime, "layout", std::move(layout));
+  return jsi::Value(std::move(object));
+}
+
+} // namespace
+
 void ViewEventEmitter::onLayout(const LayoutMetrics &layoutMetrics) const {
   // Due to State Reconciliation, `onLayout` can be called potentially many
   // times with identical layoutMetrics. Ensure that the JS event is only
@@ -48,29 +82,14 @@ void ViewEventEmitter::onLayout(const LayoutMetrics &layoutMetrics) const {
 
   auto expectedEventCount = ++*eventCounter_;
 
-  // dispatchUniqueEvent only drops consecutive onLayout events to the same
-  // node. We want to drop *any* unprocessed onLayout events when there's a
-  // newer one.
-  dispatchEvent(
-      "layout",
-      [frame = layoutMetrics.frame,
-       expectedEventCount,
-       eventCounter = eventCounter_](jsi::Runtime &runtime) {
-        auto actualEventCount = eventCounter->load();
-        if (expectedEventCount != actualEventCount) {
-          // Drop stale events
-          return jsi::Value::null();
-        }
-
-        auto layout = jsi::Object(runtime);
-        layout.setProperty(runtime, "x", frame.origin.x);
-        layout.setProperty(runtime, "y", frame.origin.y);
-        layout.setProperty(runtime, "width", frame.size.width);
-        layout.setProperty(runtime, "height", frame.size.height);
-        auto payload = jsi::Object(runtime);
-        payload.setProperty(runtime, "layout", std::move(layout));
-        return jsi::Value(std::move(payload));
-      });
+  // dispatchUniqueEvent drops any unprocessed onLayout event to the same
+  // node when there's a newer one. The counter additionally drops events
+  // which were already flushed when a newer one was dispatched.
+  static auto const type = EventType("layout");
+  dispatchUniqueEvent(
+      type,
+      EventPayload(LayoutEventPayload{
+          layoutMetrics.frame, expectedEventCount, eventCounter_}));
 }
 
 } // namespace react
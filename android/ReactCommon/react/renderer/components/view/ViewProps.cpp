@@ -18,22 +18,10 @@
 namespace facebook {
 namespace react {
 
-ViewProps::ViewProps(ViewProps const &sourceProps, RawProps const &rawProps)
-    : YogaStylableProps(sourceProps, rawProps),
-      AccessibilityProps(sourceProps, rawProps),
-      opacity(
-          convertRawProp(rawProps, "opacity", sourceProps.opacity, (Float)1.0)),
-      foregroundColor(convertRawProp(
-          rawProps,
-          "foregroundColor",
-          sourceProps.foregroundColor,
-          {})),
-      backgroundColor(convertRawProp(
-          rawProps,
-          "backgroundColor",
-          sourceProps.backgroundColor,
-          {})),
-      borderRadii(convertRawProp(
+ViewBorderProps::ViewBorderProps(
+    ViewBorderProps const &sourceProps,
+    RawProps const &rawProps)
+    : borderRadii(convertRawProp(
           rawProps,
           "border",
           "Radius",
@@ -50,7 +38,24 @@ ViewProps::ViewProps(ViewProps const &sourceProps, RawProps const &rawProps)
           "border",
           "Style",
           sourceProps.borderStyles,
+          {})) {}
+
+ViewProps::ViewProps(ViewProps const &sourceProps, RawProps const &rawProps)
+    : YogaStylableProps(sourceProps, rawProps),
+      AccessibilityProps(sourceProps, rawProps),
+      opacity(
+          convertRawProp(rawProps, "opacity", sourceProps.opacity, (Float)1.0)),
+      foregroundColor(convertRawProp(
+          rawProps,
+          "foregroundColor",
+          sourceProps.foregroundColor,
           {})),
+      backgroundColor(convertRawProp(
+          rawProps,
+          "backgroundColor",
+          sourceProps.backgroundColor,
+          {})),
+      borders(sourceProps.borders, rawProps),
       shadowColor(
           convertRawProp(rawProps, "shadowColor", sourceProps.shadowColor, {})),
       shadowOffset(convertRawProp(
@@ -156,12 +161,16 @@ BorderMetrics ViewProps::resolveBorderMetrics(
       /* .all = */ optionalFloatFromYogaValue(yogaStyle.border()[YGEdgeAll]),
   };
 
+  auto const &borderProps = borders.get();
+
   return {
-      /* .borderColors = */ borderColors.resolve(isRTL, {}),
+      /* .borderColors = */ borderProps.borderColors.resolve(isRTL, {}),
       /* .borderWidths = */ borderWidths.resolve(isRTL, 0),
       /* .borderRadii = */
-      ensureNoOverlap(borderRadii.resolve(isRTL, 0), layoutMetrics.frame.size),
-      /* .borderStyles = */ borderStyles.resolve(isRTL, BorderStyle::Solid),
+      ensureNoOverlap(
+          borderProps.borderRadii.resolve(isRTL, 0), layoutMetrics.frame.size),
+      /* .borderStyles = */
+      borderProps.borderStyles.resolve(isRTL, BorderStyle::Solid),
   };
 }
 
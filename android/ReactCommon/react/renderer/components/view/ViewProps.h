@@ -11,6 +11,7 @@
 #include <react/renderer/components/view/YogaStylableProps.h>
 #include <react/renderer/components/view/primitives.h>
 #include <react/renderer/core/LayoutMetrics.h>
+#include <react/renderer/core/LazyPropsGroup.h>
 #include <react/renderer/core/Props.h>
 #include <react/renderer/graphics/Color.h>
 #include <react/renderer/graphics/Geometry.h>
@@ -23,6 +24,20 @@ class ViewProps;
 
 using SharedViewProps = std::shared_ptr<ViewProps const>;
 
+/*
+ * Border radii, colors and styles. Layout never reads them (border widths are
+ * part of `YGStyle`), so they are parsed lazily (see `LazyPropsGroup`).
+ */
+class ViewBorderProps {
+ public:
+  ViewBorderProps() = default;
+  ViewBorderProps(ViewBorderProps const &sourceProps, RawProps const &rawProps);
+
+  CascadedBorderRadii borderRadii{};
+  CascadedBorderColors borderColors{};
+  CascadedBorderStyles borderStyles{};
+};
+
 class ViewProps : public YogaStylableProps, public AccessibilityProps {
  public:
   ViewProps() = default;
@@ -36,9 +51,7 @@ class ViewProps : public YogaStylableProps, public AccessibilityProps {
   SharedColor backgroundColor{};
 
   // Borders
-  CascadedBorderRadii borderRadii{};
-  CascadedBorderColors borderColors{};
-  CascadedBorderStyles borderStyles{};
+  LazyPropsGroup<ViewBorderProps> borders{};
 
   // Shadow
   SharedColor shadowColor{};
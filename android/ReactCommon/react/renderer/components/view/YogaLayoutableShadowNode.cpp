@@ -6,13 +6,17 @@
  */
 
 #include "YogaLayoutableShadowNode.h"
+#include <better/small_vector.h>
+#include <folly/Hash.h>
 #include <react/renderer/components/view/ViewProps.h>
 #include <react/renderer/components/view/conversions.h>
 #include <react/renderer/core/LayoutConstraints.h>
 #include <react/renderer/core/LayoutContext.h>
 #include <react/renderer/debug/DebugStringConvertibleItem.h>
 #include <react/renderer/debug/SystraceSection.h>
+#include <yoga/YGMeasureCache.h>
 #include <yoga/Yoga.h>
+#include <yoga/event/profiler.h>
 #include <algorithm>
 #include <limits>
 #include <memory>
@@ -45,6 +49,25 @@ ShadowNodeTraits YogaLayoutableShadowNode::BaseTraits() {
   return traits;
 }
 
+#pragma mark - Layout Profiling
+
+void YogaLayoutableShadowNode::setLayoutProfilerEnabled(bool enabled) {
+  auto &profiler = facebook::yoga::LayoutProfiler::shared();
+  if (enabled) {
+    profiler.setNodeDescriber([](YGNode const &yogaNode) {
+      auto shadowNode =
+          static_cast<YogaLayoutableShadowNode const *>(yogaNode.getContext());
+      return std::string{shadowNode->getComponentName()} + " #" +
+          std::to_string(shadowNode->getTag());
+    });
+  }
+  profiler.setEnabled(enabled);
+}
+
+std::string YogaLayoutableShadowNode::getLayoutProfile() {
+  return facebook::yoga::LayoutProfiler::shared().toJSON();
+}
+
 YogaLayoutableShadowNode::YogaLayoutableShadowNode(
     ShadowNodeFragment const &fragment,
     ShadowNodeFamily::Shared const &family,
@@ -90,6 +113,12 @@ YogaLayoutableShadowNode::YogaLayoutableShadowNode(
     updateYogaChildren();
   }
 
+  if (!fragment.props && !fragment.children) {
+    isLeftAndRightSwapped_ =
+        static_cast<YogaLayoutableShadowNode const &>(sourceShadowNode)
+            .isLeftAndRightSwapped_;
+  }
+
   ensureConsistency();
 }
 
@@ -102,7 +131,7 @@ void YogaLayoutableShadowNode::dirtyLayout() {
 }
 
 bool YogaLayoutableShadowNode::getIsLayoutClean() const {
-  return !yogaNode_.isDirty();
+  return !yogaNode_.isDirty() && !yogaNode_.hasDirtyRelayoutBoundary();
 }
 
 #pragma mark - Mutating Methods
@@ -186,6 +215,8 @@ void YogaLayoutableShadowNode::appendChild(
   // Calling the base class (`ShadowNode`) mehtod.
   LayoutableShadowNode::appendChild(childNode);
 
+  isLeftAndRightSwapped_ = false;
+
   if (getTraits().check(ShadowNodeTraits::Trait::LeafYogaNode)) {
     // This node is a declared leaf.
     return;
@@ -235,6 +266,7 @@ void YogaLayoutableShadowNode::updateYogaChildren() {
 
   bool isClean = !yogaNode_.isDirty() &&
       getChildren().size() == yogaNode_.getChildren().size();
+  bool hasDirtyRelayoutBoundary = false;
 
   auto oldYogaChildren = isClean ? yogaNode_.getChildren() : YGVector{};
   yogaNode_.setChildren({});
@@ -243,13 +275,25 @@ void YogaLayoutableShadowNode::updateYogaChildren() {
     appendYogaChild(*getChildren().at(i));
     adoptYogaChild(i);
 
+    auto &newYogaChildNode =
+        traitCast<YogaLayoutableShadowNode const &>(*getChildren().at(i))
+            .yogaNode_;
+
+    // A dirty relayout boundary (e.g. a fixed-size list cell) does not make
+    // this node dirty; Yoga lays it out on its own, following the
+    // `hasDirtyRelayoutBoundary` marks from the root.
+    auto isDirtyRelayoutBoundary = newYogaChildNode.isDirty() &&
+        newYogaChildNode.getOwner() == &yogaNode_ &&
+        newYogaChildNode.isRelayoutBoundary();
+
+    hasDirtyRelayoutBoundary = hasDirtyRelayoutBoundary ||
+        isDirtyRelayoutBoundary || newYogaChildNode.hasDirtyRelayoutBoundary();
+
     if (isClean) {
       auto &oldYogaChildNode = *oldYogaChildren[i];
-      auto &newYogaChildNode =
-          traitCast<YogaLayoutableShadowNode const &>(*getChildren().at(i))
-              .yogaNode_;
 
-      isClean = isClean && !newYogaChildNode.isDirty() &&
+      isClean = isClean &&
+          (!newYogaChildNode.isDirty() || isDirtyRelayoutBoundary) &&
           (newYogaChildNode.getStyle() == oldYogaChildNode.getStyle());
     }
   }
@@ -257,6 +301,7 @@ void YogaLayoutableShadowNode::updateYogaChildren() {
   assert(getChildren().size() == yogaNode_.getChildren().size());
 
   yogaNode_.setDirty(!isClean);
+  yogaNode_.setHasDirtyRelayoutBoundary(hasDirtyRelayoutBoundary);
 }
 
 void YogaLayoutableShadowNode::updateYogaProps() {
@@ -265,11 +310,11 @@ void YogaLayoutableShadowNode::updateYogaProps() {
   auto props = static_cast<YogaStylableProps const &>(*props_);
 
   // Resetting `dirty` flag only if `yogaStyle` portion of `Props` was changed.
-  if (!yogaNode_.isDirty() && (props.yogaStyle != yogaNode_.getStyle())) {
+  // Otherwise the style stays shared with the source node.
+  if (props.yogaStyle != yogaNode_.getStyle()) {
     yogaNode_.setDirty(true);
+    yogaNode_.setStyle(props.yogaStyle);
   }
-
-  yogaNode_.setStyle(props.yogaStyle);
 }
 
 void YogaLayoutableShadowNode::setSize(Size size) const {
@@ -302,6 +347,7 @@ void YogaLayoutableShadowNode::setPadding(RectangleEdges<Float> padding) const {
     style.padding()[YGEdgeBottom] = yogaStyleValueFromFloat(padding.bottom);
     yogaNode_.setStyle(style);
     yogaNode_.setDirty(true);
+    isLeftAndRightSwapped_ = false;
   }
 }
 
@@ -331,22 +377,35 @@ void YogaLayoutableShadowNode::layoutTree(
    */
   yogaConfig_.pointScaleFactor = layoutContext.pointScaleFactor;
 
-  applyLayoutConstraints(yogaNode_.getStyle(), layoutConstraints);
+  applyLayoutConstraints(yogaNode_.getMutableStyle(), layoutConstraints);
 
   threadLocalLayoutContext = layoutContext;
 
-  if (layoutContext.swapLeftAndRightInRTL) {
-    swapLeftAndRightInTree(*this);
-  }
+  prepareLayoutTree(layoutContext);
 
   {
     SystraceSection s("YogaLayoutableShadowNode::YGNodeCalculateLayout");
 
+    // If only some relayout boundaries inside the tree are dirty, Yoga lays
+    // out just those subtrees and marks the nodes on the way to them as having
+    // a new layout, so `layout` below reaches them.
     YGNodeCalculateLayout(
         &yogaNode_, YGUndefined, YGUndefined, YGDirectionInherit);
   }
 
   if (yogaNode_.getHasNewLayout()) {
+    // Yoga leaves rounding to the pixel grid to us (see
+    // `initializeYogaConfig`); the descendants are rounded in `layout`.
+    auto yogaNode = &yogaNode_;
+    YGNodesRoundToPixelGrid(
+        &yogaNode,
+        1,
+        layoutContext.pointScaleFactor,
+        0,
+        0,
+        &layoutContext.absoluteLeft,
+        &layoutContext.absoluteTop);
+
     auto layoutMetrics = layoutMetricsFromYogaNode(yogaNode_);
     layoutMetrics.pointScaleFactor = layoutContext.pointScaleFactor;
     setLayoutMetrics(layoutMetrics);
@@ -356,6 +415,28 @@ void YogaLayoutableShadowNode::layoutTree(
   layout(layoutContext);
 }
 
+void YogaLayoutableShadowNode::prepareLayoutTree(
+    LayoutContext const &layoutContext) const {
+  if (layoutContext.swapLeftAndRightInRTL) {
+    swapLeftAndRightInTree(*this);
+  }
+}
+
+void YogaLayoutableShadowNode::prefetchLayoutTree() const {
+  for (auto const &child : getChildren()) {
+    auto const yogaLayoutableChild =
+        traitCast<YogaLayoutableShadowNode const *>(child.get());
+    // Clean subtrees are not visited by layout.
+    if (yogaLayoutableChild && !yogaLayoutableChild->getIsLayoutClean()) {
+      yogaLayoutableChild->prefetchLayout(child);
+      yogaLayoutableChild->prefetchLayoutTree();
+    }
+  }
+}
+
+void YogaLayoutableShadowNode::prefetchLayout(
+    ShadowNode::Shared const &shadowNode) const {}
+
 static EdgeInsets calculateOverflowInset(
     Rect containerFrame,
     Rect contentFrame) {
@@ -376,6 +457,32 @@ void YogaLayoutableShadowNode::layout(LayoutContext layoutContext) {
 
   auto contentFrame = Rect{};
 
+  // The children with a new layout are rounded to the pixel grid together,
+  // right before their layout metrics are read.
+  auto newLayoutChildren =
+      better::small_vector<YGNodeRef, kShadowNodeChildrenSmallVectorSize>{};
+  for (auto childYogaNode : yogaNode_.getChildren()) {
+    if (childYogaNode->getHasNewLayout()) {
+      newLayoutChildren.push_back(childYogaNode);
+    }
+  }
+
+  auto absoluteLefts = better::small_vector<
+      double,
+      kShadowNodeChildrenSmallVectorSize>(newLayoutChildren.size());
+  auto absoluteTops = better::small_vector<
+      double,
+      kShadowNodeChildrenSmallVectorSize>(newLayoutChildren.size());
+  YGNodesRoundToPixelGrid(
+      newLayoutChildren.data(),
+      static_cast<uint32_t>(newLayoutChildren.size()),
+      layoutContext.pointScaleFactor,
+      layoutContext.absoluteLeft,
+      layoutContext.absoluteTop,
+      absoluteLefts.data(),
+      absoluteTops.data());
+
+  auto newLayoutChildIndex = size_t{0};
   for (auto childYogaNode : yogaNode_.getChildren()) {
     auto &childNode =
         *static_cast<YogaLayoutableShadowNode *>(childYogaNode->getContext());
@@ -410,8 +517,13 @@ void YogaLayoutableShadowNode::layout(LayoutContext layoutContext) {
 
       childNode.setLayoutMetrics(newLayoutMetrics);
 
+      auto childLayoutContext = layoutContext;
+      childLayoutContext.absoluteLeft = absoluteLefts[newLayoutChildIndex];
+      childLayoutContext.absoluteTop = absoluteTops[newLayoutChildIndex];
+      newLayoutChildIndex++;
+
       if (newLayoutMetrics.displayType != DisplayType::None) {
-        childNode.layout(layoutContext);
+        childNode.layout(childLayoutContext);
       }
     }
 
@@ -431,6 +543,17 @@ void YogaLayoutableShadowNode::layout(LayoutContext layoutContext) {
   }
 }
 
+size_t YogaLayoutableShadowNode::measureContentHash(
+    LayoutContext const &layoutContext) const {
+  return 0;
+}
+
+std::shared_ptr<YGMeasureCache::Content const>
+YogaLayoutableShadowNode::measureContentKey(
+    LayoutContext const &layoutContext) const {
+  return nullptr;
+}
+
 #pragma mark - Yoga Connectors
 
 YGNode *YogaLayoutableShadowNode::yogaNodeCloneCallbackConnector(
@@ -453,6 +576,29 @@ YGNode *YogaLayoutableShadowNode::yogaNodeCloneCallbackConnector(
   return &static_cast<YogaLayoutableShadowNode &>(*clonedNode).yogaNode_;
 }
 
+uint64_t YogaLayoutableShadowNode::yogaNodeMeasureContentHashConnector(
+    YGNode *yogaNode) {
+  auto shadowNodeRawPtr =
+      static_cast<YogaLayoutableShadowNode *>(yogaNode->getContext());
+
+  auto hash = shadowNodeRawPtr->measureContentHash(threadLocalLayoutContext);
+  if (hash == 0) {
+    return 0;
+  }
+
+  // Different components can measure the same content differently.
+  return folly::hash::hash_combine(
+      shadowNodeRawPtr->getComponentHandle(), hash);
+}
+
+std::shared_ptr<YGMeasureCache::Content const>
+YogaLayoutableShadowNode::yogaNodeMeasureContentKeyConnector(
+    YGNode *yogaNode) {
+  auto shadowNodeRawPtr =
+      static_cast<YogaLayoutableShadowNode *>(yogaNode->getContext());
+  return shadowNodeRawPtr->measureContentKey(threadLocalLayoutContext);
+}
+
 YGSize YogaLayoutableShadowNode::yogaNodeMeasureCallbackConnector(
     YGNode *yogaNode,
     float width,
@@ -516,9 +662,23 @@ static int YogaLog(
 #endif
 
 YGConfig &YogaLayoutableShadowNode::initializeYogaConfig(YGConfig &config) {
+  // Every node has its own config, but all of them share the same cache of
+  // measurements. Entries keep the content they were measured for, so a hash
+  // collision cannot return the size of some other content.
+  static YGMeasureCache measureCache{1024};
+
   config.setCloneNodeCallback(
       YogaLayoutableShadowNode::yogaNodeCloneCallbackConnector);
+  config.measureCache = &measureCache;
+  config.measureContentHashFunc =
+      YogaLayoutableShadowNode::yogaNodeMeasureContentHashConnector;
+  config.measureContentFunc =
+      YogaLayoutableShadowNode::yogaNodeMeasureContentKeyConnector;
   config.useLegacyStretchBehaviour = true;
+  config.useRelayoutBoundaries = true;
+  // Layout metrics are rounded while they are read in `layout`, which saves a
+  // separate traversal of the whole tree.
+  config.deferPixelGridRounding = true;
 #ifdef RN_DEBUG_YOGA_LOGGER
   config.printTree = true;
   config.setLogger(&YogaLog);
@@ -530,6 +690,10 @@ YGConfig &YogaLayoutableShadowNode::initializeYogaConfig(YGConfig &config) {
 
 void YogaLayoutableShadowNode::swapLeftAndRightInTree(
     YogaLayoutableShadowNode const &shadowNode) {
+  if (shadowNode.isLeftAndRightSwapped_) {
+    return;
+  }
+
   swapLeftAndRightInYogaStyleProps(shadowNode);
   swapLeftAndRightInViewProps(shadowNode);
 
@@ -540,6 +704,8 @@ void YogaLayoutableShadowNode::swapLeftAndRightInTree(
       swapLeftAndRightInTree(*yogaLayoutableChild);
     }
   }
+
+  shadowNode.isLeftAndRightSwapped_ = true;
 }
 
 void YogaLayoutableShadowNode::swapLeftAndRightInYogaStyleProps(
@@ -582,7 +748,9 @@ void YogaLayoutableShadowNode::swapLeftAndRightInYogaStyleProps(
     yogaStyle.margin()[YGEdgeRight] = YGValueUndefined;
   }
 
-  shadowNode.yogaNode_.setStyle(yogaStyle);
+  if (yogaStyle != shadowNode.yogaNode_.getStyle()) {
+    shadowNode.yogaNode_.setStyle(yogaStyle);
+  }
 }
 
 void YogaLayoutableShadowNode::swapLeftAndRightInViewProps(
@@ -591,44 +759,46 @@ void YogaLayoutableShadowNode::swapLeftAndRightInViewProps(
   auto &props = const_cast<ViewProps &>(typedCasting);
 
   // Swap border node values, borderRadii, borderColors and borderStyles.
-  if (props.borderRadii.topLeft.hasValue()) {
-    props.borderRadii.topStart = props.borderRadii.topLeft;
-    props.borderRadii.topLeft.clear();
+  auto &borderProps = props.borders.get();
+
+  if (borderProps.borderRadii.topLeft.hasValue()) {
+    borderProps.borderRadii.topStart = borderProps.borderRadii.topLeft;
+    borderProps.borderRadii.topLeft.clear();
   }
 
-  if (props.borderRadii.bottomLeft.hasValue()) {
-    props.borderRadii.bottomStart = props.borderRadii.bottomLeft;
-    props.borderRadii.bottomLeft.clear();
+  if (borderProps.borderRadii.bottomLeft.hasValue()) {
+    borderProps.borderRadii.bottomStart = borderProps.borderRadii.bottomLeft;
+    borderProps.borderRadii.bottomLeft.clear();
   }
 
-  if (props.borderRadii.topRight.hasValue()) {
-    props.borderRadii.topEnd = props.borderRadii.topRight;
-    props.borderRadii.topRight.clear();
+  if (borderProps.borderRadii.topRight.hasValue()) {
+    borderProps.borderRadii.topEnd = borderProps.borderRadii.topRight;
+    borderProps.borderRadii.topRight.clear();
   }
 
-  if (props.borderRadii.bottomRight.hasValue()) {
-    props.borderRadii.bottomEnd = props.borderRadii.bottomRight;
-    props.borderRadii.bottomRight.clear();
+  if (borderProps.borderRadii.bottomRight.hasValue()) {
+    borderProps.borderRadii.bottomEnd = borderProps.borderRadii.bottomRight;
+    borderProps.borderRadii.bottomRight.clear();
   }
 
-  if (props.borderColors.left.hasValue()) {
-    props.borderColors.start = props.borderColors.left;
-    props.borderColors.left.clear();
+  if (borderProps.borderColors.left.hasValue()) {
+    borderProps.borderColors.start = borderProps.borderColors.left;
+    borderProps.borderColors.left.clear();
   }
 
-  if (props.borderColors.right.hasValue()) {
-    props.borderColors.end = props.borderColors.right;
-    props.borderColors.right.clear();
+  if (borderProps.borderColors.right.hasValue()) {
+    borderProps.borderColors.end = borderProps.borderColors.right;
+    borderProps.borderColors.right.clear();
   }
 
-  if (props.borderStyles.left.hasValue()) {
-    props.borderStyles.start = props.borderStyles.left;
-    props.borderStyles.left.clear();
+  if (borderProps.borderStyles.left.hasValue()) {
+    borderProps.borderStyles.start = borderProps.borderStyles.left;
+    borderProps.borderStyles.left.clear();
   }
 
-  if (props.borderStyles.right.hasValue()) {
-    props.borderStyles.end = props.borderStyles.right;
-    props.borderStyles.right.clear();
+  if (borderProps.borderStyles.right.hasValue()) {
+    borderProps.borderStyles.end = borderProps.borderStyles.right;
+    borderProps.borderStyles.right.clear();
   }
 
   YGStyle::Edges const &border = props.yogaStyle.border();
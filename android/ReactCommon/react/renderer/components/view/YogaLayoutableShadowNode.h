@@ -8,8 +8,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include <yoga/YGMeasureCache.h>
 #include <yoga/YGNode.h>
 
 #include <react/renderer/components/view/YogaStylableProps.h>
@@ -30,6 +32,21 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode {
 
   static ShadowNodeTraits BaseTraits();
 
+#pragma mark - Layout Profiling
+
+  /*
+   * Enables or disables the Yoga layout profiler (see `yoga/event/profiler.h`)
+   * at runtime. Measure callbacks in the profile are attributed to nodes by
+   * component name and tag. The profile stays empty unless Yoga is built with
+   * events, which is opt-in.
+   */
+  static void setLayoutProfilerEnabled(bool enabled);
+
+  /*
+   * Returns the profile collected so far as a JSON string.
+   */
+  static std::string getLayoutProfile();
+
 #pragma mark - Constructors
 
   YogaLayoutableShadowNode(
@@ -83,7 +100,47 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode {
 
   void layout(LayoutContext layoutContext) override;
 
+  /*
+   * Does the part of `layoutTree` which mutates the nodes of the tree in place
+   * instead of cloning them (reassigning left and right values in RTL), so it
+   * can be done before the tree is shared with other threads. Calling
+   * `layoutTree` later does not repeat it.
+   */
+  void prepareLayoutTree(LayoutContext const &layoutContext) const;
+
+  /*
+   * Lets the descendants of the node which need layout (the ones Yoga will
+   * visit) start preparing for it in the background (see `prefetchLayout`).
+   * Must be called on a sealed tree which is laid out later, so the
+   * background work reads immutable nodes.
+   */
+  void prefetchLayoutTree() const;
+
+  /*
+   * Returns a hash of everything `measureContent` depends on (besides the
+   * layout constraints), allowing Yoga to share measurements between nodes
+   * with the same content. Zero (the default) means that the measurements
+   * of the node must not be shared.
+   */
+  virtual size_t measureContentHash(LayoutContext const &layoutContext) const;
+
+  /*
+   * Returns the content `measureContentHash` is computed from. Yoga keeps it
+   * with shared measurements and compares it on lookups, so nodes whose hashes
+   * collide never share measurements. Nodes returning a non-zero hash must
+   * return a content as well; `nullptr` (the default) opts the node out.
+   */
+  virtual std::shared_ptr<YGMeasureCache::Content const> measureContentKey(
+      LayoutContext const &layoutContext) const;
+
  protected:
+  /*
+   * Called by `prefetchLayoutTree` for the nodes which need layout.
+   * `shadowNode` is the node itself, which background work can retain.
+   * The default implementation does nothing.
+   */
+  virtual void prefetchLayout(ShadowNode::Shared const &shadowNode) const;
+
   /*
    * Yoga config associated (only) with this particular node.
    */
@@ -97,6 +154,13 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode {
   mutable YGNode yogaNode_;
 
  private:
+  /*
+   * Indicates that left and right values were already reassigned (see
+   * `swapLeftAndRightInTree`) in this node and all its descendants.
+   * Clones inherit the flag unless they get new props or children.
+   */
+  mutable bool isLeftAndRightSwapped_{false};
+
   /*
    * Goes over `yogaNode_.getChildren()` and in case child's owner is
    * equal to address of `yogaNode_`, it sets child's owner address
@@ -131,6 +195,9 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode {
       YGNode *oldYogaNode,
       YGNode *parentYogaNode,
       int childIndex);
+  static uint64_t yogaNodeMeasureContentHashConnector(YGNode *yogaNode);
+  static std::shared_ptr<YGMeasureCache::Content const>
+  yogaNodeMeasureContentKeyConnector(YGNode *yogaNode);
   static YGSize yogaNodeMeasureCallbackConnector(
       YGNode *yogaNode,
       float width,
@@ -151,6 +218,8 @@ class YogaLayoutableShadowNode : public LayoutableShadowNode {
    * - border(Left|Right)Color → border(Start|End)Color
    * This is neccesarry to be backwards compatible with Paper, it swaps the
    * values as well in https://fburl.com/diffusion/kl7bjr3h
+   * Subtrees which were already processed (and not changed since then) are
+   * skipped, so only new nodes are visited.
    */
   static void swapLeftAndRightInTree(
       YogaLayoutableShadowNode const &shadowNode);
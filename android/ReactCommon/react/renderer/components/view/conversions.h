@@ -16,6 +16,7 @@
 #include <react/renderer/core/LayoutMetrics.h>
 #include <react/renderer/graphics/Geometry.h>
 #include <react/renderer/graphics/Transform.h>
+#include <react/utils/DirectMappedCache.h>
 #include <stdlib.h>
 #include <yoga/YGEnums.h>
 #include <yoga/YGNode.h>
@@ -401,7 +402,7 @@ inline Float toRadians(const RawValue &value) {
   return num; // assume suffix is "rad"
 }
 
-inline void fromRawValue(const RawValue &value, Transform &result) {
+inline Transform transformFromRawValue(const RawValue &value) {
   assert(value.hasType<std::vector<RawValue>>());
   auto transformMatrix = Transform{};
   auto configurations = static_cast<std::vector<RawValue>>(value);
@@ -473,7 +474,18 @@ inline void fromRawValue(const RawValue &value, Transform &result) {
     }
   }
 
-  result = transformMatrix;
+  return transformMatrix;
+}
+
+inline void fromRawValue(const RawValue &value, Transform &result) {
+  // Transforms are often set to the same few values over and over (e.g. by
+  // animations), so the conversion is memoized per thread using the raw
+  // payload as a key. The payload is hashed and compared in place; it's only
+  // copied into the cache on a miss.
+  static thread_local DirectMappedCache<folly::dynamic, Transform, 64> cache;
+  result = cache.get(value.getDynamic(), [&](folly::dynamic const &) {
+    return transformFromRawValue(value);
+  });
 }
 
 inline void fromRawValue(const RawValue &value, PointerEventsMode &result) {
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/componentregistry/ComponentDescriptorProviderRegistry.h>
+#include <react/renderer/components/root/RootComponentDescriptor.h>
+#include <react/renderer/components/view/ViewComponentDescriptor.h>
+#include <react/renderer/element/ComponentBuilder.h>
+#include <react/renderer/element/Element.h>
+#include <react/renderer/element/testUtils.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * In an RTL root with `swapLeftAndRightInRTL`, `paddingLeft` of A is applied
+ * as `paddingStart`, which is the right side:
+ *
+ *   ┌─A: {100,0}{100,100}─────────┐
+ *   │            ┌─AB:─────┐      │
+ *   │            │{70,0}   │      │
+ *   │            │{20,20}  │ (10) │
+ *   │            └─────────┘      │
+ *   └─────────────────────────────┘
+ */
+class LeftAndRightSwappingTest : public ::testing::Test {
+ protected:
+  ComponentBuilder builder_;
+  std::shared_ptr<RootShadowNode> rootShadowNode_;
+  std::shared_ptr<ViewShadowNode> viewShadowNodeA_;
+  std::shared_ptr<ViewShadowNode> viewShadowNodeAB_;
+
+  LeftAndRightSwappingTest() : builder_(simpleComponentBuilder()) {
+    // clang-format off
+    auto element =
+        Element<RootShadowNode>()
+          .reference(rootShadowNode_)
+          .tag(1)
+          .props([] {
+            auto sharedProps = std::make_shared<RootProps>();
+            auto &props = *sharedProps;
+            props.layoutConstraints = LayoutConstraints{
+                {0, 0}, {500, 500}, LayoutDirection::RightToLeft};
+            props.layoutContext.swapLeftAndRightInRTL = true;
+            auto &yogaStyle = props.yogaStyle;
+            yogaStyle.dimensions()[YGDimensionWidth] = YGValue{200, YGUnitPoint};
+            yogaStyle.dimensions()[YGDimensionHeight] = YGValue{200, YGUnitPoint};
+            return sharedProps;
+          })
+          .children({
+            Element<ViewShadowNode>()
+              .reference(viewShadowNodeA_)
+              .tag(2)
+              .props([] {
+                auto sharedProps = std::make_shared<ViewProps>();
+                auto &props = *sharedProps;
+                auto &yogaStyle = props.yogaStyle;
+                yogaStyle.flexDirection() = YGFlexDirectionRow;
+                yogaStyle.padding()[YGEdgeLeft] = YGValue{10, YGUnitPoint};
+                yogaStyle.dimensions()[YGDimensionWidth] = YGValue{100, YGUnitPoint};
+                yogaStyle.dimensions()[YGDimensionHeight] = YGValue{100, YGUnitPoint};
+                return sharedProps;
+              })
+              .children({
+                Element<ViewShadowNode>()
+                  .reference(viewShadowNodeAB_)
+                  .tag(3)
+                  .props([] {
+                    auto sharedProps = std::make_shared<ViewProps>();
+                    auto &props = *sharedProps;
+                    auto &yogaStyle = props.yogaStyle;
+                    yogaStyle.dimensions()[YGDimensionWidth] = YGValue{20, YGUnitPoint};
+                    yogaStyle.dimensions()[YGDimensionHeight] = YGValue{20, YGUnitPoint};
+                    return sharedProps;
+                  })
+              })
+          });
+    // clang-format on
+
+    builder_.build(element);
+
+    EXPECT_TRUE(rootShadowNode_->layoutIfNeeded());
+  }
+
+  /*
+   * Returns a view with `paddingLeft` of `padding`.
+   */
+  std::shared_ptr<ViewShadowNode> buildViewWithPaddingLeft(
+      Tag tag,
+      Float padding) const {
+    // clang-format off
+    auto element =
+        Element<ViewShadowNode>()
+          .tag(tag)
+          .props([=] {
+            auto sharedProps = std::make_shared<ViewProps>();
+            auto &yogaStyle = sharedProps->yogaStyle;
+            yogaStyle.padding()[YGEdgeLeft] = YGValue{padding, YGUnitPoint};
+            yogaStyle.dimensions()[YGDimensionWidth] = YGValue{50, YGUnitPoint};
+            yogaStyle.dimensions()[YGDimensionHeight] = YGValue{50, YGUnitPoint};
+            return sharedProps;
+          });
+    // clang-format on
+    return builder_.build(element);
+  }
+
+  static LayoutMetrics layoutMetricsOfChild(
+      ShadowNode const &shadowNode,
+      size_t index) {
+    return static_cast<LayoutableShadowNode const &>(
+               *shadowNode.getChildren().at(index))
+        .getLayoutMetrics();
+  }
+};
+
+TEST_F(LeftAndRightSwappingTest, paddingLeftIsAppliedAsPaddingStart) {
+  auto layoutMetrics = viewShadowNodeA_->getLayoutMetrics();
+  EXPECT_EQ(layoutMetrics.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetrics.contentInsets.right, 10);
+
+  EXPECT_EQ(viewShadowNodeAB_->getLayoutMetrics().frame.origin.x, 70);
+}
+
+TEST_F(LeftAndRightSwappingTest, cloningWithoutNewPropsSwapsOnlyOnce) {
+  /*
+   * The clone of AB inherits that it was processed already, its new ancestors
+   * are processed again. Either way the padding of A stays at the start.
+   */
+  auto newRootShadowNode = rootShadowNode_->cloneTree(
+      viewShadowNodeAB_->getFamily(), [](ShadowNode const &oldShadowNode) {
+        return oldShadowNode.clone({});
+      });
+
+  EXPECT_TRUE(
+      static_cast<RootShadowNode &>(*newRootShadowNode).layoutIfNeeded());
+
+  auto layoutMetricsA = layoutMetricsOfChild(*newRootShadowNode, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.right, 10);
+
+  auto layoutMetricsAB =
+      layoutMetricsOfChild(*newRootShadowNode->getChildren().at(0), 0);
+  EXPECT_EQ(layoutMetricsAB.frame.origin.x, 70);
+
+  /*
+   * Laying out a clone of the clone does not swap anything back.
+   */
+  auto newerRootShadowNode = newRootShadowNode->cloneTree(
+      viewShadowNodeAB_->getFamily(), [](ShadowNode const &oldShadowNode) {
+        return oldShadowNode.clone({});
+      });
+
+  EXPECT_TRUE(
+      static_cast<RootShadowNode &>(*newerRootShadowNode).layoutIfNeeded());
+
+  layoutMetricsA = layoutMetricsOfChild(*newerRootShadowNode, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.right, 10);
+}
+
+TEST_F(LeftAndRightSwappingTest, cloningWithNewPropsSwapsThem) {
+  auto newRootShadowNode = rootShadowNode_->cloneTree(
+      viewShadowNodeA_->getFamily(), [](ShadowNode const &oldShadowNode) {
+        auto viewProps = std::make_shared<ViewProps>();
+        auto &yogaStyle = viewProps->yogaStyle;
+        yogaStyle.flexDirection() = YGFlexDirectionRow;
+        yogaStyle.padding()[YGEdgeLeft] = YGValue{15, YGUnitPoint};
+        yogaStyle.dimensions()[YGDimensionWidth] = YGValue{100, YGUnitPoint};
+        yogaStyle.dimensions()[YGDimensionHeight] = YGValue{100, YGUnitPoint};
+        return oldShadowNode.clone(ShadowNodeFragment{viewProps});
+      });
+
+  EXPECT_TRUE(
+      static_cast<RootShadowNode &>(*newRootShadowNode).layoutIfNeeded());
+
+  auto layoutMetricsA = layoutMetricsOfChild(*newRootShadowNode, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.right, 15);
+
+  auto layoutMetricsAB =
+      layoutMetricsOfChild(*newRootShadowNode->getChildren().at(0), 0);
+  EXPECT_EQ(layoutMetricsAB.frame.origin.x, 65);
+}
+
+TEST_F(LeftAndRightSwappingTest, appendedChildIsSwapped) {
+  /*
+   * The clone of A inherits that its subtree was processed; appending a child
+   * must reset that, otherwise the new child would be skipped.
+   */
+  auto newChild = buildViewWithPaddingLeft(4, 5);
+
+  auto newRootShadowNode = rootShadowNode_->cloneTree(
+      viewShadowNodeA_->getFamily(),
+      [&](ShadowNode const &oldShadowNode) {
+        auto shadowNode = oldShadowNode.clone({});
+        static_cast<YogaLayoutableShadowNode &>(*shadowNode)
+            .appendChild(newChild);
+        return shadowNode;
+      });
+
+  EXPECT_TRUE(
+      static_cast<RootShadowNode &>(*newRootShadowNode).layoutIfNeeded());
+
+  auto layoutMetrics =
+      layoutMetricsOfChild(*newRootShadowNode->getChildren().at(0), 1);
+  EXPECT_EQ(layoutMetrics.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetrics.contentInsets.right, 5);
+}
+
+TEST_F(LeftAndRightSwappingTest, settingPaddingSwapsIt) {
+  /*
+   * `setPadding` sets left and right padding after the node was processed;
+   * it must be processed again.
+   */
+  auto newRootShadowNode = rootShadowNode_->cloneTree(
+      viewShadowNodeA_->getFamily(), [](ShadowNode const &oldShadowNode) {
+        auto shadowNode = oldShadowNode.clone({});
+        static_cast<YogaLayoutableShadowNode &>(*shadowNode)
+            .setPadding(RectangleEdges<Float>{12, 0, 0, 0});
+        return shadowNode;
+      });
+
+  EXPECT_TRUE(
+      static_cast<RootShadowNode &>(*newRootShadowNode).layoutIfNeeded());
+
+  auto layoutMetricsA = layoutMetricsOfChild(*newRootShadowNode, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.left, 0);
+  EXPECT_EQ(layoutMetricsA.contentInsets.right, 12);
+
+  auto layoutMetricsAB =
+      layoutMetricsOfChild(*newRootShadowNode->getChildren().at(0), 0);
+  EXPECT_EQ(layoutMetricsAB.frame.origin.x, 68);
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <folly/dynamic.h>
+#include <react/renderer/components/view/ViewProps.h>
+#include <react/renderer/components/view/conversions.h>
+#include <react/renderer/core/RawProps.h>
+#include <react/renderer/core/RawPropsParser.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Converts a `transform` prop value with the memoized conversion
+ * (`fromRawValue`) and with the plain one (`transformFromRawValue`).
+ */
+static std::pair<Transform, Transform> convertTransform(
+    folly::dynamic const &transform) {
+  auto rawProps = RawProps(folly::dynamic::object("transform", transform));
+  auto parser = RawPropsParser();
+  parser.prepare<ViewProps>();
+  rawProps.parse(parser);
+
+  auto value = rawProps.at("transform", nullptr, nullptr);
+  EXPECT_NE(value, nullptr);
+
+  auto memoized = Transform{};
+  fromRawValue(*value, memoized);
+  return {memoized, transformFromRawValue(*value)};
+}
+
+static void expectIdenticalTransforms(
+    Transform const &lhs,
+    Transform const &rhs) {
+  EXPECT_EQ(lhs.matrix, rhs.matrix);
+  ASSERT_EQ(lhs.operations.size(), rhs.operations.size());
+  for (size_t i = 0; i < lhs.operations.size(); i++) {
+    EXPECT_EQ(lhs.operations[i].type, rhs.operations[i].type);
+    EXPECT_EQ(lhs.operations[i].x, rhs.operations[i].x);
+    EXPECT_EQ(lhs.operations[i].y, rhs.operations[i].y);
+    EXPECT_EQ(lhs.operations[i].z, rhs.operations[i].z);
+  }
+}
+
+static folly::dynamic translateX(double value) {
+  return folly::dynamic::array(folly::dynamic::object("translateX", value));
+}
+
+TEST(TransformConversionTest, testMemoizedConversionIsIdentical) {
+  auto transform = folly::dynamic::array(
+      folly::dynamic::object("perspective", 1000),
+      folly::dynamic::object("rotateX", "45deg"),
+      folly::dynamic::object("rotate", "0.5rad"),
+      folly::dynamic::object("scale", 2),
+      folly::dynamic::object("translate", folly::dynamic::array(10, 20)),
+      folly::dynamic::object("skewY", "10deg"),
+      folly::dynamic::object(
+          "matrix",
+          folly::dynamic::array(
+              1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 6, 7, 1)));
+
+  // The first conversion misses the cache, the second one hits it.
+  for (int i = 0; i < 2; i++) {
+    auto transforms = convertTransform(transform);
+    expectIdenticalTransforms(transforms.first, transforms.second);
+  }
+}
+
+TEST(TransformConversionTest, testMemoizedConversionIsIdenticalAfterMiss) {
+  auto transforms = convertTransform(translateX(1));
+  expectIdenticalTransforms(transforms.first, transforms.second);
+
+  /*
+   * Converting many other transforms evicts the first one, so it's converted
+   * again; a stale entry would yield one of the other transforms.
+   */
+  for (int i = 2; i < 1000; i++) {
+    auto otherTransforms = convertTransform(translateX(i));
+    expectIdenticalTransforms(otherTransforms.first, otherTransforms.second);
+  }
+
+  auto convertedAgain = convertTransform(translateX(1));
+  expectIdenticalTransforms(convertedAgain.first, convertedAgain.second);
+  expectIdenticalTransforms(convertedAgain.first, transforms.first);
+}
+
+} // namespace react
+} // namespace facebook
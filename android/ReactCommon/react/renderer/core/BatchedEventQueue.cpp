@@ -7,31 +7,28 @@
 
 #include "BatchedEventQueue.h"
 #include <algorithm>
+#include <chrono>
 
 namespace facebook {
 namespace react {
 
+// Continuous events are flushed once per frame (at 60 Hz).
+static auto const kLatencyBudget = std::chrono::milliseconds(16);
+
 void BatchedEventQueue::onEnqueue() const {
   EventQueue::onEnqueue();
 
   eventBeat_->request();
-}
 
-void BatchedEventQueue::enqueueUniqueEvent(const RawEvent &rawEvent) const {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    if (!eventQueue_.empty()) {
-      auto const position = eventQueue_.back();
-      if (position.type == rawEvent.type &&
-          position.eventTarget == rawEvent.eventTarget) {
-        eventQueue_.pop_back();
-      }
-    }
-
-    eventQueue_.push_back(rawEvent);
+  // The beat is expected to come every frame; if it's late (e.g. the run loop
+  // is busy), the events are flushed as soon as possible instead.
+  if (isPastDeadline(kLatencyBudget, telemetryTimePointNow())) {
+    eventBeat_->induce();
   }
+}
 
-  onEnqueue();
+void BatchedEventQueue::enqueueUniqueEvent(const RawEvent &rawEvent) const {
+  enqueueEvent(rawEvent, true);
 }
 
 } // namespace react
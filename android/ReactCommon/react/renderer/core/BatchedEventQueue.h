@@ -14,7 +14,8 @@ namespace react {
 
 /*
  * Event Queue that dispatches event in batches synchronizing them with
- * an Event Beat.
+ * an Event Beat (once per frame). Events which have been waiting for the beat
+ * for longer than a frame are flushed as soon as possible.
  */
 class BatchedEventQueue final : public EventQueue {
  public:
@@ -24,7 +25,8 @@ class BatchedEventQueue final : public EventQueue {
 
   /*
    * Enqueues and (probably later) dispatch a given event.
-   * Deletes last RawEvent from the queu if it has the same type and target.
+   * The event replaces a pending event enqueued this way if it has the same
+   * type and target (see `EventQueue::enqueueEvent`).
    * Can be called on any thread.
    */
   void enqueueUniqueEvent(const RawEvent &rawEvent) const;
@@ -37,7 +37,20 @@ EventDispatcher::EventDispatcher(
       asynchronousBatchedQueue_(std::make_unique<BatchedEventQueue>(
           eventPipe,
           statePipe,
-          asynchonousEventBeatFactory(ownerBox))) {}
+          asynchonousEventBeatFactory(ownerBox))) {
+  // Discrete (unbatched) events are dispatched right away; pending continuous
+  // (batched) events are dispatched along with them to keep the order.
+  // Conversely, a batched flush picks up unbatched events which haven't been
+  // dispatched yet.
+  synchronousUnbatchedQueue_->setCoflushedQueue(
+      synchronousBatchedQueue_.get());
+  synchronousBatchedQueue_->setCoflushedQueue(
+      synchronousUnbatchedQueue_.get());
+  asynchronousUnbatchedQueue_->setCoflushedQueue(
+      asynchronousBatchedQueue_.get());
+  asynchronousBatchedQueue_->setCoflushedQueue(
+      asynchronousUnbatchedQueue_.get());
+}
 
 void EventDispatcher::dispatchEvent(
     RawEvent const &rawEvent,
@@ -55,6 +68,18 @@ void EventDispatcher::dispatchUniqueEvent(RawEvent const &rawEvent) const {
   asynchronousBatchedQueue_->enqueueUniqueEvent(rawEvent);
 }
 
+size_t EventDispatcher::getCoalescedEventCount() const {
+  return synchronousUnbatchedQueue_->getCoalescedEventCount() +
+      synchronousBatchedQueue_->getCoalescedEventCount() +
+      asynchronousUnbatchedQueue_->getCoalescedEventCount() +
+      asynchronousBatchedQueue_->getCoalescedEventCount();
+}
+
+EventLatencyStats EventDispatcher::getEventLatencyStats(
+    EventPriority priority) const {
+  return getEventQueue(priority).getEventLatencyStats();
+}
+
 const EventQueue &EventDispatcher::getEventQueue(EventPriority priority) const {
   switch (priority) {
     case EventPriority::SynchronousUnbatched:
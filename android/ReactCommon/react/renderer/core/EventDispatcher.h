@@ -45,9 +45,10 @@ class EventDispatcher {
   void dispatchEvent(RawEvent const &rawEvent, EventPriority priority) const;
 
   /*
-   * Dispatches a raw event with asynchronous batched priority. Before the
-   * dispatch we make sure that no other RawEvent of same type and same target
-   * is on the queue.
+   * Dispatches a raw event with asynchronous batched priority. The event
+   * replaces a pending event of the same type and target dispatched this way
+   * (keeping its position relative to other events), so only the latest one
+   * is delivered. Intended for continuous events (e.g. scroll, touch move).
    */
   void dispatchUniqueEvent(RawEvent const &rawEvent) const;
 
@@ -57,6 +58,18 @@ class EventDispatcher {
   void dispatchStateUpdate(StateUpdate &&stateUpdate, EventPriority priority)
       const;
 
+  /*
+   * Returns the number of events which were replaced by newer ones and never
+   * delivered (see `dispatchUniqueEvent`).
+   */
+  size_t getCoalescedEventCount() const;
+
+  /*
+   * Returns the latency of the events dispatched with given priority, from
+   * being dispatched to being passed to the JavaScript handler.
+   */
+  EventLatencyStats getEventLatencyStats(EventPriority priority) const;
+
  private:
   EventQueue const &getEventQueue(EventPriority priority) const;
 
@@ -8,7 +8,6 @@
 #include "EventEmitter.h"
 
 #include <folly/dynamic.h>
-#include <jsi/JSIDynamic.h>
 #include <jsi/jsi.h>
 #include <react/renderer/debug/SystraceSection.h>
 
@@ -17,20 +16,6 @@
 namespace facebook {
 namespace react {
 
-// TODO(T29874519): Get rid of "top" prefix once and for all.
-/*
- * Capitalizes the first letter of the event type and adds "top" prefix if
- * necessary (e.g. "layout" becames "topLayout").
- */
-static std::string normalizeEventType(const std::string &type) {
-  auto prefixedType = type;
-  if (type.find("top", 0) != 0) {
-    prefixedType.insert(0, "top");
-    prefixedType[3] = toupper(prefixedType[3]);
-  }
-  return prefixedType;
-}
-
 std::mutex &EventEmitter::DispatchMutex() {
   static std::mutex mutex;
   return mutex;
@@ -50,21 +35,23 @@ EventEmitter::EventEmitter(
       eventDispatcher_(std::move(eventDispatcher)) {}
 
 void EventEmitter::dispatchEvent(
-    const std::string &type,
-    const folly::dynamic &payload,
+    const EventType &type,
+    folly::dynamic payload,
     const EventPriority &priority) const {
-  dispatchEvent(
-      type,
-      [payload](jsi::Runtime &runtime) {
-        return valueFromDynamic(runtime, payload);
-      },
-      priority);
+  dispatchEvent(type, EventPayload(std::move(payload)), priority);
 }
 
 void EventEmitter::dispatchEvent(
-    const std::string &type,
+    const EventType &type,
     const ValueFactory &payloadFactory,
     const EventPriority &priority) const {
+  dispatchEvent(type, EventPayload(payloadFactory), priority);
+}
+
+void EventEmitter::dispatchEvent(
+    const EventType &type,
+    EventPayload payload,
+    const EventPriority &priority) const {
   SystraceSection s("EventEmitter::dispatchEvent");
 
   auto eventDispatcher = eventDispatcher_.lock();
@@ -73,13 +60,18 @@ void EventEmitter::dispatchEvent(
   }
 
   eventDispatcher->dispatchEvent(
-      RawEvent(normalizeEventType(type), payloadFactory, eventTarget_),
-      priority);
+      RawEvent(type, std::move(payload), eventTarget_), priority);
 }
 
 void EventEmitter::dispatchUniqueEvent(
-    const std::string &type,
+    const EventType &type,
     const ValueFactory &payloadFactory) const {
+  dispatchUniqueEvent(type, EventPayload(payloadFactory));
+}
+
+void EventEmitter::dispatchUniqueEvent(
+    const EventType &type,
+    EventPayload payload) const {
   SystraceSection s("EventEmitter::dispatchUniqueEvent");
 
   auto eventDispatcher = eventDispatcher_.lock();
@@ -88,7 +80,7 @@ void EventEmitter::dispatchUniqueEvent(
   }
 
   eventDispatcher->dispatchUniqueEvent(
-      RawEvent(normalizeEventType(type), payloadFactory, eventTarget_));
+      RawEvent(type, std::move(payload), eventTarget_));
 }
 
 void EventEmitter::setEnabled(bool enabled) const {
@@ -12,8 +12,10 @@
 
 #include <folly/dynamic.h>
 #include <react/renderer/core/EventDispatcher.h>
+#include <react/renderer/core/EventPayload.h>
 #include <react/renderer/core/EventPriority.h>
 #include <react/renderer/core/EventTarget.h>
+#include <react/renderer/core/EventType.h>
 #include <react/renderer/core/ReactPrimitives.h>
 
 namespace facebook {
@@ -68,21 +70,38 @@ class EventEmitter {
    * Is used by particular subclasses only.
    */
   void dispatchEvent(
-      const std::string &type,
+      const EventType &type,
       const ValueFactory &payloadFactory =
           EventEmitter::defaultPayloadFactory(),
       const EventPriority &priority = EventPriority::AsynchronousBatched) const;
 
   void dispatchEvent(
-      const std::string &type,
-      const folly::dynamic &payload,
+      const EventType &type,
+      folly::dynamic payload,
       const EventPriority &priority = EventPriority::AsynchronousBatched) const;
 
+  /*
+   * Same as above, but with a typed payload (see `EventPayload`), which is
+   * preferable for frequent events.
+   */
+  void dispatchEvent(
+      const EventType &type,
+      EventPayload payload,
+      const EventPriority &priority = EventPriority::AsynchronousBatched) const;
+
+  /*
+   * Initiates an event delivery process for a continuous event (asynchronous
+   * batched). A pending event of the same type for the same target is
+   * replaced with this one, so only the latest state is delivered.
+   * Is used by particular subclasses only.
+   */
   void dispatchUniqueEvent(
-      const std::string &type,
+      const EventType &type,
       const ValueFactory &payloadFactory =
           EventEmitter::defaultPayloadFactory()) const;
 
+  void dispatchUniqueEvent(const EventType &type, EventPayload payload) const;
+
  private:
   void toggleEventTargetOwnership_() const;
 
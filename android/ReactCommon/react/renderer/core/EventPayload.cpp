@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "EventPayload.h"
+
+#include <jsi/JSIDynamic.h>
+
+namespace facebook {
+namespace react {
+
+constexpr size_t EventPayload::kInlineSize;
+
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    folly::dynamic const &payload) {
+  return jsi::valueFromDynamic(runtime, payload);
+}
+
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    ValueFactory const &payloadFactory) {
+  return payloadFactory(runtime);
+}
+
+jsi::Value EventPayload::toValue(jsi::Runtime &runtime) const {
+  if (!operations_) {
+    return jsi::Object(runtime);
+  }
+  return operations_->toValue(runtime, &storage_);
+}
+
+} // namespace react
+} // namespace facebook
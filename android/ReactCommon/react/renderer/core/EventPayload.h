@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <folly/dynamic.h>
+#include <jsi/jsi.h>
+#include <react/renderer/core/ValueFactory.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Conversions of the generic payloads (see `EventPayload`).
+ */
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    folly::dynamic const &payload);
+jsi::Value toEventPayloadValue(
+    jsi::Runtime &runtime,
+    ValueFactory const &payloadFactory);
+
+/*
+ * Payload of an event which is converted to a JavaScript value on the
+ * JavaScript thread.
+ * A payload is either empty (and converted to an empty object) or holds
+ * a value of some payload type: a typed struct of a particular event (e.g.
+ * `TouchEvent`), `folly::dynamic` or `ValueFactory`. The value is converted
+ * straight to a JavaScript value with the `toEventPayloadValue(jsi::Runtime &,
+ * PayloadT const &)` function found via argument-dependent lookup.
+ * Values up to `kInlineSize` bytes are stored inline, so (unlike capturing
+ * them in a `ValueFactory`) dispatching an event does not allocate a closure.
+ */
+class EventPayload final {
+ public:
+  /*
+   * Fits the payloads of the built-in events; the largest one is `TouchEvent`
+   * holding three hash sets (168 bytes with libstdc++, 120 with libc++).
+   * Each built-in payload asserts that it's stored inline (see
+   * `isStoredInline`); larger values are allocated on the heap.
+   */
+  static constexpr size_t kInlineSize = 192;
+
+  /*
+   * Returns `true` if values of `ValueT` are stored inline (without
+   * allocating).
+   */
+  template <typename ValueT>
+  static constexpr bool isStoredInline() {
+    return sizeof(ValueT) <= kInlineSize &&
+        alignof(ValueT) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible<ValueT>::value;
+  }
+
+  EventPayload() = default;
+
+  template <
+      typename PayloadT,
+      typename = typename std::enable_if<!std::is_same<
+          typename std::decay<PayloadT>::type,
+          EventPayload>::value>::type>
+  explicit EventPayload(PayloadT &&payload) {
+    using ValueT = typename std::decay<PayloadT>::type;
+    using OperationsT = typename std::conditional<
+        isStoredInline<ValueT>(),
+        InlineOperations<ValueT>,
+        HeapOperations<ValueT>>::type;
+    OperationsT::construct(&storage_, std::forward<PayloadT>(payload));
+    operations_ = OperationsT::get();
+  }
+
+  EventPayload(EventPayload const &other) : operations_(other.operations_) {
+    if (operations_) {
+      operations_->copy(&storage_, &other.storage_);
+    }
+  }
+
+  EventPayload(EventPayload &&other) noexcept
+      : operations_(other.operations_) {
+    if (operations_) {
+      operations_->move(&storage_, &other.storage_);
+      other.operations_ = nullptr;
+    }
+  }
+
+  EventPayload &operator=(EventPayload const &other) {
+    if (this != &other) {
+      reset();
+      if (other.operations_) {
+        other.operations_->copy(&storage_, &other.storage_);
+        operations_ = other.operations_;
+      }
+    }
+    return *this;
+  }
+
+  EventPayload &operator=(EventPayload &&other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.operations_) {
+        other.operations_->move(&storage_, &other.storage_);
+        operations_ = other.operations_;
+        other.operations_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~EventPayload() {
+    reset();
+  }
+
+  /*
+   * Converts the payload to a JavaScript value.
+   * Must be called on the JavaScript thread.
+   */
+  jsi::Value toValue(jsi::Runtime &runtime) const;
+
+ private:
+  using Storage =
+      typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::
+          type;
+
+  /*
+   * Type-specific operations on the value in `storage_`.
+   */
+  struct Operations {
+    jsi::Value (*toValue)(jsi::Runtime &runtime, void const *storage);
+    void (*copy)(void *storage, void const *source);
+    // Leaves `source` destroyed.
+    void (*move)(void *storage, void *source);
+    void (*destroy)(void *storage);
+  };
+
+  template <typename ValueT>
+  struct InlineOperations {
+    template <typename PayloadT>
+    static void construct(void *storage, PayloadT &&payload) {
+      new (storage) ValueT(std::forward<PayloadT>(payload));
+    }
+
+    static jsi::Value toValue(jsi::Runtime &runtime, void const *storage) {
+      return toEventPayloadValue(
+          runtime, *static_cast<ValueT const *>(storage));
+    }
+
+    static void copy(void *storage, void const *source) {
+      new (storage) ValueT(*static_cast<ValueT const *>(source));
+    }
+
+    static void move(void *storage, void *source) noexcept {
+      new (storage) ValueT(std::move(*static_cast<ValueT *>(source)));
+      destroy(source);
+    }
+
+    static void destroy(void *storage) noexcept {
+      static_cast<ValueT *>(storage)->~ValueT();
+    }
+
+    static Operations const *get() {
+      static Operations const operations = {toValue, copy, move, destroy};
+      return &operations;
+    }
+  };
+
+  // Stores a pointer to the value.
+  template <typename ValueT>
+  struct HeapOperations {
+    template <typename PayloadT>
+    static void construct(void *storage, PayloadT &&payload) {
+      new (storage) ValueT *(new ValueT(std::forward<PayloadT>(payload)));
+    }
+
+    static jsi::Value toValue(jsi::Runtime &runtime, void const *storage) {
+      return toEventPayloadValue(
+          runtime, **static_cast<ValueT const *const *>(storage));
+    }
+
+    static void copy(void *storage, void const *source) {
+      construct(storage, **static_cast<ValueT const *const *>(source));
+    }
+
+    static void move(void *storage, void *source) noexcept {
+      new (storage) ValueT *(*static_cast<ValueT **>(source));
+    }
+
+    static void destroy(void *storage) noexcept {
+      delete *static_cast<ValueT **>(storage);
+    }
+
+    static Operations const *get() {
+      static Operations const operations = {toValue, copy, move, destroy};
+      return &operations;
+    }
+  };
+
+  void reset() noexcept {
+    if (operations_) {
+      operations_->destroy(&storage_);
+      operations_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  Operations const *operations_{nullptr};
+};
+
+static_assert(
+    EventPayload::isStoredInline<folly::dynamic>(),
+    "`folly::dynamic` payloads must be stored inline.");
+static_assert(
+    EventPayload::isStoredInline<ValueFactory>(),
+    "`ValueFactory` payloads must be stored inline.");
+
+} // namespace react
+} // namespace facebook
@@ -12,7 +12,7 @@
 
 #include <jsi/jsi.h>
 #include <react/renderer/core/EventTarget.h>
-#include <react/renderer/core/ValueFactory.h>
+#include <react/renderer/core/EventPayload.h>
 
 namespace facebook {
 namespace react {
@@ -21,7 +21,7 @@ using EventPipe = std::function<void(
     jsi::Runtime &runtime,
     const EventTarget *eventTarget,
     const std::string &type,
-    const ValueFactory &payloadFactory)>;
+    const EventPayload &payload)>;
 
 } // namespace react
 } // namespace facebook
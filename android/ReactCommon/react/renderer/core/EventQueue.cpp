@@ -7,12 +7,18 @@
 
 #include "EventQueue.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
 #include "EventEmitter.h"
 #include "ShadowNodeFamily.h"
 
 namespace facebook {
 namespace react {
 
+static std::atomic<uint64_t> nextEventSequenceNumber{0};
+
 EventQueue::EventQueue(
     EventPipe eventPipe,
     StatePipe statePipe,
@@ -25,29 +31,83 @@ EventQueue::EventQueue(
 }
 
 void EventQueue::enqueueEvent(const RawEvent &rawEvent) const {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    eventQueue_.push_back(rawEvent);
-  }
+  enqueueEvent(rawEvent, false);
+}
+
+void EventQueue::enqueueEvent(const RawEvent &rawEvent, bool isCoalescable)
+    const {
+  auto enqueueTime = telemetryTimePointNow();
+  eventQueue_.push({rawEvent,
+                    isCoalescable,
+                    nextEventSequenceNumber++,
+                    enqueueTime,
+                    this});
+
+  auto expected = kTelemetryUndefinedTimePoint;
+  firstPendingEventTime_.compare_exchange_strong(expected, enqueueTime);
 
   onEnqueue();
 }
 
 void EventQueue::enqueueStateUpdate(const StateUpdate &stateUpdate) const {
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    if (!stateUpdateQueue_.empty()) {
-      auto const position = stateUpdateQueue_.back();
-      if (stateUpdate.family == position.family) {
-        stateUpdateQueue_.pop_back();
-      }
-    }
-    stateUpdateQueue_.push_back(stateUpdate);
-  }
+  stateUpdateQueue_.push(stateUpdate);
 
   onEnqueue();
 }
 
+void EventQueue::setCoflushedQueue(EventQueue const *queue) {
+  coflushedQueue_ = queue;
+}
+
+size_t EventQueue::getCoalescedEventCount() const {
+  return coalescedEventCount_.load(std::memory_order_relaxed);
+}
+
+EventLatencyStats EventQueue::getEventLatencyStats() const {
+  auto stats = EventLatencyStats{};
+  stats.eventCount = dispatchedEventCount_.load(std::memory_order_relaxed);
+  stats.totalLatency =
+      TelemetryDuration{totalLatency_.load(std::memory_order_relaxed)};
+  stats.maximumLatency =
+      TelemetryDuration{maximumLatency_.load(std::memory_order_relaxed)};
+  return stats;
+}
+
+bool EventQueue::isPastDeadline(
+    TelemetryDuration latencyBudget,
+    TelemetryTimePoint now) const {
+  auto firstPendingEventTime = firstPendingEventTime_.load();
+  if (firstPendingEventTime == kTelemetryUndefinedTimePoint) {
+    return false;
+  }
+
+  if (now - firstPendingEventTime <= latencyBudget) {
+    return false;
+  }
+
+  // Restarts the clock, so only one of the concurrent callers gets `true`.
+  return firstPendingEventTime_.compare_exchange_strong(
+      firstPendingEventTime, now);
+}
+
+std::vector<EventQueue::QueuedEvent> EventQueue::popQueuedEvents() const {
+  firstPendingEventTime_ = kTelemetryUndefinedTimePoint;
+  return eventQueue_.popAll();
+}
+
+void EventQueue::recordLatency(TelemetryDuration latency) const {
+  auto count = latency.count();
+  dispatchedEventCount_.store(
+      dispatchedEventCount_.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  totalLatency_.store(
+      totalLatency_.load(std::memory_order_relaxed) + count,
+      std::memory_order_relaxed);
+  if (count > maximumLatency_.load(std::memory_order_relaxed)) {
+    maximumLatency_.store(count, std::memory_order_relaxed);
+  }
+}
+
 void EventQueue::onEnqueue() const {
   // Default implementation does nothing.
 }
@@ -57,58 +117,123 @@ void EventQueue::onBeat(jsi::Runtime &runtime) const {
   flushStateUpdates();
 }
 
-void EventQueue::flushEvents(jsi::Runtime &runtime) const {
-  std::vector<RawEvent> queue;
-
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-
-    if (eventQueue_.size() == 0) {
-      return;
+std::vector<EventQueue::QueuedEvent> EventQueue::popEventsToFlush() const {
+  auto queuedEvents = popQueuedEvents();
+  if (coflushedQueue_) {
+    auto coflushedEvents = coflushedQueue_->popQueuedEvents();
+    if (!coflushedEvents.empty()) {
+      std::move(
+          coflushedEvents.begin(),
+          coflushedEvents.end(),
+          std::back_inserter(queuedEvents));
+      std::stable_sort(
+          queuedEvents.begin(),
+          queuedEvents.end(),
+          [](QueuedEvent const &lhs, QueuedEvent const &rhs) {
+            return lhs.sequenceNumber < rhs.sequenceNumber;
+          });
     }
+  }
+  return queuedEvents;
+}
+
+void EventQueue::flushEvents(jsi::Runtime &runtime) const {
+  auto queuedEvents = popEventsToFlush();
+  if (queuedEvents.empty()) {
+    return;
+  }
 
-    queue = std::move(eventQueue_);
-    eventQueue_.clear();
+  auto coalescedEventCount = size_t{0};
+  auto queue = coalesceEvents(std::move(queuedEvents), coalescedEventCount);
+  if (coalescedEventCount > 0) {
+    coalescedEventCount_.fetch_add(
+        coalescedEventCount, std::memory_order_relaxed);
   }
 
   {
     std::lock_guard<std::mutex> lock(EventEmitter::DispatchMutex());
 
-    for (const auto &event : queue) {
-      if (event.eventTarget) {
-        event.eventTarget->retain(runtime);
+    for (const auto &queuedEvent : queue) {
+      if (queuedEvent.rawEvent.eventTarget) {
+        queuedEvent.rawEvent.eventTarget->retain(runtime);
       }
     }
   }
 
-  for (const auto &event : queue) {
+  for (const auto &queuedEvent : queue) {
+    auto const &event = queuedEvent.rawEvent;
+    if (queuedEvent.queue) {
+      queuedEvent.queue->recordLatency(
+          telemetryTimePointNow() - queuedEvent.enqueueTime);
+    }
     eventPipe_(
-        runtime, event.eventTarget.get(), event.type, event.payloadFactory);
+        runtime, event.eventTarget.get(), event.type.getName(), event.payload);
   }
 
   // No need to lock `EventEmitter::DispatchMutex()` here.
   // The mutex protects from a situation when the `instanceHandle` can be
   // deallocated during accessing, but that's impossible at this point because
   // we have a strong pointer to it.
-  for (const auto &event : queue) {
-    if (event.eventTarget) {
-      event.eventTarget->release(runtime);
+  for (const auto &queuedEvent : queue) {
+    if (queuedEvent.rawEvent.eventTarget) {
+      queuedEvent.rawEvent.eventTarget->release(runtime);
     }
   }
 }
 
-void EventQueue::flushStateUpdates() const {
-  std::vector<StateUpdate> stateUpdateQueue;
-
-  {
-    std::lock_guard<std::mutex> lock(queueMutex_);
+std::vector<EventQueue::QueuedEvent> EventQueue::coalesceEvents(
+    std::vector<QueuedEvent> queuedEvents,
+    size_t &coalescedEventCount) {
+  std::vector<QueuedEvent> queue;
+  queue.reserve(queuedEvents.size());
+
+  // Maps the target and the type of coalescable events to their positions in
+  // `queue`.
+  auto positions = std::unordered_map<
+      EventTarget const *,
+      std::unordered_map<EventType, size_t>>{};
+
+  for (auto &queuedEvent : queuedEvents) {
+    auto target = queuedEvent.rawEvent.eventTarget.get();
+
+    if (!queuedEvent.isCoalescable) {
+      // Coalescable events of the target which were enqueued before this one
+      // must not be moved past it (e.g. a `touchMove` past a `touchEnd`).
+      positions.erase(target);
+      queue.push_back(std::move(queuedEvent));
+      continue;
+    }
 
-    if (stateUpdateQueue_.empty()) {
-      return;
+    auto &positionsOfTarget = positions[target];
+    auto iterator = positionsOfTarget.find(queuedEvent.rawEvent.type);
+    if (iterator == positionsOfTarget.end()) {
+      positionsOfTarget.emplace(queuedEvent.rawEvent.type, queue.size());
+      queue.push_back(std::move(queuedEvent));
+      continue;
     }
 
-    stateUpdateQueue = std::move(stateUpdateQueue_);
-    stateUpdateQueue_.clear();
+    queue[iterator->second] = std::move(queuedEvent);
+    coalescedEventCount++;
+  }
+
+  return queue;
+}
+
+void EventQueue::flushStateUpdates() const {
+  auto queuedStateUpdates = stateUpdateQueue_.popAll();
+  if (queuedStateUpdates.empty()) {
+    return;
+  }
+
+  // A state update replaces the previous one if it's for the same family.
+  std::vector<StateUpdate> stateUpdateQueue;
+  stateUpdateQueue.reserve(queuedStateUpdates.size());
+  for (auto &stateUpdate : queuedStateUpdates) {
+    if (!stateUpdateQueue.empty() &&
+        stateUpdateQueue.back().family == stateUpdate.family) {
+      stateUpdateQueue.pop_back();
+    }
+    stateUpdateQueue.push_back(std::move(stateUpdate));
   }
 
   for (const auto &stateUpdate : stateUpdateQueue) {
@@ -7,8 +7,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <mutex>
 #include <vector>
 
 #include <jsi/jsi.h>
@@ -17,10 +18,22 @@
 #include <react/renderer/core/RawEvent.h>
 #include <react/renderer/core/StatePipe.h>
 #include <react/renderer/core/StateUpdate.h>
+#include <react/utils/MPSCQueue.h>
+#include <react/utils/Telemetry.h>
 
 namespace facebook {
 namespace react {
 
+/*
+ * Latency of events from being enqueued to being passed to the JavaScript
+ * handler (via Event Pipe).
+ */
+struct EventLatencyStats {
+  size_t eventCount{0};
+  TelemetryDuration totalLatency{0};
+  TelemetryDuration maximumLatency{0};
+};
+
 /*
  * Event Queue synchronized with given Event Beat and dispatching event
  * using given Event Pipe.
@@ -45,6 +58,30 @@ class EventQueue {
    */
   void enqueueStateUpdate(const StateUpdate &stateUpdate) const;
 
+  /*
+   * Makes events pending in `queue` to be dispatched together with the events
+   * of this queue (in the order they were enqueued) whenever this queue is
+   * flushed. This way a flush of a higher priority queue preempts the flush
+   * of a lower priority one instead of reordering events.
+   * Both queues must be flushed on the same thread. Must be called before any
+   * event is enqueued.
+   */
+  void setCoflushedQueue(EventQueue const *queue);
+
+  /*
+   * Returns the number of events which were dropped because a newer event
+   * replaced them (see `enqueueEvent`) when this queue was flushed.
+   * Can be called on any thread.
+   */
+  size_t getCoalescedEventCount() const;
+
+  /*
+   * Returns the latency of the events enqueued to this queue which were
+   * dispatched so far.
+   * Can be called on any thread.
+   */
+  EventLatencyStats getEventLatencyStats() const;
+
  protected:
   /*
    * Called on any enqueue operation.
@@ -54,16 +91,77 @@ class EventQueue {
   virtual void onEnqueue() const;
   void onBeat(jsi::Runtime &runtime) const;
 
+  /*
+   * Returns true if some events have been pending for longer than
+   * `latencyBudget` at `now`; after that, returns false until `latencyBudget`
+   * passes again.
+   */
+  bool isPastDeadline(TelemetryDuration latencyBudget, TelemetryTimePoint now)
+      const;
+
+  /*
+   * Enqueues a given event. If `isCoalescable` is true, the event replaces
+   * a pending coalescable event with the same type and target (taking its
+   * place in the queue), so only the latest one is dispatched. An event which
+   * is not coalescable keeps the earlier events of its target in place.
+   * Can be called on any thread.
+   */
+  void enqueueEvent(const RawEvent &rawEvent, bool isCoalescable) const;
+
   void flushEvents(jsi::Runtime &runtime) const;
   void flushStateUpdates() const;
 
+  struct QueuedEvent {
+    RawEvent rawEvent;
+    bool isCoalescable;
+    // Reflects the order in which events were enqueued to all queues.
+    uint64_t sequenceNumber{0};
+    TelemetryTimePoint enqueueTime{};
+    EventQueue const *queue{nullptr};
+  };
+
+  /*
+   * Pops the events pending in this queue and in the coflushed one (see
+   * `setCoflushedQueue`), merged in the order they were enqueued.
+   */
+  std::vector<QueuedEvent> popEventsToFlush() const;
+
+  /*
+   * Returns the events to dispatch, replacing coalescable events with the
+   * latest ones of the same type and target unless a non-coalescable event
+   * of that target is between them. Adds the number of dropped events to
+   * `coalescedEventCount`.
+   */
+  static std::vector<QueuedEvent> coalesceEvents(
+      std::vector<QueuedEvent> queuedEvents,
+      size_t &coalescedEventCount);
+
   const EventPipe eventPipe_;
   const StatePipe statePipe_;
   const std::unique_ptr<EventBeat> eventBeat_;
-  // Thread-safe, protected by `queueMutex_`.
-  mutable std::vector<RawEvent> eventQueue_;
-  mutable std::vector<StateUpdate> stateUpdateQueue_;
-  mutable std::mutex queueMutex_;
+
+ private:
+  std::vector<QueuedEvent> popQueuedEvents() const;
+
+  void recordLatency(TelemetryDuration latency) const;
+
+  EventQueue const *coflushedQueue_{nullptr};
+
+  // Lock-free (producers on any thread, the consumer on the JavaScript
+  // thread). Replacing events and state updates with the newer ones happens
+  // when the queues are flushed.
+  mutable MPSCQueue<QueuedEvent, 256> eventQueue_;
+  mutable MPSCQueue<StateUpdate, 64> stateUpdateQueue_;
+
+  mutable std::atomic<TelemetryTimePoint> firstPendingEventTime_{
+      kTelemetryUndefinedTimePoint};
+
+  mutable std::atomic<size_t> coalescedEventCount_{0};
+
+  // Written only by the thread flushing the queue.
+  mutable std::atomic<size_t> dispatchedEventCount_{0};
+  mutable std::atomic<TelemetryDuration::rep> totalLatency_{0};
+  mutable std::atomic<TelemetryDuration::rep> maximumLatency_{0};
 };
 
 } // namespace react
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "EventType.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace facebook {
+namespace react {
+
+// TODO(T29874519): Get rid of "top" prefix once and for all.
+/*
+ * Capitalizes the first letter of the event type and adds "top" prefix if
+ * necessary (e.g. "layout" becames "topLayout").
+ */
+static std::string normalizeEventType(const std::string &type) {
+  auto prefixedType = type;
+  if (type.find("top", 0) != 0) {
+    prefixedType.insert(0, "top");
+    prefixedType[3] = toupper(prefixedType[3]);
+  }
+  return prefixedType;
+}
+
+namespace {
+
+struct EventTypeTable {
+  std::mutex mutex;
+  // Pointers to the elements of `std::unordered_set` stay valid when the set
+  // grows.
+  std::unordered_set<std::string> normalizedNames;
+  std::unordered_map<std::string, std::string const *> names;
+};
+
+} // namespace
+
+static std::string const *internEventType(std::string const &name) {
+  // Names which the calling thread looked up before are found without
+  // locking the table.
+  thread_local auto cache =
+      std::unordered_map<std::string, std::string const *>{};
+
+  auto cachedIterator = cache.find(name);
+  if (cachedIterator != cache.end()) {
+    return cachedIterator->second;
+  }
+
+  // Never deallocated, so `EventType`s stay valid during static destruction.
+  static auto &table = *new EventTypeTable();
+
+  std::string const *normalizedName;
+  {
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto iterator = table.names.find(name);
+    if (iterator != table.names.end()) {
+      normalizedName = iterator->second;
+    } else {
+      normalizedName =
+          &*table.normalizedNames.insert(normalizeEventType(name)).first;
+      table.names.emplace(name, normalizedName);
+    }
+  }
+
+  cache.emplace(name, normalizedName);
+  return normalizedName;
+}
+
+EventType::EventType(std::string const &name) : name_(internEventType(name)) {}
+
+EventType::EventType(char const *name) {
+  // Reuses the storage of the previous names, so looking up a cached name
+  // doesn't allocate.
+  thread_local auto buffer = std::string{};
+  buffer.assign(name);
+  name_ = internEventType(buffer);
+}
+
+} // namespace react
+} // namespace facebook
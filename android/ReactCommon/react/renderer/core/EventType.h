@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Interned type of an event (e.g. "topLayout").
+ * Creating an `EventType` from a name looks it up in a global table (once per
+ * distinct name the table stores the normalized name) unless the calling
+ * thread looked it up before; copying, comparing and hashing `EventType`s is
+ * as cheap as for pointers. Frequent events should still use `static`
+ * instances.
+ * Can be used from any thread.
+ */
+class EventType final {
+ public:
+  /*
+   * Creates the type of the event with a given name, adding the "top" prefix
+   * if necessary (e.g. "layout" becomes "topLayout").
+   */
+  EventType(std::string const &name);
+  EventType(char const *name);
+
+  /*
+   * Returns the normalized name of the type.
+   */
+  std::string const &getName() const {
+    return *name_;
+  }
+
+  bool operator==(EventType const &rhs) const {
+    return name_ == rhs.name_;
+  }
+
+  bool operator!=(EventType const &rhs) const {
+    return name_ != rhs.name_;
+  }
+
+ private:
+  friend struct std::hash<EventType>;
+
+  // Points to a string in the global table which is never deallocated.
+  std::string const *name_;
+};
+
+} // namespace react
+} // namespace facebook
+
+namespace std {
+
+template <>
+struct hash<facebook::react::EventType> {
+  size_t operator()(facebook::react::EventType const &eventType) const {
+    return std::hash<std::string const *>{}(eventType.name_);
+  }
+};
+
+} // namespace std
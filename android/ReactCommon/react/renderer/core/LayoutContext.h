@@ -61,6 +61,14 @@ struct LayoutContext {
    * If React Native takes up entire screen, it will be {0, 0}.
    */
   Point viewportOffset{};
+
+  /*
+   * Position of the node being laid out relative to the root of the layout
+   * tree, before rounding to the pixel grid. Set by layout systems which
+   * round the layout while traversing the tree.
+   */
+  double absoluteLeft{0};
+  double absoluteTop{0};
 };
 
 inline bool operator==(LayoutContext const &lhs, LayoutContext const &rhs) {
@@ -69,13 +77,17 @@ inline bool operator==(LayoutContext const &lhs, LayoutContext const &rhs) {
              lhs.affectedNodes,
              lhs.swapLeftAndRightInRTL,
              lhs.fontSizeMultiplier,
-             lhs.viewportOffset) ==
+             lhs.viewportOffset,
+             lhs.absoluteLeft,
+             lhs.absoluteTop) ==
       std::tie(
              rhs.pointScaleFactor,
              rhs.affectedNodes,
              rhs.swapLeftAndRightInRTL,
              rhs.fontSizeMultiplier,
-             rhs.viewportOffset);
+             rhs.viewportOffset,
+             rhs.absoluteLeft,
+             rhs.absoluteTop);
 }
 
 inline bool operator!=(LayoutContext const &lhs, LayoutContext const &rhs) {
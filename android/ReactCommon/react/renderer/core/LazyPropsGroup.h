@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <folly/dynamic.h>
+#include <react/renderer/core/RawProps.h>
+#include <react/renderer/core/RawPropsParser.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * `LazyPropsGroup` holds a group of rarely-read props (e.g. accessibility
+ * descriptions or border styles) that are converted from `RawValue`s only on
+ * first access instead of on every clone.
+ *
+ * `GroupT` must be default-constructible, copyable and have a
+ * `GroupT(GroupT const &sourceProps, RawProps const &rawProps)` constructor
+ * that reads props the same way any `Props` constructor does.
+ *
+ * During construction, the group only copies the raw values of its own keys
+ * (merged with the not-yet-converted values of the source group, so there is
+ * never more than one level of indirection). The conversion happens on the
+ * first call to `get()`; it is thread-safe and its result is cached.
+ */
+template <typename GroupT>
+class LazyPropsGroup final {
+ public:
+  /*
+   * Creates a group with default values.
+   */
+  LazyPropsGroup() : storage_(std::make_shared<Storage>()) {
+    storage_->resolved = true;
+  }
+
+  /*
+   * Creates a group which will be resolved from `sourceGroup` and the values of
+   * the group's keys found in `rawProps`.
+   */
+  LazyPropsGroup(LazyPropsGroup const &sourceGroup, RawProps const &rawProps) {
+    auto rawValues = collectRawValues(rawProps);
+    auto const &source = sourceGroup.storage_;
+
+    if (rawValues.empty()) {
+      // Nothing changed; the storage (and the conversion, whether it already
+      // happened or not) is shared with the source group.
+      storage_ = source;
+      return;
+    }
+
+    storage_ = std::make_shared<Storage>();
+    std::lock_guard<std::mutex> lock(source->mutex);
+
+    if (source->resolved) {
+      storage_->parent = source;
+      storage_->rawValues = std::move(rawValues);
+      return;
+    }
+
+    // The source was never accessed; instead of chaining to it, we inherit its
+    // parent and merge pending values (the newer ones win).
+    storage_->parent = source->parent;
+    storage_->rawValues = source->rawValues;
+    storage_->rawValues.update(rawValues);
+  }
+
+  /*
+   * Copies share the storage; it's detached on the first mutable access.
+   */
+  LazyPropsGroup(LazyPropsGroup const &other) = default;
+  LazyPropsGroup &operator=(LazyPropsGroup const &other) = default;
+  LazyPropsGroup(LazyPropsGroup &&other) noexcept = default;
+  LazyPropsGroup &operator=(LazyPropsGroup &&other) noexcept = default;
+
+  /*
+   * Returns the converted group, converting it on first access.
+   */
+  GroupT const &get() const {
+    return storage_->resolve();
+  }
+
+  /*
+   * Returns mutable access to the converted group.
+   * Mutating props is only allowed in places where it was allowed before
+   * (e.g. on a freshly cloned and not yet shared `Props` object).
+   */
+  GroupT &get() {
+    auto &value = const_cast<GroupT &>(storage_->resolve());
+    if (storage_.use_count() > 1) {
+      // The storage is shared with some other group (or is a parent of some
+      // other unresolved group); we must not alter what it's going to observe.
+      auto storage = std::make_shared<Storage>();
+      storage->value = value;
+      storage->resolved = true;
+      storage_ = storage;
+      return storage_->value;
+    }
+    return value;
+  }
+
+  GroupT const *operator->() const {
+    return &get();
+  }
+
+  GroupT *operator->() {
+    return &get();
+  }
+
+  /*
+   * Returns `true` if the group was already converted.
+   * To be used for debugging and testing purposes.
+   */
+  bool isResolved() const {
+    return storage_->resolved;
+  }
+
+  /*
+   * Returns `true` if both groups share the same storage.
+   * To be used for debugging and testing purposes.
+   */
+  bool sharesStorageWith(LazyPropsGroup const &other) const {
+    return storage_ == other.storage_;
+  }
+
+ private:
+  struct Storage final {
+    mutable std::mutex mutex;
+    mutable std::atomic<bool> resolved{false};
+    mutable GroupT value{};
+
+    /*
+     * Pending conversion: the already resolved (or default, if `nullptr`)
+     * group and the raw values which have to be applied on top of it.
+     */
+    mutable std::shared_ptr<Storage const> parent;
+    mutable folly::dynamic rawValues = folly::dynamic::object();
+
+    GroupT const &resolve() const {
+      if (resolved.load(std::memory_order_acquire)) {
+        return value;
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (resolved.load(std::memory_order_relaxed)) {
+        return value;
+      }
+
+      // The default value is only materialized when there is no parent;
+      // a conditional expression would copy the parent's value here.
+      if (parent) {
+        apply(parent->resolve());
+      } else {
+        apply(GroupT{});
+      }
+
+      parent.reset();
+      rawValues = folly::dynamic::object();
+      resolved.store(true, std::memory_order_release);
+      return value;
+    }
+
+   private:
+    void apply(GroupT const &sourceValue) const {
+      if (rawValues.empty()) {
+        value = sourceValue;
+        return;
+      }
+
+      RawProps rawProps(rawValues);
+      rawProps.parse(parser());
+      value = GroupT(sourceValue, rawProps);
+    }
+  };
+
+  /*
+   * The parser is specialized for the group's keys only; it's prepared the
+   * same way `ConcreteComponentDescriptor` prepares parsers for `Props`.
+   */
+  static RawPropsParser const &parser() {
+    static auto const parser = []() {
+      auto parser = RawPropsParser{};
+      RawProps emptyRawProps{};
+      emptyRawProps.parse(parser);
+      GroupT({}, emptyRawProps);
+      parser.postPrepare();
+      return parser;
+    }();
+    return parser;
+  }
+
+  /*
+   * Copies the values of the group's keys from `rawProps`.
+   * Note that during preparation of the outer parser this registers the
+   * group's keys in it (all of them, in stable order).
+   */
+  static folly::dynamic collectRawValues(RawProps const &rawProps) {
+    folly::dynamic rawValues = folly::dynamic::object();
+    auto const &groupParser = parser();
+    for (int i = 0; i < groupParser.size_; i++) {
+      auto const &key = groupParser.keys_[i];
+      auto const *rawValue = rawProps.at(key.name, key.prefix, key.suffix);
+      if (rawValue == nullptr) {
+        continue;
+      }
+      rawValues[(std::string)key] = (folly::dynamic)*rawValue;
+    }
+    return rawValues;
+  }
+
+  std::shared_ptr<Storage> storage_;
+};
+
+} // namespace react
+} // namespace facebook
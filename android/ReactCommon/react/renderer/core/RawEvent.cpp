@@ -11,11 +11,11 @@ namespace facebook {
 namespace react {
 
 RawEvent::RawEvent(
-    std::string type,
-    ValueFactory payloadFactory,
+    EventType type,
+    EventPayload payload,
     SharedEventTarget eventTarget)
-    : type(std::move(type)),
-      payloadFactory(std::move(payloadFactory)),
+    : type(type),
+      payload(std::move(payload)),
       eventTarget(std::move(eventTarget)) {}
 
 } // namespace react
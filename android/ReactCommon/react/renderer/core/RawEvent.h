@@ -8,10 +8,10 @@
 #pragma once
 
 #include <memory>
-#include <string>
 
+#include <react/renderer/core/EventPayload.h>
 #include <react/renderer/core/EventTarget.h>
-#include <react/renderer/core/ValueFactory.h>
+#include <react/renderer/core/EventType.h>
 
 namespace facebook {
 namespace react {
@@ -22,12 +22,12 @@ namespace react {
 class RawEvent {
  public:
   RawEvent(
-      std::string type,
-      ValueFactory payloadFactory,
+      EventType type,
+      EventPayload payload,
       SharedEventTarget eventTarget);
 
-  std::string type;
-  ValueFactory payloadFactory;
+  EventType type;
+  EventPayload payload;
   SharedEventTarget eventTarget;
 };
 
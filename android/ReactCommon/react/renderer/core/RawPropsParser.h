@@ -19,6 +19,9 @@
 namespace facebook {
 namespace react {
 
+template <typename GroupT>
+class LazyPropsGroup;
+
 /*
  * Specialized (to a particular type of Props) parser that provides the most
  * efficient access to `RawProps` content.
@@ -49,6 +52,8 @@ class RawPropsParser final {
   friend class ComponentDescriptor;
   template <class ShadowNodeT>
   friend class ConcreteComponentDescriptor;
+  template <typename GroupT>
+  friend class LazyPropsGroup;
   friend class RawProps;
 
   /*
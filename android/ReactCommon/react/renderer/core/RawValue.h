@@ -100,6 +100,15 @@ class RawValue {
     return dynamic_;
   }
 
+  /*
+   * Returns the underlying payload without copying it.
+   * To be used for hashing and comparing values (e.g. as memoization keys);
+   * prefer explicit casts for reading.
+   */
+  folly::dynamic const &getDynamic() const noexcept {
+    return dynamic_;
+  }
+
   /*
    * Checks if the stored value has specified type.
    */
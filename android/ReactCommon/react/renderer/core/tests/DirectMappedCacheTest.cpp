@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <react/utils/DirectMappedCache.h>
+
+using namespace facebook::react;
+
+namespace {
+
+/*
+ * Hashes a key to itself, so tests control which keys share a slot.
+ */
+struct IdentityHash {
+  size_t operator()(int key) const {
+    return static_cast<size_t>(key);
+  }
+};
+
+/*
+ * Hashes every key to the same value, so keys are told apart by comparison
+ * only.
+ */
+struct ConstantHash {
+  size_t operator()(int) const {
+    return 0;
+  }
+};
+
+} // namespace
+
+TEST(DirectMappedCacheTest, testValuesAreCached) {
+  DirectMappedCache<int, int, 4, IdentityHash> cache;
+  int generatorCallCount = 0;
+  auto generator = [&](int key) {
+    generatorCallCount++;
+    return key * 10;
+  };
+
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(generatorCallCount, 1);
+
+  // Keys in different slots don't evict each other.
+  EXPECT_EQ(cache.get(2, generator), 20);
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(2, generator), 20);
+  EXPECT_EQ(generatorCallCount, 2);
+}
+
+TEST(DirectMappedCacheTest, testCollidingKeysEvictEachOther) {
+  DirectMappedCache<int, int, 4, IdentityHash> cache;
+  int generatorCallCount = 0;
+  auto generator = [&](int key) {
+    generatorCallCount++;
+    return key * 10;
+  };
+
+  /*
+   * Keys 1 and 5 map to the same slot, so each of them replaces the other.
+   */
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(5, generator), 50);
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(5, generator), 50);
+  EXPECT_EQ(generatorCallCount, 4);
+
+  EXPECT_EQ(cache.get(5, generator), 50);
+  EXPECT_EQ(generatorCallCount, 4);
+}
+
+TEST(DirectMappedCacheTest, testKeysWithTheSameHashAreToldApart) {
+  DirectMappedCache<int, int, 4, ConstantHash> cache;
+  auto generator = [](int key) { return key * 10; };
+
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(2, generator), 20);
+  EXPECT_EQ(cache.get(1, generator), 10);
+}
+
+TEST(DirectMappedCacheTest, testDefaultKeyIsNotCachedInitially) {
+  DirectMappedCache<int, int, 4, IdentityHash> cache;
+  int generatorCallCount = 0;
+
+  /*
+   * Empty slots hold default-constructed keys, which must not be mistaken for
+   * cached entries.
+   */
+  EXPECT_EQ(
+      cache.get(
+          0,
+          [&](int) {
+            generatorCallCount++;
+            return 42;
+          }),
+      42);
+  EXPECT_EQ(generatorCallCount, 1);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/core/EventPayload.h>
+#include <react/renderer/core/EventType.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+namespace {
+
+struct SmallPayload {
+  std::shared_ptr<int> marker;
+};
+
+struct LargePayload {
+  std::shared_ptr<int> marker;
+  std::array<char, EventPayload::kInlineSize> padding;
+};
+
+jsi::Value toEventPayloadValue(jsi::Runtime &, SmallPayload const &) {
+  return jsi::Value::null();
+}
+
+jsi::Value toEventPayloadValue(jsi::Runtime &, LargePayload const &) {
+  return jsi::Value::null();
+}
+
+} // namespace
+
+TEST(EventPayloadTest, testEventTypesAreInterned) {
+  auto layout = EventType("layout");
+
+  EXPECT_EQ(layout.getName(), "topLayout");
+  EXPECT_EQ(layout, EventType("layout"));
+  EXPECT_EQ(layout, EventType("topLayout"));
+  EXPECT_EQ(&layout.getName(), &EventType(std::string{"layout"}).getName());
+  EXPECT_NE(layout, EventType("scroll"));
+}
+
+TEST(EventPayloadTest, testEventTypesAreInternedAcrossThreads) {
+  auto layout = EventType("layout");
+
+  // Each thread has its own cache of looked up names.
+  auto otherLayout = std::async(std::launch::async, [] {
+                       return EventType("layout");
+                     }).get();
+  auto otherTextLayout = std::async(std::launch::async, [] {
+                           return EventType("textLayout");
+                         }).get();
+
+  EXPECT_EQ(layout, otherLayout);
+  EXPECT_EQ(otherTextLayout, EventType("textLayout"));
+  EXPECT_EQ(otherTextLayout.getName(), "topTextLayout");
+}
+
+template <typename PayloadT>
+static void testPayloadLifetime() {
+  auto marker = std::make_shared<int>(0);
+
+  {
+    auto payload = EventPayload(PayloadT{marker});
+    EXPECT_EQ(marker.use_count(), 2);
+
+    auto copy = payload;
+    EXPECT_EQ(marker.use_count(), 3);
+
+    auto moved = EventPayload(std::move(copy));
+    EXPECT_EQ(marker.use_count(), 3);
+
+    payload = std::move(moved);
+    EXPECT_EQ(marker.use_count(), 2);
+
+    payload = EventPayload{};
+    EXPECT_EQ(marker.use_count(), 1);
+
+    payload = EventPayload(PayloadT{marker});
+    EXPECT_EQ(marker.use_count(), 2);
+  }
+
+  EXPECT_EQ(marker.use_count(), 1);
+}
+
+TEST(EventPayloadTest, testInlinePayloadLifetime) {
+  testPayloadLifetime<SmallPayload>();
+}
+
+TEST(EventPayloadTest, testHeapPayloadLifetime) {
+  testPayloadLifetime<LargePayload>();
+}
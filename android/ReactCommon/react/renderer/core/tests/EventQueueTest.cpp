@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/core/EventQueue.h>
+
+using namespace facebook;
+using namespace facebook::react;
+
+class TestEventQueue : public EventQueue {
+ public:
+  using EventQueue::EventQueue;
+
+  using EventQueue::coalesceEvents;
+  using EventQueue::enqueueEvent;
+  using EventQueue::isPastDeadline;
+  using EventQueue::popEventsToFlush;
+  using EventQueue::QueuedEvent;
+};
+
+static std::unique_ptr<TestEventQueue> testEventQueue() {
+  return std::make_unique<TestEventQueue>(
+      [](jsi::Runtime &,
+         EventTarget const *,
+         std::string const &,
+         EventPayload const &) {},
+      [](StateUpdate const &) {},
+      std::make_unique<EventBeat>(nullptr));
+}
+
+// Events are told apart by the markers their payloads retain.
+static TestEventQueue::QueuedEvent queuedEvent(
+    std::string const &type,
+    std::shared_ptr<int> const &marker,
+    bool isCoalescable) {
+  return {RawEvent{type,
+                   EventPayload(ValueFactory{[marker](jsi::Runtime &) {
+                     return jsi::Value::null();
+                   }}),
+                   nullptr},
+          isCoalescable};
+}
+
+TEST(EventQueueTest, testCoalescableEventsReplaceEarlierOnes) {
+  auto firstScroll = std::make_shared<int>(0);
+  auto click = std::make_shared<int>(0);
+  auto secondScroll = std::make_shared<int>(0);
+  auto layout = std::make_shared<int>(0);
+  auto thirdScroll = std::make_shared<int>(0);
+
+  auto queuedEvents = std::vector<TestEventQueue::QueuedEvent>{};
+  queuedEvents.push_back(queuedEvent("scroll", firstScroll, true));
+  queuedEvents.push_back(queuedEvent("click", click, false));
+  queuedEvents.push_back(queuedEvent("scroll", secondScroll, true));
+  queuedEvents.push_back(queuedEvent("layout", layout, true));
+  queuedEvents.push_back(queuedEvent("scroll", thirdScroll, true));
+
+  auto coalescedEventCount = size_t{0};
+  auto events = TestEventQueue::coalesceEvents(
+      std::move(queuedEvents), coalescedEventCount);
+
+  // The click has the same target as the scroll events, so the first one is
+  // dispatched before it; the latest one takes the place of the second one.
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(events[0].rawEvent.type.getName(), "topScroll");
+  EXPECT_EQ(events[1].rawEvent.type.getName(), "topClick");
+  EXPECT_EQ(events[2].rawEvent.type.getName(), "topScroll");
+  EXPECT_EQ(events[3].rawEvent.type.getName(), "topLayout");
+  EXPECT_EQ(coalescedEventCount, 1);
+
+  EXPECT_EQ(firstScroll.use_count(), 2);
+  EXPECT_EQ(secondScroll.use_count(), 1);
+  EXPECT_EQ(thirdScroll.use_count(), 2);
+}
+
+TEST(EventQueueTest, testOtherEventsOfTargetAreBarriers) {
+  auto firstMove = std::make_shared<int>(0);
+  auto end = std::make_shared<int>(0);
+  auto start = std::make_shared<int>(0);
+  auto secondMove = std::make_shared<int>(0);
+  auto thirdMove = std::make_shared<int>(0);
+
+  auto queuedEvents = std::vector<TestEventQueue::QueuedEvent>{};
+  queuedEvents.push_back(queuedEvent("touchMove", firstMove, true));
+  queuedEvents.push_back(queuedEvent("touchEnd", end, false));
+  queuedEvents.push_back(queuedEvent("touchStart", start, false));
+  queuedEvents.push_back(queuedEvent("touchMove", secondMove, true));
+  queuedEvents.push_back(queuedEvent("touchMove", thirdMove, true));
+
+  auto coalescedEventCount = size_t{0};
+  auto events = TestEventQueue::coalesceEvents(
+      std::move(queuedEvents), coalescedEventCount);
+
+  // The move of the previous gesture is not dispatched after the new gesture
+  // started; only the moves after the start are coalesced.
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(events[0].rawEvent.type.getName(), "topTouchMove");
+  EXPECT_EQ(events[1].rawEvent.type.getName(), "topTouchEnd");
+  EXPECT_EQ(events[2].rawEvent.type.getName(), "topTouchStart");
+  EXPECT_EQ(events[3].rawEvent.type.getName(), "topTouchMove");
+  EXPECT_EQ(coalescedEventCount, 1);
+
+  EXPECT_EQ(firstMove.use_count(), 2);
+  EXPECT_EQ(secondMove.use_count(), 1);
+  EXPECT_EQ(thirdMove.use_count(), 2);
+}
+
+TEST(EventQueueTest, testOtherEventsAreNotCoalesced) {
+  auto queuedEvents = std::vector<TestEventQueue::QueuedEvent>{};
+  auto marker = std::make_shared<int>(0);
+  queuedEvents.push_back(queuedEvent("click", marker, false));
+  queuedEvents.push_back(queuedEvent("click", marker, false));
+  queuedEvents.push_back(queuedEvent("click", marker, true));
+
+  auto coalescedEventCount = size_t{0};
+  auto events = TestEventQueue::coalesceEvents(
+      std::move(queuedEvents), coalescedEventCount);
+
+  EXPECT_EQ(events.size(), 3);
+  EXPECT_EQ(coalescedEventCount, 0);
+}
+
+TEST(EventQueueTest, testDeadlineOfPendingEvents) {
+  auto queue = testEventQueue();
+
+  EXPECT_FALSE(queue->isPastDeadline(
+      std::chrono::milliseconds(0), telemetryTimePointNow()));
+
+  queue->enqueueEvent(RawEvent{"click", EventPayload{}, nullptr});
+  auto now = telemetryTimePointNow();
+  EXPECT_FALSE(queue->isPastDeadline(std::chrono::hours(1), now));
+  EXPECT_FALSE(queue->isPastDeadline(std::chrono::milliseconds(1), now));
+
+  now += std::chrono::milliseconds(2);
+  EXPECT_TRUE(queue->isPastDeadline(std::chrono::milliseconds(1), now));
+
+  // The clock restarts once the deadline is reported.
+  EXPECT_FALSE(queue->isPastDeadline(std::chrono::milliseconds(1), now));
+  now += std::chrono::milliseconds(2);
+  EXPECT_TRUE(queue->isPastDeadline(std::chrono::milliseconds(1), now));
+
+  // There is no deadline once the events are flushed.
+  queue->popEventsToFlush();
+  now += std::chrono::milliseconds(2);
+  EXPECT_FALSE(queue->isPastDeadline(std::chrono::milliseconds(1), now));
+}
+
+TEST(EventQueueTest, testCoflushedQueuesMergeInEnqueueOrder) {
+  auto unbatchedQueue = testEventQueue();
+  auto batchedQueue = testEventQueue();
+  unbatchedQueue->setCoflushedQueue(batchedQueue.get());
+  batchedQueue->setCoflushedQueue(unbatchedQueue.get());
+
+  batchedQueue->enqueueEvent(
+      RawEvent{"touchMove", EventPayload{}, nullptr}, true);
+  unbatchedQueue->enqueueEvent(
+      RawEvent{"touchEnd", EventPayload{}, nullptr}, false);
+  batchedQueue->enqueueEvent(
+      RawEvent{"scroll", EventPayload{}, nullptr}, true);
+
+  // Flushing the unbatched queue delivers the pending move first.
+  auto events = unbatchedQueue->popEventsToFlush();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].rawEvent.type.getName(), "topTouchMove");
+  EXPECT_EQ(events[1].rawEvent.type.getName(), "topTouchEnd");
+  EXPECT_EQ(events[2].rawEvent.type.getName(), "topScroll");
+
+  EXPECT_TRUE(batchedQueue->popEventsToFlush().empty());
+}
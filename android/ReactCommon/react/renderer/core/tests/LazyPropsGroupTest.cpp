@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/renderer/core/LazyPropsGroup.h>
+#include <react/renderer/core/RawPropsParser.h>
+#include <react/renderer/core/propsConversions.h>
+
+using namespace facebook::react;
+
+class LabelPropsGroup {
+ public:
+  LabelPropsGroup() = default;
+  LabelPropsGroup(LabelPropsGroup const &sourceProps, RawProps const &rawProps)
+      : label(convertRawProp(rawProps, "label", sourceProps.label, "none")),
+        size(convertRawProp(rawProps, "size", sourceProps.size, 12)) {}
+
+  std::string label{"none"};
+  int size{12};
+};
+
+class PropsWithLazyGroup : public Props {
+ public:
+  PropsWithLazyGroup() = default;
+  PropsWithLazyGroup(
+      PropsWithLazyGroup const &sourceProps,
+      RawProps const &rawProps)
+      : Props(sourceProps, rawProps),
+        opacity(convertRawProp(rawProps, "opacity", sourceProps.opacity, 1.0)),
+        labels(sourceProps.labels, rawProps) {}
+
+  double opacity{1.0};
+  LazyPropsGroup<LabelPropsGroup> labels{};
+};
+
+static std::shared_ptr<PropsWithLazyGroup const> cloneProps(
+    RawPropsParser const &parser,
+    PropsWithLazyGroup const &sourceProps,
+    folly::dynamic const &dynamic) {
+  RawProps rawProps(dynamic);
+  rawProps.parse(parser);
+  return std::make_shared<PropsWithLazyGroup const>(sourceProps, rawProps);
+}
+
+TEST(LazyPropsGroupTest, defaultValues) {
+  auto props = PropsWithLazyGroup{};
+
+  EXPECT_TRUE(props.labels.isResolved());
+  EXPECT_EQ(props.labels->label, "none");
+  EXPECT_EQ(props.labels->size, 12);
+}
+
+TEST(LazyPropsGroupTest, conversionIsDeferredUntilAccess) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = cloneProps(
+      parser,
+      PropsWithLazyGroup{},
+      folly::dynamic::object("opacity", 0.5)("label", "hello"));
+
+  EXPECT_EQ(props->opacity, 0.5);
+  EXPECT_FALSE(props->labels.isResolved());
+  EXPECT_EQ(props->labels->label, "hello");
+  EXPECT_EQ(props->labels->size, 12);
+  EXPECT_TRUE(props->labels.isResolved());
+}
+
+TEST(LazyPropsGroupTest, unrelatedPropsDoNotDeferConversion) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = cloneProps(
+      parser, PropsWithLazyGroup{}, folly::dynamic::object("size", 3));
+  EXPECT_EQ(props->labels->size, 3);
+
+  auto clonedProps =
+      cloneProps(parser, *props, folly::dynamic::object("opacity", 0.3));
+  EXPECT_TRUE(clonedProps->labels.isResolved());
+  EXPECT_EQ(clonedProps->labels->size, 3);
+}
+
+TEST(LazyPropsGroupTest, unchangedClonesShareStorage) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = cloneProps(
+      parser, PropsWithLazyGroup{}, folly::dynamic::object("label", "shared"));
+  auto clonedProps =
+      cloneProps(parser, *props, folly::dynamic::object("opacity", 0.3));
+
+  EXPECT_TRUE(clonedProps->labels.sharesStorageWith(props->labels));
+  EXPECT_FALSE(props->labels.isResolved());
+
+  // Resolving one of them resolves both.
+  EXPECT_EQ(clonedProps->labels->label, "shared");
+  EXPECT_TRUE(props->labels.isResolved());
+
+  auto changedProps =
+      cloneProps(parser, *props, folly::dynamic::object("size", 1));
+  EXPECT_FALSE(changedProps->labels.sharesStorageWith(props->labels));
+}
+
+TEST(LazyPropsGroupTest, pendingValuesAreMergedAcrossClones) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = cloneProps(
+      parser,
+      PropsWithLazyGroup{},
+      folly::dynamic::object("label", "first")("size", 20));
+  auto clonedProps =
+      cloneProps(parser, *props, folly::dynamic::object("label", "second"));
+  auto nullifiedProps = cloneProps(
+      parser, *clonedProps, folly::dynamic::object("size", nullptr));
+
+  EXPECT_EQ(clonedProps->labels->label, "second");
+  EXPECT_EQ(clonedProps->labels->size, 20);
+
+  EXPECT_EQ(nullifiedProps->labels->label, "second");
+  EXPECT_EQ(nullifiedProps->labels->size, 12);
+
+  EXPECT_EQ(props->labels->label, "first");
+  EXPECT_EQ(props->labels->size, 20);
+}
+
+TEST(LazyPropsGroupTest, mutationDoesNotLeakIntoClones) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = PropsWithLazyGroup{};
+  props.labels->label = "mutated";
+
+  auto clonedProps =
+      cloneProps(parser, props, folly::dynamic::object("size", 42));
+  props.labels->label = "mutated again";
+
+  EXPECT_EQ(clonedProps->labels->label, "mutated");
+  EXPECT_EQ(clonedProps->labels->size, 42);
+
+  auto sharingProps =
+      cloneProps(parser, props, folly::dynamic::object("opacity", 0.1));
+  EXPECT_TRUE(sharingProps->labels.sharesStorageWith(props.labels));
+
+  props.labels->label = "mutated once more";
+
+  EXPECT_FALSE(sharingProps->labels.sharesStorageWith(props.labels));
+  EXPECT_EQ(sharingProps->labels->label, "mutated again");
+}
+
+TEST(LazyPropsGroupTest, concurrentAccess) {
+  auto parser = RawPropsParser();
+  parser.prepare<PropsWithLazyGroup>();
+
+  auto props = cloneProps(
+      parser, PropsWithLazyGroup{}, folly::dynamic::object("label", "shared"));
+
+  auto threads = std::vector<std::thread>{};
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&]() { EXPECT_EQ(props->labels->label, "shared"); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/utils/MPSCQueue.h>
+
+using namespace facebook::react;
+
+TEST(MPSCQueueTest, testValuesArePoppedInOrder) {
+  MPSCQueue<int, 4> queue;
+
+  EXPECT_TRUE(queue.popAll().empty());
+
+  // Values which don't fit into the ring go to the overflow buffer.
+  for (int i = 0; i < 10; i++) {
+    queue.push(i);
+  }
+
+  auto values = queue.popAll();
+  ASSERT_EQ(values.size(), 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(values[i], i);
+  }
+
+  // The ring is used again once the overflow buffer is drained.
+  queue.push(10);
+  queue.push(11);
+  EXPECT_EQ(queue.popAll(), (std::vector<int>{10, 11}));
+  EXPECT_TRUE(queue.popAll().empty());
+}
+
+TEST(MPSCQueueTest, testValuesAreDestroyedWhenPopped) {
+  MPSCQueue<std::shared_ptr<int>, 4> queue;
+  auto value = std::make_shared<int>(42);
+
+  queue.push(value);
+  EXPECT_EQ(value.use_count(), 2);
+
+  queue.popAll();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+/*
+ * Pushes `valueCount` values from each of `producerCount` threads to `queue`
+ * while popping them, and checks that values of every producer arrive in
+ * order, without gaps.
+ */
+template <int capacity>
+static void testConcurrentProducers(
+    MPSCQueue<std::pair<int, int>, capacity> &queue,
+    int producerCount,
+    int valueCount) {
+  auto producers = std::vector<std::thread>{};
+  for (int producer = 0; producer < producerCount; producer++) {
+    producers.emplace_back([&queue, producer, valueCount] {
+      for (int i = 0; i < valueCount; i++) {
+        queue.push({producer, i});
+      }
+    });
+  }
+
+  auto nextValues = std::vector<int>(producerCount, 0);
+  auto poppedCount = 0;
+  while (poppedCount < producerCount * valueCount) {
+    for (auto const &value : queue.popAll()) {
+      // Values of every producer arrive in order, without gaps.
+      EXPECT_EQ(value.second, nextValues[value.first]);
+      nextValues[value.first] = value.second + 1;
+      poppedCount++;
+    }
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_TRUE(queue.popAll().empty());
+}
+
+TEST(MPSCQueueTest, testConcurrentProducers) {
+  // Pairs of a producer index and a sequential number.
+  MPSCQueue<std::pair<int, int>, 64> queue;
+  testConcurrentProducers(queue, 4, 20000);
+}
+
+TEST(MPSCQueueTest, testConcurrentProducersWithTinyRing) {
+  // The ring fills up all the time, so values keep moving between the ring
+  // and the overflow buffer.
+  MPSCQueue<std::pair<int, int>, 2> queue;
+  testConcurrentProducers(queue, 8, 20000);
+}
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/utils/SimpleThreadSafeCache.h>
+
+using namespace facebook::react;
+
+namespace {
+
+/*
+ * A key whose hash is the index of its shard, so tests control which keys
+ * share a shard.
+ */
+struct ShardedKey {
+  int shard;
+  int id;
+
+  bool operator==(ShardedKey const &rhs) const {
+    return shard == rhs.shard && id == rhs.id;
+  }
+};
+
+} // namespace
+
+namespace std {
+
+template <>
+struct hash<ShardedKey> {
+  size_t operator()(ShardedKey const &key) const {
+    return static_cast<size_t>(key.shard);
+  }
+};
+
+} // namespace std
+
+TEST(SimpleThreadSafeCacheTest, testValuesAreCached) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+  int generatorCallCount = 0;
+  auto generator = [&](int key) {
+    generatorCallCount++;
+    return key * 10;
+  };
+
+  EXPECT_FALSE(cache.get(1).has_value());
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(1, generator), 10);
+  EXPECT_EQ(cache.get(1).value(), 10);
+  EXPECT_EQ(generatorCallCount, 1);
+
+  cache.set(2, 42);
+  EXPECT_EQ(cache.get(2, generator), 42);
+  EXPECT_EQ(generatorCallCount, 1);
+}
+
+TEST(SimpleThreadSafeCacheTest, testConcurrentGetsCallGeneratorOnce) {
+  constexpr int threadCount = 8;
+
+  SimpleThreadSafeCache<int, int, 16> cache;
+  std::atomic<int> generatorCallCount{0};
+  std::promise<void> generatorStarted;
+  std::promise<void> generatorReleased;
+  auto generatorReleasedFuture = generatorReleased.get_future().share();
+
+  auto generator = [&](int key) {
+    generatorCallCount++;
+    generatorStarted.set_value();
+    generatorReleasedFuture.wait();
+    return key * 10;
+  };
+
+  auto firstValue = std::async(
+      std::launch::async, [&] { return cache.get(1, generator); });
+  generatorStarted.get_future().wait();
+
+  /*
+   * The value is in flight now; other callers either wait for it or (if they
+   * are late) find it in the cache, but never generate it again.
+   */
+  std::vector<std::future<int>> values;
+  for (int i = 0; i < threadCount; i++) {
+    values.push_back(std::async(
+        std::launch::async, [&] { return cache.get(1, generator); }));
+  }
+  generatorReleased.set_value();
+
+  EXPECT_EQ(firstValue.get(), 10);
+  for (auto &value : values) {
+    EXPECT_EQ(value.get(), 10);
+  }
+  EXPECT_EQ(generatorCallCount, 1);
+
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.missCount, 1);
+  EXPECT_EQ(stats.hitCount, threadCount);
+}
+
+TEST(SimpleThreadSafeCacheTest, testThrowingGeneratorIsRetried) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+
+  EXPECT_THROW(
+      cache.get(
+          1, [](int) -> int { throw std::runtime_error("Failed to generate"); }),
+      std::runtime_error);
+
+  /*
+   * A failed value is neither cached nor kept in flight.
+   */
+  EXPECT_FALSE(cache.get(1).has_value());
+  EXPECT_EQ(cache.get(1, [](int key) { return key * 10; }), 10);
+  EXPECT_EQ(cache.get(1).value(), 10);
+}
+
+TEST(SimpleThreadSafeCacheTest, testShardsEvictIndependently) {
+  /*
+   * Two shards of two values each.
+   */
+  SimpleThreadSafeCache<ShardedKey, int, 4, 2> cache;
+
+  cache.set({0, 1}, 1);
+  cache.set({1, 1}, 11);
+  cache.set({0, 2}, 2);
+
+  // Makes {0, 1} the most recently used value of the first shard.
+  EXPECT_EQ(cache.get({0, 1}).value(), 1);
+
+  // Evicts the least recently used value of the first shard only.
+  cache.set({0, 3}, 3);
+  EXPECT_FALSE(cache.get({0, 2}).has_value());
+  EXPECT_EQ(cache.get({0, 1}).value(), 1);
+  EXPECT_EQ(cache.get({0, 3}).value(), 3);
+  EXPECT_EQ(cache.get({1, 1}).value(), 11);
+
+  // Keys with the same hash are told apart.
+  cache.set({1, 2}, 12);
+  EXPECT_EQ(cache.get({1, 1}).value(), 11);
+  EXPECT_EQ(cache.get({1, 2}).value(), 12);
+}
+
+TEST(SimpleThreadSafeCacheTest, testStats) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+  auto generator = [](int key) { return key * 10; };
+
+  EXPECT_EQ(cache.getStats().hitCount, 0);
+  EXPECT_EQ(cache.getStats().missCount, 0);
+
+  cache.get(1, generator);
+  cache.get(2, generator);
+  cache.get(1, generator);
+  cache.get(1);
+  cache.get(3);
+  cache.set(3, 30);
+  cache.get(3, generator);
+
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hitCount, 3);
+  EXPECT_EQ(stats.missCount, 3);
+}
+
+TEST(SimpleThreadSafeCacheTest, testBatchGeneratesMissingValuesOnce) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+  cache.set(1, 10);
+
+  auto generatedKeys = std::vector<int>{};
+  auto generator = [&](std::vector<int const *> const &keys) {
+    auto values = std::vector<int>{};
+    for (auto key : keys) {
+      generatedKeys.push_back(*key);
+      values.push_back(*key * 10);
+    }
+    return values;
+  };
+
+  auto values = cache.getBatch({1, 2, 3, 2}, generator);
+  EXPECT_EQ(values, (std::vector<int>{10, 20, 30, 20}));
+  EXPECT_EQ(generatedKeys, (std::vector<int>{2, 3}));
+
+  // The repeated key didn't call the generator, so it counts as a hit.
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hitCount, 2);
+  EXPECT_EQ(stats.missCount, 2);
+
+  // All the values are cached now.
+  generatedKeys.clear();
+  EXPECT_EQ(
+      cache.getBatch({3, 1, 2}, generator), (std::vector<int>{30, 10, 20}));
+  EXPECT_TRUE(generatedKeys.empty());
+}
+
+TEST(SimpleThreadSafeCacheTest, testBatchKeysAreInFlight) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+  std::atomic<int> generatorCallCount{0};
+  std::promise<void> generatorStarted;
+  std::promise<void> generatorReleased;
+  auto generatorReleasedFuture = generatorReleased.get_future().share();
+
+  auto batchValues = std::async(std::launch::async, [&] {
+    return cache.getBatch({1, 2}, [&](std::vector<int const *> const &keys) {
+      generatorCallCount++;
+      generatorStarted.set_value();
+      generatorReleasedFuture.wait();
+      return std::vector<int>{*keys[0] * 10, *keys[1] * 10};
+    });
+  });
+  generatorStarted.get_future().wait();
+
+  /*
+   * Single gets and batches of keys generated by the batch above wait for it;
+   * only the new key is generated.
+   */
+  auto value = std::async(std::launch::async, [&] {
+    return cache.get(2, [&](int key) {
+      generatorCallCount++;
+      return key * 10;
+    });
+  });
+  auto otherBatchValues = std::async(std::launch::async, [&] {
+    return cache.getBatch({3, 1}, [&](std::vector<int const *> const &keys) {
+      EXPECT_EQ(keys.size(), 1);
+      EXPECT_EQ(*keys[0], 3);
+      return std::vector<int>{30};
+    });
+  });
+  generatorReleased.set_value();
+
+  EXPECT_EQ(batchValues.get(), (std::vector<int>{10, 20}));
+  EXPECT_EQ(value.get(), 20);
+  EXPECT_EQ(otherBatchValues.get(), (std::vector<int>{30, 10}));
+  EXPECT_EQ(generatorCallCount, 1);
+}
+
+TEST(SimpleThreadSafeCacheTest, testThrowingBatchGeneratorIsRetried) {
+  SimpleThreadSafeCache<int, int, 16> cache;
+
+  EXPECT_THROW(
+      cache.getBatch(
+          {1, 2},
+          [](std::vector<int const *> const &) -> std::vector<int> {
+            throw std::runtime_error("Failed to generate");
+          }),
+      std::runtime_error);
+
+  EXPECT_FALSE(cache.get(1).has_value());
+  EXPECT_EQ(cache.get(2, [](int key) { return key * 10; }), 20);
+  EXPECT_EQ(
+      cache.getBatch(
+          {1, 2},
+          [](std::vector<int const *> const &keys) {
+            return std::vector<int>(keys.size(), 10);
+          }),
+      (std::vector<int>{10, 20}));
+}
@@ -11,9 +11,81 @@
 
 #include <glog/logging.h>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RN_TRANSFORM_USE_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define RN_TRANSFORM_USE_SSE 1
+#endif
+
 namespace facebook {
 namespace react {
 
+/*
+ * Computes `result = rhs x lhs` for row-major 4x4 matrices: every row of the
+ * result is a linear combination of the rows of `lhs` with coefficients from
+ * the corresponding row of `rhs`.
+ * Generic (scalar) implementation; used for `double`-based `Float` and on
+ * architectures without SIMD support.
+ */
+template <typename T>
+static void multiplyMatrices(
+    std::array<T, 16> const &lhs,
+    std::array<T, 16> const &rhs,
+    std::array<T, 16> &result) {
+  for (auto i = 0; i < 16; i += 4) {
+    auto rhs0 = rhs[i + 0], rhs1 = rhs[i + 1], rhs2 = rhs[i + 2],
+         rhs3 = rhs[i + 3];
+    for (auto j = 0; j < 4; j++) {
+      result[i + j] = rhs0 * lhs[j] + rhs1 * lhs[4 + j] + rhs2 * lhs[8 + j] +
+          rhs3 * lhs[12 + j];
+    }
+  }
+}
+
+#if defined(RN_TRANSFORM_USE_NEON) || defined(RN_TRANSFORM_USE_SSE)
+
+/*
+ * SIMD implementation for `float` matrices: one matrix row per vector.
+ * Multiplications and additions are performed in the same order as in the
+ * scalar implementation.
+ */
+static void multiplyMatrices(
+    std::array<float, 16> const &lhs,
+    std::array<float, 16> const &rhs,
+    std::array<float, 16> &result) {
+#ifdef RN_TRANSFORM_USE_NEON
+  auto lhsRow0 = vld1q_f32(&lhs[0]);
+  auto lhsRow1 = vld1q_f32(&lhs[4]);
+  auto lhsRow2 = vld1q_f32(&lhs[8]);
+  auto lhsRow3 = vld1q_f32(&lhs[12]);
+
+  for (auto i = 0; i < 16; i += 4) {
+    auto row = vmulq_n_f32(lhsRow0, rhs[i + 0]);
+    row = vaddq_f32(row, vmulq_n_f32(lhsRow1, rhs[i + 1]));
+    row = vaddq_f32(row, vmulq_n_f32(lhsRow2, rhs[i + 2]));
+    row = vaddq_f32(row, vmulq_n_f32(lhsRow3, rhs[i + 3]));
+    vst1q_f32(&result[i], row);
+  }
+#else
+  auto lhsRow0 = _mm_loadu_ps(&lhs[0]);
+  auto lhsRow1 = _mm_loadu_ps(&lhs[4]);
+  auto lhsRow2 = _mm_loadu_ps(&lhs[8]);
+  auto lhsRow3 = _mm_loadu_ps(&lhs[12]);
+
+  for (auto i = 0; i < 16; i += 4) {
+    auto row = _mm_mul_ps(lhsRow0, _mm_set1_ps(rhs[i + 0]));
+    row = _mm_add_ps(row, _mm_mul_ps(lhsRow1, _mm_set1_ps(rhs[i + 1])));
+    row = _mm_add_ps(row, _mm_mul_ps(lhsRow2, _mm_set1_ps(rhs[i + 2])));
+    row = _mm_add_ps(row, _mm_mul_ps(lhsRow3, _mm_set1_ps(rhs[i + 3])));
+    _mm_storeu_ps(&result[i], row);
+  }
+#endif
+}
+
+#endif
+
 #ifdef RN_DEBUG_STRING_CONVERTIBLE
 void Transform::print(Transform const &t, std::string prefix) {
   LOG(ERROR) << prefix << "[ " << t.matrix[0] << " " << t.matrix[1] << " "
@@ -260,6 +332,7 @@ Transform Transform::operator*(Transform const &rhs) const {
 
   const auto &lhs = *this;
   auto result = Transform{};
+  result.operations.reserve(operations.size() + rhs.operations.size());
   for (const auto &op : this->operations) {
     if (op.type == TransformOperationType::Identity &&
         result.operations.size() > 0) {
@@ -275,46 +348,7 @@ Transform Transform::operator*(Transform const &rhs) const {
     result.operations.push_back(op);
   }
 
-  auto lhs00 = lhs.matrix[0], lhs01 = lhs.matrix[1], lhs02 = lhs.matrix[2],
-       lhs03 = lhs.matrix[3], lhs10 = lhs.matrix[4], lhs11 = lhs.matrix[5],
-       lhs12 = lhs.matrix[6], lhs13 = lhs.matrix[7], lhs20 = lhs.matrix[8],
-       lhs21 = lhs.matrix[9], lhs22 = lhs.matrix[10], lhs23 = lhs.matrix[11],
-       lhs30 = lhs.matrix[12], lhs31 = lhs.matrix[13], lhs32 = lhs.matrix[14],
-       lhs33 = lhs.matrix[15];
-
-  auto rhs0 = rhs.matrix[0], rhs1 = rhs.matrix[1], rhs2 = rhs.matrix[2],
-       rhs3 = rhs.matrix[3];
-  result.matrix[0] = rhs0 * lhs00 + rhs1 * lhs10 + rhs2 * lhs20 + rhs3 * lhs30;
-  result.matrix[1] = rhs0 * lhs01 + rhs1 * lhs11 + rhs2 * lhs21 + rhs3 * lhs31;
-  result.matrix[2] = rhs0 * lhs02 + rhs1 * lhs12 + rhs2 * lhs22 + rhs3 * lhs32;
-  result.matrix[3] = rhs0 * lhs03 + rhs1 * lhs13 + rhs2 * lhs23 + rhs3 * lhs33;
-
-  rhs0 = rhs.matrix[4];
-  rhs1 = rhs.matrix[5];
-  rhs2 = rhs.matrix[6];
-  rhs3 = rhs.matrix[7];
-  result.matrix[4] = rhs0 * lhs00 + rhs1 * lhs10 + rhs2 * lhs20 + rhs3 * lhs30;
-  result.matrix[5] = rhs0 * lhs01 + rhs1 * lhs11 + rhs2 * lhs21 + rhs3 * lhs31;
-  result.matrix[6] = rhs0 * lhs02 + rhs1 * lhs12 + rhs2 * lhs22 + rhs3 * lhs32;
-  result.matrix[7] = rhs0 * lhs03 + rhs1 * lhs13 + rhs2 * lhs23 + rhs3 * lhs33;
-
-  rhs0 = rhs.matrix[8];
-  rhs1 = rhs.matrix[9];
-  rhs2 = rhs.matrix[10];
-  rhs3 = rhs.matrix[11];
-  result.matrix[8] = rhs0 * lhs00 + rhs1 * lhs10 + rhs2 * lhs20 + rhs3 * lhs30;
-  result.matrix[9] = rhs0 * lhs01 + rhs1 * lhs11 + rhs2 * lhs21 + rhs3 * lhs31;
-  result.matrix[10] = rhs0 * lhs02 + rhs1 * lhs12 + rhs2 * lhs22 + rhs3 * lhs32;
-  result.matrix[11] = rhs0 * lhs03 + rhs1 * lhs13 + rhs2 * lhs23 + rhs3 * lhs33;
-
-  rhs0 = rhs.matrix[12];
-  rhs1 = rhs.matrix[13];
-  rhs2 = rhs.matrix[14];
-  rhs3 = rhs.matrix[15];
-  result.matrix[12] = rhs0 * lhs00 + rhs1 * lhs10 + rhs2 * lhs20 + rhs3 * lhs30;
-  result.matrix[13] = rhs0 * lhs01 + rhs1 * lhs11 + rhs2 * lhs21 + rhs3 * lhs31;
-  result.matrix[14] = rhs0 * lhs02 + rhs1 * lhs12 + rhs2 * lhs22 + rhs3 * lhs32;
-  result.matrix[15] = rhs0 * lhs03 + rhs1 * lhs13 + rhs2 * lhs23 + rhs3 * lhs33;
+  multiplyMatrices(lhs.matrix, rhs.matrix, result.matrix);
 
   return result;
 }
@@ -19,19 +19,21 @@ namespace react {
 #pragma mark - Color
 
 inline void fromRawValue(const RawValue &value, SharedColor &result) {
+  if (value.hasType<int>()) {
+    // Fast path: the value is already packed as ARGB, which is exactly how
+    // `Color` stores it; unpacking and repacking the components would be a
+    // no-op (`colorFromComponents` rounds every component back to itself).
+    auto argb = (int64_t)value;
+    result = SharedColor((Color)(argb & 0xFFFFFFFF));
+    return;
+  }
+
   float red;
   float green;
   float blue;
   float alpha;
 
-  if (value.hasType<int>()) {
-    auto argb = (int64_t)value;
-    auto ratio = 255.f;
-    alpha = ((argb >> 24) & 0xFF) / ratio;
-    red = ((argb >> 16) & 0xFF) / ratio;
-    green = ((argb >> 8) & 0xFF) / ratio;
-    blue = (argb & 0xFF) / ratio;
-  } else if (value.hasType<std::vector<float>>()) {
+  if (value.hasType<std::vector<float>>()) {
     auto items = (std::vector<float>)value;
     auto length = items.size();
     assert(length == 3 || length == 4);
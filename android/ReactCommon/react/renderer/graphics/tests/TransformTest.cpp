@@ -66,3 +66,24 @@ TEST(TransformTest, scalingAndTranslatingRect) {
   EXPECT_EQ(transformedRect.size.width, 150);
   EXPECT_EQ(transformedRect.size.height, 200);
 }
+
+TEST(TransformTest, multiplyingMatrices) {
+  auto lhs = Transform{};
+  auto rhs = Transform{};
+  for (auto i = 0; i < 16; i++) {
+    lhs.matrix[i] = i + 1;
+    rhs.matrix[i] = 16 - i;
+  }
+
+  auto result = lhs * rhs;
+
+  for (auto i = 0; i < 4; i++) {
+    for (auto j = 0; j < 4; j++) {
+      auto expected = Float{0};
+      for (auto k = 0; k < 4; k++) {
+        expected += rhs.at(i, k) * lhs.at(k, j);
+      }
+      EXPECT_EQ(result.at(i, j), expected);
+    }
+  }
+}
@@ -15,7 +15,7 @@ LOCAL_SRC_FILES := $(wildcard $(LOCAL_PATH)/*.cpp)
 
 LOCAL_EXPORT_C_INCLUDES := $(LOCAL_PATH)/../../../
 
-LOCAL_SHARED_LIBRARIES := libreact_utils
+LOCAL_SHARED_LIBRARIES := libfolly_json libreact_utils
 
 LOCAL_CFLAGS := \
   -DLOG_TAG=\"Fabric\"
@@ -24,4 +24,5 @@ LOCAL_CFLAGS += -fexceptions -frtti -std=c++14 -Wall
 
 include $(BUILD_SHARED_LIBRARY)
 
+$(call import-module,folly)
 $(call import-module,react/utils)
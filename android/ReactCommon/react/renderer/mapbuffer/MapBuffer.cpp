@@ -7,12 +7,211 @@
 
 #include "MapBuffer.h"
 
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
 namespace facebook {
 namespace react {
 
-MapBuffer::MapBuffer() {}
+constexpr size_t MapBuffer::kMaximumArrayLength;
+
+template <typename T>
+static T readValue(uint8_t const *pointer) noexcept {
+  // The data is not guaranteed to be aligned (nested buffers might start at
+  // any offset), so we have to `memcpy` instead of dereferencing.
+  T value;
+  std::memcpy(&value, pointer, sizeof(T));
+  return value;
+}
+
+MapBuffer::MapBuffer(std::vector<uint8_t> data) {
+  if (data.empty()) {
+    return;
+  }
+
+  auto storage = std::make_shared<Storage const>(std::move(data));
+  *this = MapBuffer{storage, storage->data(), storage->size()};
+}
+
+MapBuffer::MapBuffer(
+    std::shared_ptr<Storage const> storage,
+    uint8_t const *data,
+    size_t size) noexcept
+    : storage_(std::move(storage)), data_(data), size_(size) {
+  assert(size_ >= sizeof(Header) && "MapBuffer is too small.");
+  auto header = readValue<Header>(data_);
+  assert(header.size == size_ && "MapBuffer size mismatch.");
+  assert(
+      sizeof(Header) + header.count * sizeof(Bucket) <= size_ &&
+      "MapBuffer is corrupted.");
+  count_ = header.count;
+}
+
+size_t MapBuffer::count() const noexcept {
+  return count_;
+}
+
+size_t MapBuffer::size() const noexcept {
+  return size_;
+}
+
+uint8_t const *MapBuffer::data() const noexcept {
+  return data_;
+}
+
+bool MapBuffer::contains(Key key) const noexcept {
+  return getIndexOf(key) != -1;
+}
+
+MapBuffer::Bucket MapBuffer::getBucketAt(size_t index) const noexcept {
+  assert(index < count_ && "MapBuffer index is out of bounds.");
+  return readValue<Bucket>(data_ + sizeof(Header) + index * sizeof(Bucket));
+}
+
+MapBuffer::Key MapBuffer::getKeyAt(size_t index) const noexcept {
+  assert(index < count_ && "MapBuffer index is out of bounds.");
+  return readValue<Key>(
+      data_ + sizeof(Header) + index * sizeof(Bucket) + offsetof(Bucket, key));
+}
+
+MapBuffer::DataType MapBuffer::getTypeAt(size_t index) const noexcept {
+  return getBucketAt(index).type;
+}
+
+int MapBuffer::getIndexOf(Key key) const noexcept {
+  int lower = 0;
+  int upper = static_cast<int>(count_) - 1;
+  while (lower <= upper) {
+    auto middle = (lower + upper) >> 1;
+    auto middleKey = getKeyAt(middle);
+    if (middleKey < key) {
+      lower = middle + 1;
+    } else if (middleKey > key) {
+      upper = middle - 1;
+    } else {
+      return middle;
+    }
+  }
+  return -1;
+}
+
+uint8_t const *MapBuffer::getDynamicDataAt(size_t index) const noexcept {
+  auto offset = getBucketAt(index).data;
+  auto dynamicData = data_ + sizeof(Header) + count_ * sizeof(Bucket);
+  assert(
+      dynamicData + offset + sizeof(uint32_t) <= data_ + size_ &&
+      "MapBuffer is corrupted.");
+  return dynamicData + offset;
+}
+
+#pragma mark - Getters by index
+
+bool MapBuffer::getBoolAt(size_t index) const noexcept {
+  auto bucket = getBucketAt(index);
+  if (bucket.type != DataType::Bool) {
+    assert(false && "MapBuffer type mismatch.");
+    return false;
+  }
+  return bucket.data != 0;
+}
+
+int64_t MapBuffer::getIntAt(size_t index) const noexcept {
+  auto bucket = getBucketAt(index);
+  if (bucket.type != DataType::Int) {
+    assert(false && "MapBuffer type mismatch.");
+    return 0;
+  }
+  return static_cast<int64_t>(bucket.data);
+}
+
+double MapBuffer::getDoubleAt(size_t index) const noexcept {
+  auto bucket = getBucketAt(index);
+  if (bucket.type != DataType::Double) {
+    assert(false && "MapBuffer type mismatch.");
+    return 0;
+  }
+  double value;
+  std::memcpy(&value, &bucket.data, sizeof(double));
+  return value;
+}
+
+folly::StringPiece MapBuffer::getStringAt(size_t index) const noexcept {
+  if (getTypeAt(index) != DataType::String) {
+    assert(false && "MapBuffer type mismatch.");
+    return folly::StringPiece{};
+  }
+  auto pointer = getDynamicDataAt(index);
+  auto length = readValue<uint32_t>(pointer);
+  return folly::StringPiece(
+      reinterpret_cast<char const *>(pointer + sizeof(uint32_t)), length);
+}
+
+MapBuffer MapBuffer::getMapBufferAt(size_t index) const noexcept {
+  auto type = getTypeAt(index);
+  if (type != DataType::Map && type != DataType::Array) {
+    assert(false && "MapBuffer type mismatch.");
+    return MapBuffer{};
+  }
+  auto pointer = getDynamicDataAt(index);
+  auto size = readValue<uint32_t>(pointer);
+  if (size == 0) {
+    // Default-constructed (empty) maps are stored without a header.
+    return MapBuffer{};
+  }
+  return MapBuffer{storage_, pointer + sizeof(uint32_t), size};
+}
+
+#pragma mark - Getters by key
+
+bool MapBuffer::isNull(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  return index == -1 || getTypeAt(index) == DataType::Null;
+}
+
+bool MapBuffer::getBool(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  assert(index != -1 && "MapBuffer key is missing.");
+  return index == -1 ? false : getBoolAt(index);
+}
+
+int64_t MapBuffer::getInt(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  assert(index != -1 && "MapBuffer key is missing.");
+  return index == -1 ? 0 : getIntAt(index);
+}
+
+double MapBuffer::getDouble(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  assert(index != -1 && "MapBuffer key is missing.");
+  return index == -1 ? 0 : getDoubleAt(index);
+}
+
+folly::StringPiece MapBuffer::getString(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  assert(index != -1 && "MapBuffer key is missing.");
+  return index == -1 ? folly::StringPiece{} : getStringAt(index);
+}
+
+MapBuffer MapBuffer::getMapBuffer(Key key) const noexcept {
+  auto index = getIndexOf(key);
+  assert(index != -1 && "MapBuffer key is missing.");
+  return index == -1 ? MapBuffer{} : getMapBufferAt(index);
+}
+
+MapBuffer MapBuffer::getArray(Key key) const noexcept {
+  return getMapBuffer(key);
+}
 
-MapBuffer::~MapBuffer() {}
+std::vector<MapBuffer> MapBuffer::getMapBufferList(Key key) const {
+  auto array = getArray(key);
+  auto list = std::vector<MapBuffer>{};
+  list.reserve(array.count());
+  for (size_t i = 0; i < array.count(); i++) {
+    list.push_back(array.getMapBufferAt(i));
+  }
+  return list;
+}
 
 } // namespace react
 } // namespace facebook
@@ -7,7 +7,12 @@
 
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <folly/Range.h>
 
 namespace facebook {
 namespace react {
@@ -26,11 +31,143 @@ namespace react {
  * - Supports dynamic types that map to JSON.
  * - Don't require mutability - single-write on creation.
  * - have minimal APK size and build time impact.
+ *
+ * The binary layout is (all values are stored in native byte order):
+ * - `Header`: the number of entries and the total size of the buffer;
+ * - `Bucket`s, sorted by key: a fixed-width (12 bytes) record per entry
+ *   containing the key, the type and the value itself (for scalar types) or
+ *   the offset of the value in the dynamic data section;
+ * - the dynamic data section: strings (a 32-bit length followed by the bytes)
+ *   and nested buffers (a 32-bit size followed by the nested MapBuffer).
+ *
+ * Arrays are stored as nested MapBuffers with keys `0..n-1`.
+ *
+ * `MapBuffer` objects are immutable views over refcounted storage; copying a
+ * `MapBuffer` and accessing nested maps and arrays never copies the data.
+ * Use `MapBufferBuilder` to construct instances.
  */
-class MapBuffer {
+class MapBuffer final {
  public:
-  MapBuffer();
-  virtual ~MapBuffer();
+  using Key = uint16_t;
+
+  enum class DataType : uint16_t {
+    Null = 0,
+    Bool = 1,
+    Int = 2,
+    Double = 3,
+    String = 4,
+    Map = 5,
+    Array = 6,
+  };
+
+#pragma pack(push, 1)
+  struct Header {
+    uint32_t count;
+    uint32_t size;
+  };
+
+  struct Bucket {
+    Key key;
+    DataType type;
+    uint64_t data;
+  };
+#pragma pack(pop)
+
+  static_assert(sizeof(Header) == 8, "MapBuffer::Header must be 8 bytes.");
+  static_assert(sizeof(Bucket) == 12, "MapBuffer::Bucket must be 12 bytes.");
+
+  /*
+   * The maximum number of items of an array (their indices are keys).
+   */
+  static constexpr size_t kMaximumArrayLength =
+      size_t{std::numeric_limits<Key>::max()} + 1;
+
+  /*
+   * Creates an empty map.
+   */
+  MapBuffer() = default;
+
+  /*
+   * Creates a map from serialized data (e.g. produced by `MapBufferBuilder`
+   * or received from another platform).
+   */
+  explicit MapBuffer(std::vector<uint8_t> data);
+
+  /*
+   * Returns the number of entries.
+   */
+  size_t count() const noexcept;
+
+  /*
+   * Returns the size of the serialized data in bytes.
+   */
+  size_t size() const noexcept;
+
+  /*
+   * Returns a pointer to the serialized data (`nullptr` for empty maps).
+   */
+  uint8_t const *data() const noexcept;
+
+  /*
+   * Returns `true` if the map contains an entry with given key.
+   */
+  bool contains(Key key) const noexcept;
+
+  /*
+   * Index-based access to entries, in ascending key order.
+   * `index` must be less than `count()`.
+   */
+  Key getKeyAt(size_t index) const noexcept;
+  DataType getTypeAt(size_t index) const noexcept;
+
+  /*
+   * Returns the index of the entry with given key, or `-1` if it's absent.
+   * Uses binary search over the sorted fixed-width buckets.
+   */
+  int getIndexOf(Key key) const noexcept;
+
+  /*
+   * Typed getters.
+   * Accessing a missing key (or a key with a different type) is a programming
+   * error; it's asserted in debug builds, and in release builds a default
+   * value (`false`, `0`, an empty string or an empty map) is returned.
+   * Strings are returned without copying, as views into the storage of the
+   * map; they stay valid as long as the map or any map sharing its storage
+   * (a copy, or a map it's nested in) exists.
+   */
+  bool isNull(Key key) const noexcept;
+  bool getBool(Key key) const noexcept;
+  int64_t getInt(Key key) const noexcept;
+  double getDouble(Key key) const noexcept;
+  folly::StringPiece getString(Key key) const noexcept;
+  MapBuffer getMapBuffer(Key key) const noexcept;
+  MapBuffer getArray(Key key) const noexcept;
+  std::vector<MapBuffer> getMapBufferList(Key key) const;
+
+  /*
+   * Same as the getters above, but use an index instead of a key.
+   */
+  bool getBoolAt(size_t index) const noexcept;
+  int64_t getIntAt(size_t index) const noexcept;
+  double getDoubleAt(size_t index) const noexcept;
+  folly::StringPiece getStringAt(size_t index) const noexcept;
+  MapBuffer getMapBufferAt(size_t index) const noexcept;
+
+ private:
+  using Storage = std::vector<uint8_t>;
+
+  MapBuffer(
+      std::shared_ptr<Storage const> storage,
+      uint8_t const *data,
+      size_t size) noexcept;
+
+  Bucket getBucketAt(size_t index) const noexcept;
+  uint8_t const *getDynamicDataAt(size_t index) const noexcept;
+
+  std::shared_ptr<Storage const> storage_{};
+  uint8_t const *data_{nullptr};
+  size_t size_{0};
+  size_t count_{0};
 };
 
 } // namespace react
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "MapBufferBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace facebook {
+namespace react {
+
+using Bucket = MapBuffer::Bucket;
+using DataType = MapBuffer::DataType;
+using Header = MapBuffer::Header;
+
+MapBufferBuilder::MapBufferBuilder(size_t initialCapacity) {
+  buckets_.reserve(initialCapacity);
+}
+
+MapBuffer MapBufferBuilder::EMPTY() {
+  return MapBufferBuilder(0).build();
+}
+
+void MapBufferBuilder::putBucket(
+    MapBuffer::Key key,
+    DataType type,
+    uint64_t data) {
+  if (!buckets_.empty() && buckets_.back().key >= key) {
+    needsSorting_ = true;
+  }
+  buckets_.push_back(Bucket{key, type, data});
+}
+
+void MapBufferBuilder::putDynamicData(
+    MapBuffer::Key key,
+    DataType type,
+    void const *data,
+    uint32_t size) {
+  // Offsets are relative to the beginning of the dynamic data section.
+  auto offset = dynamicData_.size();
+  dynamicData_.resize(offset + sizeof(uint32_t) + size);
+  std::memcpy(dynamicData_.data() + offset, &size, sizeof(uint32_t));
+  if (size > 0) {
+    std::memcpy(dynamicData_.data() + offset + sizeof(uint32_t), data, size);
+  }
+  putBucket(key, type, offset);
+}
+
+void MapBufferBuilder::putNull(MapBuffer::Key key) {
+  putBucket(key, DataType::Null, 0);
+}
+
+void MapBufferBuilder::putBool(MapBuffer::Key key, bool value) {
+  putBucket(key, DataType::Bool, value ? 1 : 0);
+}
+
+void MapBufferBuilder::putInt(MapBuffer::Key key, int64_t value) {
+  putBucket(key, DataType::Int, static_cast<uint64_t>(value));
+}
+
+void MapBufferBuilder::putDouble(MapBuffer::Key key, double value) {
+  uint64_t data;
+  std::memcpy(&data, &value, sizeof(double));
+  putBucket(key, DataType::Double, data);
+}
+
+void MapBufferBuilder::putString(
+    MapBuffer::Key key,
+    folly::StringPiece value) {
+  putDynamicData(
+      key,
+      DataType::String,
+      value.data(),
+      static_cast<uint32_t>(value.size()));
+}
+
+void MapBufferBuilder::putMapBuffer(MapBuffer::Key key, MapBuffer const &map) {
+  putDynamicData(
+      key, DataType::Map, map.data(), static_cast<uint32_t>(map.size()));
+}
+
+void MapBufferBuilder::putArray(MapBuffer::Key key, MapBuffer const &array) {
+  putDynamicData(
+      key, DataType::Array, array.data(), static_cast<uint32_t>(array.size()));
+}
+
+void MapBufferBuilder::putMapBufferList(
+    MapBuffer::Key key,
+    std::vector<MapBuffer> const &list) {
+  if (list.size() > MapBuffer::kMaximumArrayLength) {
+    throw std::length_error("MapBuffer list is too long.");
+  }
+  auto builder = MapBufferBuilder(list.size());
+  for (size_t i = 0; i < list.size(); i++) {
+    builder.putMapBuffer(static_cast<MapBuffer::Key>(i), list[i]);
+  }
+  putArray(key, builder.build());
+}
+
+MapBuffer MapBufferBuilder::build() {
+  if (needsSorting_) {
+    std::stable_sort(
+        buckets_.begin(),
+        buckets_.end(),
+        [](Bucket const &lhs, Bucket const &rhs) { return lhs.key < rhs.key; });
+
+    // Among entries with the same key, the last one wins.
+    auto end = buckets_.end();
+    auto it = buckets_.begin();
+    auto out = buckets_.begin();
+    while (it != end) {
+      auto next = it + 1;
+      while (next != end && next->key == it->key) {
+        it = next++;
+      }
+      *out++ = *it;
+      it = next;
+    }
+    buckets_.erase(out, end);
+  }
+
+  auto header = Header{};
+  header.count = static_cast<uint32_t>(buckets_.size());
+  auto bucketsSize = buckets_.size() * sizeof(Bucket);
+  header.size = static_cast<uint32_t>(
+      sizeof(Header) + bucketsSize + dynamicData_.size());
+
+  auto data = std::vector<uint8_t>(header.size);
+  std::memcpy(data.data(), &header, sizeof(Header));
+  if (bucketsSize > 0) {
+    std::memcpy(data.data() + sizeof(Header), buckets_.data(), bucketsSize);
+  }
+  if (!dynamicData_.empty()) {
+    std::memcpy(
+        data.data() + sizeof(Header) + bucketsSize,
+        dynamicData_.data(),
+        dynamicData_.size());
+  }
+
+  buckets_.clear();
+  dynamicData_.clear();
+  needsSorting_ = false;
+
+  return MapBuffer{std::move(data)};
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <react/renderer/mapbuffer/MapBuffer.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Constructs `MapBuffer` objects.
+ * Entries can be put in any order; if the same key is put several times, the
+ * last value wins. Arrays are MapBuffers with keys `0..n-1` (built with
+ * another `MapBufferBuilder`) put with `putArray`.
+ * Not thread-safe.
+ */
+class MapBufferBuilder final {
+ public:
+  explicit MapBufferBuilder(size_t initialCapacity = 16);
+
+  /*
+   * Returns an empty map.
+   */
+  static MapBuffer EMPTY();
+
+  void putNull(MapBuffer::Key key);
+  void putBool(MapBuffer::Key key, bool value);
+  void putInt(MapBuffer::Key key, int64_t value);
+  void putDouble(MapBuffer::Key key, double value);
+  void putString(MapBuffer::Key key, folly::StringPiece value);
+  void putMapBuffer(MapBuffer::Key key, MapBuffer const &map);
+  void putArray(MapBuffer::Key key, MapBuffer const &array);
+
+  /*
+   * Puts an array of maps. Throws `std::length_error` if the list is longer
+   * than `MapBuffer::kMaximumArrayLength`.
+   */
+  void putMapBufferList(MapBuffer::Key key, std::vector<MapBuffer> const &list);
+
+  /*
+   * Returns the built map and resets the builder.
+   */
+  MapBuffer build();
+
+ private:
+  void putBucket(MapBuffer::Key key, MapBuffer::DataType type, uint64_t data);
+  void putDynamicData(
+      MapBuffer::Key key,
+      MapBuffer::DataType type,
+      void const *data,
+      uint32_t size);
+
+  std::vector<MapBuffer::Bucket> buckets_{};
+  std::vector<uint8_t> dynamicData_{};
+  bool needsSorting_{false};
+};
+
+} // namespace react
+} // namespace facebook
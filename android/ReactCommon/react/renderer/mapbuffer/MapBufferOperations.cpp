@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "MapBufferOperations.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <react/renderer/mapbuffer/MapBufferBuilder.h>
+
+namespace facebook {
+namespace react {
+
+using DataType = MapBuffer::DataType;
+
+static void putValue(
+    MapBufferBuilder &builder,
+    MapBuffer::Key key,
+    MapBuffer const &map,
+    size_t index) {
+  switch (map.getTypeAt(index)) {
+    case DataType::Null:
+      builder.putNull(key);
+      break;
+    case DataType::Bool:
+      builder.putBool(key, map.getBoolAt(index));
+      break;
+    case DataType::Int:
+      builder.putInt(key, map.getIntAt(index));
+      break;
+    case DataType::Double:
+      builder.putDouble(key, map.getDoubleAt(index));
+      break;
+    case DataType::String:
+      builder.putString(key, map.getStringAt(index));
+      break;
+    case DataType::Map:
+      builder.putMapBuffer(key, map.getMapBufferAt(index));
+      break;
+    case DataType::Array:
+      builder.putArray(key, map.getMapBufferAt(index));
+      break;
+  }
+}
+
+static uint64_t doubleBits(double value) {
+  auto bits = uint64_t{};
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+bool mapBufferValuesEqual(
+    MapBuffer const &lhs,
+    size_t lhsIndex,
+    MapBuffer const &rhs,
+    size_t rhsIndex) {
+  auto type = lhs.getTypeAt(lhsIndex);
+  if (type != rhs.getTypeAt(rhsIndex)) {
+    return false;
+  }
+
+  switch (type) {
+    case DataType::Null:
+      return true;
+    case DataType::Bool:
+      return lhs.getBoolAt(lhsIndex) == rhs.getBoolAt(rhsIndex);
+    case DataType::Int:
+      return lhs.getIntAt(lhsIndex) == rhs.getIntAt(rhsIndex);
+    case DataType::Double:
+      return doubleBits(lhs.getDoubleAt(lhsIndex)) ==
+          doubleBits(rhs.getDoubleAt(rhsIndex));
+    case DataType::String:
+      return lhs.getStringAt(lhsIndex) == rhs.getStringAt(rhsIndex);
+    case DataType::Map:
+    case DataType::Array: {
+      auto lhsMap = lhs.getMapBufferAt(lhsIndex);
+      auto rhsMap = rhs.getMapBufferAt(rhsIndex);
+      return lhsMap.size() == rhsMap.size() &&
+          (lhsMap.data() == rhsMap.data() ||
+           std::memcmp(lhsMap.data(), rhsMap.data(), lhsMap.size()) == 0);
+    }
+  }
+  return false;
+}
+
+MapBufferDiff diffMapBuffers(
+    MapBuffer const &oldMap,
+    MapBuffer const &newMap) {
+  if (oldMap.data() == newMap.data() && oldMap.size() == newMap.size()) {
+    return MapBufferDiff{MapBufferBuilder::EMPTY(), {}};
+  }
+
+  auto builder = MapBufferBuilder();
+  auto removed = std::vector<MapBuffer::Key>{};
+  iterateMapBuffers(
+      oldMap, newMap, [&](MapBuffer::Key key, int oldIndex, int newIndex) {
+        if (newIndex == -1) {
+          removed.push_back(key);
+          return;
+        }
+        if (oldIndex != -1 &&
+            mapBufferValuesEqual(oldMap, oldIndex, newMap, newIndex)) {
+          return;
+        }
+        putValue(builder, key, newMap, newIndex);
+      });
+  return MapBufferDiff{builder.build(), std::move(removed)};
+}
+
+MapBuffer mergeMapBuffers(MapBuffer const &base, MapBuffer const &delta) {
+  if (delta.count() == 0) {
+    return base;
+  }
+
+  auto builder = MapBufferBuilder(base.count() + delta.count());
+  iterateMapBuffers(
+      base, delta, [&](MapBuffer::Key key, int baseIndex, int deltaIndex) {
+        if (deltaIndex != -1) {
+          putValue(builder, key, delta, deltaIndex);
+        } else {
+          putValue(builder, key, base, baseIndex);
+        }
+      });
+  return builder.build();
+}
+
+MapBuffer mergeMapBuffers(MapBuffer const &base, MapBufferDiff const &diff) {
+  if (diff.removed.empty()) {
+    return mergeMapBuffers(base, diff.changed);
+  }
+
+  auto builder = MapBufferBuilder(base.count() + diff.changed.count());
+  // Both `removed` and the keys of `base` are in ascending order.
+  auto removedIterator = diff.removed.begin();
+  iterateMapBuffers(
+      base,
+      diff.changed,
+      [&](MapBuffer::Key key, int baseIndex, int deltaIndex) {
+        if (deltaIndex != -1) {
+          putValue(builder, key, diff.changed, deltaIndex);
+          return;
+        }
+        removedIterator =
+            std::lower_bound(removedIterator, diff.removed.end(), key);
+        if (removedIterator == diff.removed.end() || *removedIterator != key) {
+          putValue(builder, key, base, baseIndex);
+        }
+      });
+  return builder.build();
+}
+
+MapBuffer intersectMapBuffers(MapBuffer const &lhs, MapBuffer const &rhs) {
+  auto builder = MapBufferBuilder();
+  iterateMapBuffers(
+      lhs, rhs, [&](MapBuffer::Key key, int lhsIndex, int rhsIndex) {
+        if (lhsIndex != -1 && rhsIndex != -1) {
+          putValue(builder, key, rhs, rhsIndex);
+        }
+      });
+  return builder.build();
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <react/renderer/mapbuffer/MapBuffer.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Walks the sorted key tables of both maps in a single linear pass and calls
+ * `callback(key, lhsIndex, rhsIndex)` for every key present in at least one of
+ * them, in ascending key order. The index of the map that doesn't contain the
+ * key is `-1`.
+ */
+template <typename CallbackT>
+void iterateMapBuffers(
+    MapBuffer const &lhs,
+    MapBuffer const &rhs,
+    CallbackT &&callback) {
+  auto lhsCount = static_cast<int>(lhs.count());
+  auto rhsCount = static_cast<int>(rhs.count());
+  int lhsIndex = 0;
+  int rhsIndex = 0;
+
+  while (lhsIndex < lhsCount && rhsIndex < rhsCount) {
+    auto lhsKey = lhs.getKeyAt(lhsIndex);
+    auto rhsKey = rhs.getKeyAt(rhsIndex);
+    if (lhsKey < rhsKey) {
+      callback(lhsKey, lhsIndex++, -1);
+    } else if (lhsKey > rhsKey) {
+      callback(rhsKey, -1, rhsIndex++);
+    } else {
+      callback(lhsKey, lhsIndex++, rhsIndex++);
+    }
+  }
+
+  for (; lhsIndex < lhsCount; lhsIndex++) {
+    callback(lhs.getKeyAt(lhsIndex), lhsIndex, -1);
+  }
+
+  for (; rhsIndex < rhsCount; rhsIndex++) {
+    callback(rhs.getKeyAt(rhsIndex), -1, rhsIndex);
+  }
+}
+
+/*
+ * Returns `true` if the entries at given indices have the same type and
+ * value. Doubles, nested maps and arrays are compared bit-wise (so `0.0` and
+ * `-0.0` differ, a NaN equals the same NaN, and logically equal maps built in
+ * a different order might be reported as different).
+ */
+bool mapBufferValuesEqual(
+    MapBuffer const &lhs,
+    size_t lhsIndex,
+    MapBuffer const &rhs,
+    size_t rhsIndex);
+
+/*
+ * Difference between two maps (see `diffMapBuffers`).
+ */
+struct MapBufferDiff {
+  /*
+   * Entries of the new map that are absent from or different in the old one.
+   */
+  MapBuffer changed;
+
+  /*
+   * Keys of the old map that are absent from the new one, in ascending order.
+   * Kept apart from `changed`, so a removed key can't be confused with a key
+   * set to `null`.
+   */
+  std::vector<MapBuffer::Key> removed;
+};
+
+/*
+ * Returns the difference between `oldMap` and `newMap`.
+ * `mergeMapBuffers(oldMap, diffMapBuffers(oldMap, newMap))` has the same
+ * entries as `newMap`.
+ */
+MapBufferDiff diffMapBuffers(MapBuffer const &oldMap, MapBuffer const &newMap);
+
+/*
+ * Returns `base` with all entries of `delta` applied on top of it (shallowly;
+ * nested maps from `delta` replace the ones from `base`).
+ */
+MapBuffer mergeMapBuffers(MapBuffer const &base, MapBuffer const &delta);
+
+/*
+ * Returns `base` with `diff` applied on top of it: the keys removed by the
+ * diff are dropped and its changed entries are merged as by the overload
+ * above.
+ */
+MapBuffer mergeMapBuffers(MapBuffer const &base, MapBufferDiff const &diff);
+
+/*
+ * Returns the entries of `rhs` whose keys are also present in `lhs`.
+ */
+MapBuffer intersectMapBuffers(MapBuffer const &lhs, MapBuffer const &rhs);
+
+} // namespace react
+} // namespace facebook
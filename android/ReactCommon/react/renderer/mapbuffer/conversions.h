@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <stdexcept>
+
+#include <folly/Conv.h>
+#include <folly/dynamic.h>
+#include <react/renderer/mapbuffer/MapBuffer.h>
+#include <react/renderer/mapbuffer/MapBufferBuilder.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Conversions between `MapBuffer` and `folly::dynamic`.
+ * MapBuffer keys are integers, so objects are represented as `folly::dynamic`
+ * objects with integer keys (keys that are strings containing integers are
+ * accepted as well when converting to `MapBuffer`).
+ */
+
+inline folly::dynamic toDynamic(MapBuffer const &map);
+inline folly::dynamic arrayToDynamic(MapBuffer const &array);
+
+inline folly::dynamic valueToDynamic(MapBuffer const &map, size_t index) {
+  switch (map.getTypeAt(index)) {
+    case MapBuffer::DataType::Null:
+      return nullptr;
+    case MapBuffer::DataType::Bool:
+      return map.getBoolAt(index);
+    case MapBuffer::DataType::Int:
+      return map.getIntAt(index);
+    case MapBuffer::DataType::Double:
+      return map.getDoubleAt(index);
+    case MapBuffer::DataType::String:
+      return map.getStringAt(index);
+    case MapBuffer::DataType::Map:
+      return toDynamic(map.getMapBufferAt(index));
+    case MapBuffer::DataType::Array:
+      return arrayToDynamic(map.getMapBufferAt(index));
+  }
+  assert(false && "Unknown MapBuffer data type.");
+  return nullptr;
+}
+
+/*
+ * Converts a `MapBuffer` into a `folly::dynamic` object.
+ */
+inline folly::dynamic toDynamic(MapBuffer const &map) {
+  folly::dynamic object = folly::dynamic::object();
+  for (size_t i = 0; i < map.count(); i++) {
+    object[static_cast<int64_t>(map.getKeyAt(i))] = valueToDynamic(map, i);
+  }
+  return object;
+}
+
+/*
+ * Converts a `MapBuffer` representing an array into a `folly::dynamic` array.
+ */
+inline folly::dynamic arrayToDynamic(MapBuffer const &array) {
+  auto result = folly::dynamic::array();
+  for (size_t i = 0; i < array.count(); i++) {
+    result.push_back(valueToDynamic(array, i));
+  }
+  return result;
+}
+
+inline MapBuffer mapBufferFromDynamic(folly::dynamic const &value);
+
+inline void putDynamic(
+    MapBufferBuilder &builder,
+    MapBuffer::Key key,
+    folly::dynamic const &value) {
+  switch (value.type()) {
+    case folly::dynamic::NULLT:
+      builder.putNull(key);
+      break;
+    case folly::dynamic::BOOL:
+      builder.putBool(key, value.getBool());
+      break;
+    case folly::dynamic::INT64:
+      builder.putInt(key, value.getInt());
+      break;
+    case folly::dynamic::DOUBLE:
+      builder.putDouble(key, value.getDouble());
+      break;
+    case folly::dynamic::STRING:
+      builder.putString(key, value.getString());
+      break;
+    case folly::dynamic::ARRAY:
+      builder.putArray(key, mapBufferFromDynamic(value));
+      break;
+    case folly::dynamic::OBJECT:
+      builder.putMapBuffer(key, mapBufferFromDynamic(value));
+      break;
+  }
+}
+
+/*
+ * Converts a `folly::dynamic` object or array into a `MapBuffer`.
+ * Throws `std::length_error` for arrays longer than
+ * `MapBuffer::kMaximumArrayLength` (the indices of items are keys).
+ */
+inline MapBuffer mapBufferFromDynamic(folly::dynamic const &value) {
+  assert(
+      (value.isObject() || value.isArray()) &&
+      "Only objects and arrays can be converted to MapBuffer.");
+  auto builder = MapBufferBuilder(value.size());
+
+  if (value.isArray()) {
+    if (value.size() > MapBuffer::kMaximumArrayLength) {
+      throw std::length_error(
+          "Array is too long to be converted to MapBuffer.");
+    }
+    auto index = MapBuffer::Key{0};
+    for (auto const &item : value) {
+      putDynamic(builder, index++, item);
+    }
+    return builder.build();
+  }
+
+  for (auto const &pair : value.items()) {
+    auto key = pair.first.isString()
+        ? folly::to<MapBuffer::Key>(pair.first.getString())
+        : folly::to<MapBuffer::Key>(pair.first.asInt());
+    putDynamic(builder, key, pair.second);
+  }
+  return builder.build();
+}
+
+} // namespace react
+} // namespace facebook
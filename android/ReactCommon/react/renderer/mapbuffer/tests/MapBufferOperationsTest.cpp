@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <react/renderer/mapbuffer/MapBufferOperations.h>
+#include <react/renderer/mapbuffer/conversions.h>
+
+using namespace facebook::react;
+
+static MapBuffer mapBuffer(folly::dynamic const &object) {
+  return mapBufferFromDynamic(object);
+}
+
+TEST(MapBufferOperationsTest, iterationWalksBothMapsInKeyOrder) {
+  auto lhs = mapBuffer(folly::dynamic::object(1, 1)(3, 3)(5, 5));
+  auto rhs = mapBuffer(folly::dynamic::object(2, 2)(3, 3)(6, 6)(7, 7));
+
+  auto keys = std::vector<int>{};
+  auto lhsIndices = std::vector<int>{};
+  auto rhsIndices = std::vector<int>{};
+  iterateMapBuffers(
+      lhs, rhs, [&](MapBuffer::Key key, int lhsIndex, int rhsIndex) {
+        keys.push_back(key);
+        lhsIndices.push_back(lhsIndex);
+        rhsIndices.push_back(rhsIndex);
+      });
+
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 5, 6, 7}));
+  EXPECT_EQ(lhsIndices, (std::vector<int>{0, -1, 1, 2, -1, -1}));
+  EXPECT_EQ(rhsIndices, (std::vector<int>{-1, 0, 1, -1, 2, 3}));
+}
+
+TEST(MapBufferOperationsTest, diff) {
+  auto oldMap = mapBuffer(folly::dynamic::object(0, 1.0)(1, "same")(2, true)(
+      3, folly::dynamic::array(1, 2))(4, 10));
+  auto newMap = mapBuffer(folly::dynamic::object(0, 0.5)(1, "same")(2, true)(
+      3, folly::dynamic::array(1, 2, 3))(5, "new"));
+
+  auto diff = diffMapBuffers(oldMap, newMap);
+
+  folly::dynamic expected = folly::dynamic::object(0, 0.5)(
+      3, folly::dynamic::array(1, 2, 3))(5, "new");
+  EXPECT_EQ(toDynamic(diff.changed), expected);
+  EXPECT_EQ(diff.removed, (std::vector<MapBuffer::Key>{4}));
+}
+
+TEST(MapBufferOperationsTest, diffComparesDoublesBitwise) {
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto oldMap = mapBuffer(folly::dynamic::object(0, 0.0)(1, nan));
+  auto newMap = mapBuffer(folly::dynamic::object(0, -0.0)(1, nan));
+
+  auto diff = diffMapBuffers(oldMap, newMap);
+
+  EXPECT_EQ(diff.changed.count(), 1);
+  EXPECT_EQ(diff.changed.getKeyAt(0), 0);
+  EXPECT_TRUE(std::signbit(diff.changed.getDoubleAt(0)));
+  EXPECT_TRUE(diff.removed.empty());
+}
+
+TEST(MapBufferOperationsTest, diffOfEqualMapsIsEmpty) {
+  auto map = mapBuffer(folly::dynamic::object(0, 1)(1, "value"));
+
+  EXPECT_EQ(diffMapBuffers(map, map).changed.count(), 0);
+  auto diff =
+      diffMapBuffers(map, mapBuffer(folly::dynamic::object(0, 1)(1, "value")));
+  EXPECT_EQ(diff.changed.count(), 0);
+  EXPECT_TRUE(diff.removed.empty());
+}
+
+TEST(MapBufferOperationsTest, mergeAppliesDiff) {
+  auto oldMap = mapBuffer(folly::dynamic::object(0, 1)(1, "a")(2, true));
+  auto newMap = mapBuffer(folly::dynamic::object(0, 2)(1, "a")(3, 0.5));
+
+  auto merged = mergeMapBuffers(oldMap, diffMapBuffers(oldMap, newMap));
+
+  EXPECT_EQ(toDynamic(merged), toDynamic(newMap));
+}
+
+TEST(MapBufferOperationsTest, mergeTellsRemovedKeysFromNullValues) {
+  auto oldMap = mapBuffer(folly::dynamic::object(0, 1)(1, "a")(2, true));
+  auto newMap = mapBuffer(folly::dynamic::object(0, nullptr)(2, true));
+
+  auto diff = diffMapBuffers(oldMap, newMap);
+  EXPECT_EQ(toDynamic(diff.changed), folly::dynamic::object(0, nullptr));
+  EXPECT_EQ(diff.removed, (std::vector<MapBuffer::Key>{1}));
+
+  auto merged = mergeMapBuffers(oldMap, diff);
+  EXPECT_EQ(merged.count(), 2);
+  EXPECT_EQ(toDynamic(merged), toDynamic(newMap));
+}
+
+TEST(MapBufferOperationsTest, intersection) {
+  auto lhs = mapBuffer(folly::dynamic::object(0, 1)(1, 1)(4, 1));
+  auto rhs = mapBuffer(folly::dynamic::object(1, "b")(2, "b")(4, "b"));
+
+  folly::dynamic expected = folly::dynamic::object(1, "b")(4, "b");
+  EXPECT_EQ(toDynamic(intersectMapBuffers(lhs, rhs)), expected);
+  EXPECT_EQ(intersectMapBuffers(lhs, MapBuffer{}).count(), 0);
+}
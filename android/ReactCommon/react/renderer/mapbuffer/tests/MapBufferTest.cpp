@@ -6,9 +6,174 @@
  */
 
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include <react/renderer/mapbuffer/MapBuffer.h>
+#include <react/renderer/mapbuffer/MapBufferBuilder.h>
+#include <react/renderer/mapbuffer/conversions.h>
 
-TEST(MapBufferTest, testSomething) {
-  // TODO
+using namespace facebook::react;
+
+TEST(MapBufferTest, emptyMap) {
+  auto map = MapBufferBuilder::EMPTY();
+
+  EXPECT_EQ(map.count(), 0);
+  EXPECT_EQ(map.size(), sizeof(MapBuffer::Header));
+  EXPECT_FALSE(map.contains(0));
+  EXPECT_EQ(MapBuffer{}.count(), 0);
+}
+
+TEST(MapBufferTest, scalarValues) {
+  auto builder = MapBufferBuilder();
+  builder.putBool(0, true);
+  builder.putInt(1, -42);
+  builder.putInt(2, 1ll << 40);
+  builder.putDouble(3, 0.25);
+  builder.putNull(4);
+  auto map = builder.build();
+
+  EXPECT_EQ(map.count(), 5);
+  EXPECT_EQ(
+      map.size(), sizeof(MapBuffer::Header) + 5 * sizeof(MapBuffer::Bucket));
+  EXPECT_TRUE(map.getBool(0));
+  EXPECT_EQ(map.getInt(1), -42);
+  EXPECT_EQ(map.getInt(2), 1ll << 40);
+  EXPECT_EQ(map.getDouble(3), 0.25);
+  EXPECT_TRUE(map.isNull(4));
+  EXPECT_TRUE(map.isNull(5));
+  EXPECT_FALSE(map.isNull(0));
+}
+
+TEST(MapBufferTest, stringValues) {
+  auto builder = MapBufferBuilder();
+  builder.putString(0, "");
+  builder.putString(1, "hello");
+  builder.putString(2, std::string(1000, 'x'));
+  auto map = builder.build();
+
+  EXPECT_EQ(map.getString(0), "");
+  EXPECT_EQ(map.getString(1), "hello");
+  EXPECT_EQ(map.getString(2), std::string(1000, 'x'));
+
+  // Strings point into the storage of the map; nothing is copied.
+  auto string = map.getString(1);
+  EXPECT_GE(reinterpret_cast<uint8_t const *>(string.begin()), map.data());
+  EXPECT_LE(
+      reinterpret_cast<uint8_t const *>(string.end()), map.data() + map.size());
+}
+
+#ifdef NDEBUG
+// In debug builds, mismatches are asserted instead.
+TEST(MapBufferTest, typeMismatchReturnsDefaultValues) {
+  auto builder = MapBufferBuilder();
+  builder.putInt(1, 1ll << 40);
+  builder.putString(2, "hello");
+  auto map = builder.build();
+
+  EXPECT_EQ(map.getString(1), "");
+  EXPECT_EQ(map.getMapBuffer(1).count(), 0);
+  EXPECT_EQ(map.getDouble(1), 0);
+  EXPECT_EQ(map.getInt(2), 0);
+  EXPECT_FALSE(map.getBool(2));
+  EXPECT_EQ(map.getString(3), "");
+}
+#endif
+
+TEST(MapBufferTest, keysAreSorted) {
+  auto builder = MapBufferBuilder();
+  builder.putInt(300, 3);
+  builder.putInt(7, 1);
+  builder.putInt(65535, 4);
+  builder.putInt(42, 2);
+  builder.putInt(7, 5);
+  auto map = builder.build();
+
+  EXPECT_EQ(map.count(), 4);
+  EXPECT_EQ(map.getKeyAt(0), 7);
+  EXPECT_EQ(map.getKeyAt(1), 42);
+  EXPECT_EQ(map.getKeyAt(2), 300);
+  EXPECT_EQ(map.getKeyAt(3), 65535);
+
+  // The last value put for a key wins.
+  EXPECT_EQ(map.getInt(7), 5);
+  EXPECT_EQ(map.getInt(65535), 4);
+  EXPECT_EQ(map.getIndexOf(42), 1);
+  EXPECT_EQ(map.getIndexOf(43), -1);
+}
+
+TEST(MapBufferTest, nestedMapsAndArrays) {
+  auto innerBuilder = MapBufferBuilder();
+  innerBuilder.putString(0, "inner");
+  innerBuilder.putDouble(1, 1.5);
+  auto inner = innerBuilder.build();
+
+  auto builder = MapBufferBuilder();
+  builder.putMapBuffer(0, inner);
+  builder.putMapBufferList(1, {inner, inner, MapBuffer{}});
+  builder.putInt(2, 7);
+  auto map = builder.build();
+
+  auto nested = map.getMapBuffer(0);
+  EXPECT_EQ(nested.getString(0), "inner");
+  EXPECT_EQ(nested.getDouble(1), 1.5);
+
+  auto list = map.getMapBufferList(1);
+  EXPECT_EQ(list.size(), 3);
+  EXPECT_EQ(list[1].getString(0), "inner");
+  EXPECT_EQ(list[2].count(), 0);
+  EXPECT_EQ(map.getInt(2), 7);
+
+  // Nested maps point into the storage of the parent; nothing is copied.
+  EXPECT_GE(nested.data(), map.data());
+  EXPECT_LE(nested.data() + nested.size(), map.data() + map.size());
+}
+
+TEST(MapBufferTest, listsLongerThanKeysAllowAreRejected) {
+  auto builder = MapBufferBuilder();
+  builder.putMapBufferList(
+      0, std::vector<MapBuffer>(MapBuffer::kMaximumArrayLength));
+  auto map = builder.build();
+  EXPECT_EQ(map.getArray(0).count(), MapBuffer::kMaximumArrayLength);
+
+  EXPECT_THROW(
+      builder.putMapBufferList(
+          0, std::vector<MapBuffer>(MapBuffer::kMaximumArrayLength + 1)),
+      std::length_error);
+
+  auto array = folly::dynamic::array();
+  array.resize(MapBuffer::kMaximumArrayLength + 1);
+  EXPECT_THROW(mapBufferFromDynamic(array), std::length_error);
+}
+
+TEST(MapBufferTest, copiesShareStorage) {
+  auto builder = MapBufferBuilder();
+  builder.putString(0, "value");
+  auto map = builder.build();
+  auto copy = map;
+
+  EXPECT_EQ(copy.data(), map.data());
+  EXPECT_EQ(copy.getString(0), "value");
+}
+
+TEST(MapBufferTest, dynamicConversions) {
+  folly::dynamic object = folly::dynamic::object(0, nullptr)(1, true)(2, 10)(
+      3, 0.5)(4, "text")(5, folly::dynamic::array(1, "two", 3.0))(
+      6, folly::dynamic::object(10, folly::dynamic::array()));
+
+  auto map = mapBufferFromDynamic(object);
+
+  EXPECT_EQ(map.count(), 7);
+  EXPECT_EQ(map.getTypeAt(5), MapBuffer::DataType::Array);
+  EXPECT_EQ(map.getArray(5).getString(1), "two");
+  EXPECT_EQ(toDynamic(map), object);
+}
+
+TEST(MapBufferTest, dynamicConversionsWithStringKeys) {
+  auto map =
+      mapBufferFromDynamic(folly::dynamic::object("12", 1)("3", "value"));
+
+  EXPECT_EQ(map.getInt(12), 1);
+  EXPECT_EQ(map.getString(3), "value");
 }
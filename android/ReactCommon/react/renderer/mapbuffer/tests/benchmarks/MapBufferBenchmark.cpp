@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <benchmark/benchmark.h>
+#include <folly/dynamic.h>
+#include <react/renderer/mapbuffer/MapBuffer.h>
+#include <react/renderer/mapbuffer/MapBufferBuilder.h>
+#include <react/renderer/mapbuffer/conversions.h>
+#include <string>
+
+namespace facebook {
+namespace react {
+
+/*
+ * A props-sized payload: a dozen of scalar props, a string and a transform.
+ */
+static MapBuffer buildMapBuffer() {
+  auto builder = MapBufferBuilder();
+  for (MapBuffer::Key key = 0; key < 12; key++) {
+    builder.putDouble(key, key * 1.5);
+  }
+  builder.putBool(12, true);
+  builder.putString(13, "some-native-id");
+
+  auto transformBuilder = MapBufferBuilder();
+  for (MapBuffer::Key key = 0; key < 16; key++) {
+    transformBuilder.putDouble(key, key % 5 == 0 ? 1 : 0);
+  }
+  builder.putArray(14, transformBuilder.build());
+  return builder.build();
+}
+
+static folly::dynamic buildDynamic() {
+  folly::dynamic object = folly::dynamic::object();
+  for (int key = 0; key < 12; key++) {
+    object["prop" + std::to_string(key)] = key * 1.5;
+  }
+  object["collapsable"] = true;
+  object["nativeID"] = "some-native-id";
+
+  auto transform = folly::dynamic::array();
+  for (int key = 0; key < 16; key++) {
+    transform.push_back(key % 5 == 0 ? 1.0 : 0.0);
+  }
+  object["transform"] = transform;
+  return object;
+}
+
+static void mapBufferCreation(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buildMapBuffer());
+  }
+}
+BENCHMARK(mapBufferCreation);
+
+static void dynamicCreation(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buildDynamic());
+  }
+}
+BENCHMARK(dynamicCreation);
+
+static void mapBufferCopy(benchmark::State &state) {
+  auto map = buildMapBuffer();
+  for (auto _ : state) {
+    auto copy = map;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(mapBufferCopy);
+
+static void dynamicCopy(benchmark::State &state) {
+  auto object = buildDynamic();
+  for (auto _ : state) {
+    auto copy = object;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(dynamicCopy);
+
+static void mapBufferRead(benchmark::State &state) {
+  auto map = buildMapBuffer();
+  for (auto _ : state) {
+    auto sum = 0.0;
+    for (MapBuffer::Key key = 0; key < 12; key++) {
+      sum += map.getDouble(key);
+    }
+    sum += map.getArray(14).getDouble(0);
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(map.getString(13));
+  }
+}
+BENCHMARK(mapBufferRead);
+
+static void dynamicRead(benchmark::State &state) {
+  auto object = buildDynamic();
+  auto keys = std::vector<std::string>{};
+  for (int key = 0; key < 12; key++) {
+    keys.push_back("prop" + std::to_string(key));
+  }
+  for (auto _ : state) {
+    auto sum = 0.0;
+    for (auto const &key : keys) {
+      sum += object[key].getDouble();
+    }
+    sum += object["transform"][0].getDouble();
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(object["nativeID"].getString());
+  }
+}
+BENCHMARK(dynamicRead);
+
+static void mapBufferToDynamic(benchmark::State &state) {
+  auto map = buildMapBuffer();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(toDynamic(map));
+  }
+}
+BENCHMARK(mapBufferToDynamic);
+
+} // namespace react
+} // namespace facebook
+
+BENCHMARK_MAIN();
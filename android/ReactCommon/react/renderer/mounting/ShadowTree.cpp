@@ -224,10 +224,12 @@ ShadowTree::ShadowTree(
     RootComponentDescriptor const &rootComponentDescriptor,
     ShadowTreeDelegate const &delegate,
     std::weak_ptr<MountingOverrideDelegate const> mountingOverrideDelegate,
-    bool enableReparentingDetection)
+    bool enableReparentingDetection,
+    bool enableBackgroundLayout)
     : surfaceId_(surfaceId),
       delegate_(delegate),
-      enableReparentingDetection_(enableReparentingDetection) {
+      enableReparentingDetection_(enableReparentingDetection),
+      enableBackgroundLayout_(enableBackgroundLayout) {
   const auto noopEventEmitter = std::make_shared<const ViewEventEmitter>(
       nullptr, -1, std::shared_ptr<const EventDispatcher>());
 
@@ -247,12 +249,31 @@ ShadowTree::ShadowTree(
 
   currentRevision_ = ShadowTreeRevision{
       rootShadowNode, ShadowTreeRevision::Number{0}, TransactionTelemetry{}};
+  laidOutRevision_ = currentRevision_;
 
   mountingCoordinator_ = std::make_shared<MountingCoordinator const>(
       currentRevision_, mountingOverrideDelegate, enableReparentingDetection);
+
+  if (enableBackgroundLayout_) {
+    backgroundLayoutThread_ = std::thread([this] { runBackgroundLayout(); });
+  }
 }
 
 ShadowTree::~ShadowTree() {
+  if (backgroundLayoutThread_.joinable()) {
+    {
+      // Waits for a tree which is being mounted; the thread does not mount
+      // anything (nor calls the delegate) afterwards. The tree committed when
+      // the surface stops was mounted synchronously (see `commitEmptyTree`).
+      std::lock_guard<std::mutex> mountingLock(backgroundLayoutMountingMutex_);
+      std::lock_guard<std::mutex> lock(backgroundLayoutMutex_);
+      isBackgroundLayoutStopped_ = true;
+    }
+    backgroundLayoutSignal_.notify_one();
+    backgroundLayoutFinishedSignal_.notify_all();
+    backgroundLayoutThread_.join();
+  }
+
   mountingCoordinator_->revoke();
 }
 
@@ -267,6 +288,13 @@ MountingCoordinator::Shared ShadowTree::getMountingCoordinator() const {
 CommitStatus ShadowTree::commit(
     ShadowTreeCommitTransaction transaction,
     CommitOptions commitOptions) const {
+  return commit(transaction, commitOptions, enableBackgroundLayout_);
+}
+
+CommitStatus ShadowTree::commit(
+    ShadowTreeCommitTransaction const &transaction,
+    CommitOptions const &commitOptions,
+    bool deferLayout) const {
   SystraceSection s("ShadowTree::commit");
 
   int attempts = 0;
@@ -274,7 +302,7 @@ CommitStatus ShadowTree::commit(
   while (true) {
     attempts++;
 
-    auto status = tryCommit(transaction, commitOptions);
+    auto status = tryCommit(transaction, commitOptions, deferLayout);
     if (status != CommitStatus::Failed) {
       return status;
     }
@@ -288,6 +316,13 @@ CommitStatus ShadowTree::commit(
 CommitStatus ShadowTree::tryCommit(
     ShadowTreeCommitTransaction transaction,
     CommitOptions commitOptions) const {
+  return tryCommit(transaction, commitOptions, enableBackgroundLayout_);
+}
+
+CommitStatus ShadowTree::tryCommit(
+    ShadowTreeCommitTransaction const &transaction,
+    CommitOptions const &commitOptions,
+    bool deferLayout) const {
   SystraceSection s("ShadowTree::tryCommit");
 
   auto telemetry = TransactionTelemetry{};
@@ -320,13 +355,20 @@ CommitStatus ShadowTree::tryCommit(
 
   // Layout nodes.
   std::vector<LayoutableShadowNode const *> affectedLayoutableNodes{};
-  affectedLayoutableNodes.reserve(1024);
 
-  telemetry.willLayout();
-  telemetry.setAsThreadLocal();
-  newRootShadowNode->layoutIfNeeded(&affectedLayoutableNodes);
-  telemetry.unsetAsThreadLocal();
-  telemetry.didLayout();
+  if (deferLayout) {
+    // The layout thread lays out a clone of the root; Yoga clones the nodes
+    // it needs to change, so the committed tree stays intact.
+    newRootShadowNode->prepareLayout();
+  } else {
+    affectedLayoutableNodes.reserve(1024);
+
+    telemetry.willLayout();
+    telemetry.setAsThreadLocal();
+    newRootShadowNode->layoutIfNeeded(&affectedLayoutableNodes);
+    telemetry.unsetAsThreadLocal();
+    telemetry.didLayout();
+  }
 
   // Seal the shadow node so it can no longer be mutated
   newRootShadowNode->sealRecursive();
@@ -356,12 +398,38 @@ CommitStatus ShadowTree::tryCommit(
         ShadowTreeRevision{newRootShadowNode, newRevisionNumber, telemetry};
 
     currentRevision_ = newRevision;
+
+    if (!deferLayout) {
+      lastMountedRevisionNumber_ = newRevisionNumber;
+    }
+
+    if (enableBackgroundLayout_) {
+      std::lock_guard<std::mutex> backgroundLayoutLock(backgroundLayoutMutex_);
+      isBackgroundLayoutRequested_ = deferLayout;
+      isCurrentRevisionLaidOut_ = !deferLayout;
+      if (!deferLayout) {
+        laidOutRevision_ = newRevision;
+      }
+    }
+  }
+
+  if (deferLayout) {
+    // The committed tree is sealed and laid out later, so nodes can start
+    // preparing for layout (e.g. measuring text) in the background.
+    newRootShadowNode->prefetchLayoutTree();
+    backgroundLayoutSignal_.notify_one();
+  } else if (enableBackgroundLayout_) {
+    backgroundLayoutFinishedSignal_.notify_all();
   }
 
   if (commitOptions.shouldCancel && commitOptions.shouldCancel()) {
     return CommitStatus::Cancelled;
   }
 
+  if (deferLayout) {
+    return CommitStatus::Succeeded;
+  }
+
   emitLayoutEvents(affectedLayoutableNodes);
 
   mountingCoordinator_->push(newRevision);
@@ -376,6 +444,24 @@ ShadowTreeRevision ShadowTree::getCurrentRevision() const {
   return currentRevision_;
 }
 
+ShadowTreeRevision ShadowTree::getCurrentLaidOutRevision() const {
+  // The layout thread itself (e.g. the delegate called by it) gets the
+  // current revision as is.
+  if (enableBackgroundLayout_ &&
+      std::this_thread::get_id() != backgroundLayoutThread_.get_id()) {
+    std::unique_lock<std::mutex> lock(backgroundLayoutMutex_);
+    backgroundLayoutFinishedSignal_.wait(lock, [this] {
+      return isCurrentRevisionLaidOut_ || isBackgroundLayoutStopped_;
+    });
+    if (isCurrentRevisionLaidOut_) {
+      return laidOutRevision_;
+    }
+  }
+
+  std::shared_lock<better::shared_mutex> lock(commitMutex_);
+  return currentRevision_;
+}
+
 void ShadowTree::commitEmptyTree() const {
   commit(
       [](RootShadowNode const &oldRootShadowNode) -> RootShadowNode::Unshared {
@@ -385,7 +471,9 @@ void ShadowTree::commitEmptyTree() const {
                 /* .props = */ ShadowNodeFragment::propsPlaceholder(),
                 /* .children = */ ShadowNode::emptySharedShadowNodeSharedList(),
             });
-      });
+      },
+      {false},
+      false);
 }
 
 void ShadowTree::emitLayoutEvents(
@@ -411,6 +499,91 @@ void ShadowTree::emitLayoutEvents(
   }
 }
 
+void ShadowTree::runBackgroundLayout() const {
+  auto supersededLayoutCount = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(backgroundLayoutMutex_);
+      backgroundLayoutSignal_.wait(lock, [this] {
+        return isBackgroundLayoutRequested_ || isBackgroundLayoutStopped_;
+      });
+      if (isBackgroundLayoutStopped_) {
+        return;
+      }
+      isBackgroundLayoutRequested_ = false;
+    }
+
+    SystraceSection s("ShadowTree::runBackgroundLayout");
+
+    auto revision = ShadowTreeRevision{};
+    {
+      std::shared_lock<better::shared_mutex> lock(commitMutex_);
+      revision = currentRevision_;
+    }
+
+    // Yoga clones the nodes it needs to change, so the committed tree stays
+    // intact.
+    auto rootShadowNode = std::make_shared<RootShadowNode>(
+        *revision.rootShadowNode, ShadowNodeFragment{});
+
+    std::vector<LayoutableShadowNode const *> affectedLayoutableNodes{};
+    affectedLayoutableNodes.reserve(1024);
+
+    revision.telemetry.willLayout();
+    revision.telemetry.setAsThreadLocal();
+    rootShadowNode->layoutIfNeeded(&affectedLayoutableNodes);
+    revision.telemetry.unsetAsThreadLocal();
+    revision.telemetry.didLayout();
+
+    rootShadowNode->sealRecursive();
+    revision.rootShadowNode = rootShadowNode;
+
+    {
+      std::unique_lock<better::shared_mutex> lock(commitMutex_);
+
+      if (revision.number <= lastMountedRevisionNumber_) {
+        // A newer tree was laid out synchronously and mounted already.
+        continue;
+      }
+
+      auto isCurrent = currentRevision_.number == revision.number;
+      if (!isCurrent &&
+          ++supersededLayoutCount < kMaxSupersededBackgroundLayoutCount) {
+        // The newer commit requested another layout.
+        continue;
+      }
+      supersededLayoutCount = 0;
+      lastMountedRevisionNumber_ = revision.number;
+
+      if (isCurrent) {
+        currentRevision_ = revision;
+
+        std::lock_guard<std::mutex> backgroundLayoutLock(
+            backgroundLayoutMutex_);
+        laidOutRevision_ = revision;
+        isCurrentRevisionLaidOut_ = true;
+      }
+    }
+
+    backgroundLayoutFinishedSignal_.notify_all();
+
+    std::lock_guard<std::mutex> mountingLock(backgroundLayoutMountingMutex_);
+    {
+      std::lock_guard<std::mutex> lock(backgroundLayoutMutex_);
+      if (isBackgroundLayoutStopped_) {
+        return;
+      }
+    }
+
+    emitLayoutEvents(affectedLayoutableNodes);
+
+    mountingCoordinator_->push(revision);
+
+    notifyDelegatesOfUpdates();
+  }
+}
+
 void ShadowTree::notifyDelegatesOfUpdates() const {
   delegate_.shadowTreeDidFinishTransaction(*this, mountingCoordinator_);
 }
@@ -8,7 +8,9 @@
 #pragma once
 
 #include <better/mutex.h>
+#include <condition_variable>
 #include <memory>
+#include <thread>
 
 #include <react/renderer/components/root/RootComponentDescriptor.h>
 #include <react/renderer/components/root/RootShadowNode.h>
@@ -54,7 +56,8 @@ class ShadowTree final {
       RootComponentDescriptor const &rootComponentDescriptor,
       ShadowTreeDelegate const &delegate,
       std::weak_ptr<MountingOverrideDelegate const> mountingOverrideDelegate,
-      bool enableReparentingDetection = false);
+      bool enableReparentingDetection = false,
+      bool enableBackgroundLayout = false);
 
   ~ShadowTree();
 
@@ -67,6 +70,9 @@ class ShadowTree final {
    * Performs commit calling `transaction` function with a `oldRootShadowNode`
    * and expecting a `newRootShadowNode` as a return value.
    * The `transaction` function can cancel commit returning `nullptr`.
+   * If background layout is enabled, the new tree is committed without being
+   * laid out and the layout thread lays out the most recent committed tree
+   * and mounts it.
    */
   CommitStatus tryCommit(
       ShadowTreeCommitTransaction transaction,
@@ -81,12 +87,25 @@ class ShadowTree final {
 
   /*
    * Returns a `ShadowTreeRevision` representing the momentary state of
-   * the `ShadowTree`.
+   * the `ShadowTree`. Never waits; if background layout is enabled, the
+   * returned tree might not be laid out yet.
    */
   ShadowTreeRevision getCurrentRevision() const;
 
+  /*
+   * Same as `getCurrentRevision`, but if background layout is enabled, waits
+   * until the layout thread laid out the most recent committed tree, so the
+   * layout metrics of the returned tree can be measured.
+   * Meant only for measuring a tree right after committing it (the methods of
+   * `UIManager` measuring nodes for JavaScript, which run on the JavaScript
+   * thread). Other threads, and the UI thread in particular, must not wait
+   * for the layout; they use `getCurrentRevision`.
+   */
+  ShadowTreeRevision getCurrentLaidOutRevision() const;
+
   /*
    * Commit an empty tree (a new `RootShadowNode` with no children).
+   * The tree is always laid out and mounted synchronously.
    */
   void commitEmptyTree() const;
 
@@ -108,15 +127,64 @@ class ShadowTree final {
   }
 
  private:
+  CommitStatus commit(
+      ShadowTreeCommitTransaction const &transaction,
+      CommitOptions const &commitOptions,
+      bool deferLayout) const;
+
+  CommitStatus tryCommit(
+      ShadowTreeCommitTransaction const &transaction,
+      CommitOptions const &commitOptions,
+      bool deferLayout) const;
+
   void emitLayoutEvents(
       std::vector<LayoutableShadowNode const *> &affectedLayoutableNodes) const;
 
+  /*
+   * Body of the layout thread: lays out a clone of the current revision each
+   * time a layout is requested, replaces the revision with it (keeping its
+   * number, so commits based on the original tree still succeed) and mounts
+   * it. The transaction of the commit is not run again.
+   * If the revision is superseded by a newer commit in the meantime, the
+   * newer tree is laid out instead; after
+   * `kMaxSupersededBackgroundLayoutCount` superseded layouts in a row, the
+   * laid out tree is mounted anyway, so the screen is updated even if trees
+   * are committed faster than they are laid out.
+   */
+  void runBackgroundLayout() const;
+
+  static int const kMaxSupersededBackgroundLayoutCount = 3;
+
   SurfaceId const surfaceId_;
   ShadowTreeDelegate const &delegate_;
   mutable better::shared_mutex commitMutex_;
   mutable ShadowTreeRevision currentRevision_; // Protected by `commitMutex_`.
   MountingCoordinator::Shared mountingCoordinator_;
   bool enableReparentingDetection_{false};
+
+  // The number of the most recent revision pushed to `mountingCoordinator_`
+  // (or about to be), so the layout thread never mounts an older tree.
+  mutable ShadowTreeRevision::Number
+      lastMountedRevisionNumber_{}; // Protected by `commitMutex_`.
+
+  bool const enableBackgroundLayout_;
+  mutable std::mutex backgroundLayoutMutex_;
+  mutable std::condition_variable backgroundLayoutSignal_;
+  mutable std::condition_variable backgroundLayoutFinishedSignal_;
+  mutable bool isBackgroundLayoutRequested_{false}; // Protected by
+                                                    // `backgroundLayoutMutex_`.
+  // A copy of `currentRevision_` which is valid if `isCurrentRevisionLaidOut_`.
+  mutable ShadowTreeRevision laidOutRevision_; // Protected by
+                                               // `backgroundLayoutMutex_`.
+  mutable bool isCurrentRevisionLaidOut_{true}; // Protected by
+                                                // `backgroundLayoutMutex_`.
+  bool isBackgroundLayoutStopped_{false}; // Protected by
+                                          // `backgroundLayoutMutex_`.
+  // Held by the layout thread while it mounts a tree and by the destructor
+  // while it stops the thread, so the delegate is not called once the
+  // destruction began.
+  mutable std::mutex backgroundLayoutMountingMutex_;
+  std::thread backgroundLayoutThread_;
 };
 
 } // namespace react
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/components/root/RootComponentDescriptor.h>
+#include <react/renderer/components/view/ViewComponentDescriptor.h>
+#include <react/renderer/element/ComponentBuilder.h>
+#include <react/renderer/element/Element.h>
+#include <react/renderer/element/testUtils.h>
+
+#include <react/renderer/mounting/MountingCoordinator.h>
+#include <react/renderer/mounting/ShadowTree.h>
+#include <react/renderer/mounting/ShadowTreeDelegate.h>
+
+using namespace facebook::react;
+
+class BackgroundLayoutShadowTreeDelegate : public ShadowTreeDelegate {
+ public:
+  virtual void shadowTreeDidFinishTransaction(
+      ShadowTree const &shadowTree,
+      MountingCoordinator::Shared const &mountingCoordinator) const override{};
+};
+
+static std::shared_ptr<RootShadowNode> buildTree(
+    ComponentBuilder &builder,
+    Float childWidth,
+    std::shared_ptr<ViewShadowNode> &childShadowNode) {
+  // clang-format off
+  auto element =
+      Element<RootShadowNode>()
+        .tag(1)
+        .props([] {
+          auto sharedProps = std::make_shared<RootProps>();
+          auto &props = *sharedProps;
+          props.layoutConstraints = LayoutConstraints{{0,0}, {500, 500}};
+          auto &yogaStyle = props.yogaStyle;
+          yogaStyle.dimensions()[YGDimensionWidth] = YGValue{200, YGUnitPoint};
+          yogaStyle.dimensions()[YGDimensionHeight] = YGValue{200, YGUnitPoint};
+          return sharedProps;
+        })
+        .children({
+          Element<ViewShadowNode>()
+            .tag(2)
+            .reference(childShadowNode)
+            .props([=] {
+              auto sharedProps = std::make_shared<ViewProps>();
+              auto &yogaStyle = sharedProps->yogaStyle;
+              yogaStyle.dimensions()[YGDimensionWidth] = YGValue{childWidth, YGUnitPoint};
+              yogaStyle.dimensions()[YGDimensionHeight] = YGValue{50, YGUnitPoint};
+              return sharedProps;
+            })
+        });
+  // clang-format on
+
+  return builder.build(element);
+}
+
+static LayoutMetrics childLayoutMetrics(ShadowTree const &shadowTree) {
+  auto rootShadowNode = shadowTree.getCurrentLaidOutRevision().rootShadowNode;
+  auto const &childShadowNode = rootShadowNode->getChildren().at(0);
+  return traitCast<LayoutableShadowNode const *>(childShadowNode.get())
+      ->getLayoutMetrics();
+}
+
+TEST(ShadowTreeBackgroundLayoutTest, testLayoutIsDoneOnClone) {
+  auto builder = simpleComponentBuilder();
+  auto childShadowNode = std::shared_ptr<ViewShadowNode>{};
+  auto rootShadowNode = buildTree(builder, 100, childShadowNode);
+
+  auto shadowTreeDelegate = BackgroundLayoutShadowTreeDelegate{};
+  auto eventDispatcher = EventDispatcher::Shared{};
+  auto rootComponentDescriptor = RootComponentDescriptor{
+      ComponentDescriptorParameters{eventDispatcher, nullptr, nullptr}};
+  ShadowTree shadowTree{SurfaceId{11},
+                        LayoutConstraints{},
+                        LayoutContext{},
+                        rootComponentDescriptor,
+                        shadowTreeDelegate,
+                        {},
+                        false,
+                        true};
+
+  auto status = shadowTree.commit(
+      [&](RootShadowNode const &oldRootShadowNode) { return rootShadowNode; });
+  EXPECT_EQ(status, ShadowTree::CommitStatus::Succeeded);
+
+  auto mountingCoordinator = shadowTree.getMountingCoordinator();
+  EXPECT_TRUE(mountingCoordinator->waitForTransaction(std::chrono::seconds(5)));
+  EXPECT_TRUE(mountingCoordinator->pullTransaction().has_value());
+
+  EXPECT_EQ(childLayoutMetrics(shadowTree).frame.size, (Size{100, 50}));
+
+  // The committed tree itself is left intact; the layout thread lays out
+  // clones of its nodes.
+  EXPECT_EQ(childShadowNode->getLayoutMetrics(), EmptyLayoutMetrics);
+}
+
+TEST(ShadowTreeBackgroundLayoutTest, testNewerTreeSupersedesOlderOne) {
+  auto builder = simpleComponentBuilder();
+  auto childShadowNode = std::shared_ptr<ViewShadowNode>{};
+
+  auto shadowTreeDelegate = BackgroundLayoutShadowTreeDelegate{};
+  auto eventDispatcher = EventDispatcher::Shared{};
+  auto rootComponentDescriptor = RootComponentDescriptor{
+      ComponentDescriptorParameters{eventDispatcher, nullptr, nullptr}};
+  ShadowTree shadowTree{SurfaceId{11},
+                        LayoutConstraints{},
+                        LayoutContext{},
+                        rootComponentDescriptor,
+                        shadowTreeDelegate,
+                        {},
+                        false,
+                        true};
+
+  for (auto width : {50, 75, 100}) {
+    auto rootShadowNode = buildTree(builder, width, childShadowNode);
+    shadowTree.commit([&](RootShadowNode const &oldRootShadowNode) {
+      return rootShadowNode;
+    });
+  }
+
+  // Whichever trees were skipped, the current revision is the most recent
+  // one, laid out.
+  EXPECT_EQ(childLayoutMetrics(shadowTree).frame.size, (Size{100, 50}));
+}
+
+TEST(ShadowTreeBackgroundLayoutTest, testLaidOutRevisionWaitsForLayout) {
+  auto builder = simpleComponentBuilder();
+  auto childShadowNode = std::shared_ptr<ViewShadowNode>{};
+
+  auto shadowTreeDelegate = BackgroundLayoutShadowTreeDelegate{};
+  auto eventDispatcher = EventDispatcher::Shared{};
+  auto rootComponentDescriptor = RootComponentDescriptor{
+      ComponentDescriptorParameters{eventDispatcher, nullptr, nullptr}};
+  ShadowTree shadowTree{SurfaceId{11},
+                        LayoutConstraints{},
+                        LayoutContext{},
+                        rootComponentDescriptor,
+                        shadowTreeDelegate,
+                        {},
+                        false,
+                        true};
+
+  for (auto width : {50, 75}) {
+    auto rootShadowNode = buildTree(builder, width, childShadowNode);
+    shadowTree.commit([&](RootShadowNode const &oldRootShadowNode) {
+      return rootShadowNode;
+    });
+
+    // Reading the laid out revision right after the commit (e.g. to measure
+    // a node) waits for the layout thread instead of returning a tree with
+    // empty layout metrics.
+    auto revision = shadowTree.getCurrentLaidOutRevision();
+    EXPECT_EQ(revision.number, shadowTree.getCurrentRevision().number);
+    auto const &child = revision.rootShadowNode->getChildren().at(0);
+    EXPECT_EQ(
+        traitCast<LayoutableShadowNode const *>(child.get())
+            ->getLayoutMetrics()
+            .frame.size,
+        (Size{Float(width), 50}));
+  }
+}
+
+TEST(ShadowTreeBackgroundLayoutTest, testTreesAreMountedWhileCommitsContinue) {
+  auto builder = simpleComponentBuilder();
+  auto childShadowNode = std::shared_ptr<ViewShadowNode>{};
+
+  auto shadowTreeDelegate = BackgroundLayoutShadowTreeDelegate{};
+  auto eventDispatcher = EventDispatcher::Shared{};
+  auto rootComponentDescriptor = RootComponentDescriptor{
+      ComponentDescriptorParameters{eventDispatcher, nullptr, nullptr}};
+  ShadowTree shadowTree{SurfaceId{11},
+                        LayoutConstraints{},
+                        LayoutContext{},
+                        rootComponentDescriptor,
+                        shadowTreeDelegate,
+                        {},
+                        false,
+                        true};
+
+  auto rootShadowNodes = std::vector<std::shared_ptr<RootShadowNode>>{};
+  for (auto width : {50, 75}) {
+    rootShadowNodes.push_back(buildTree(builder, width, childShadowNode));
+  }
+
+  // Even if every layout is superseded by a newer commit, some trees are
+  // mounted.
+  auto isCommitting = std::atomic<bool>{true};
+  auto committingThread = std::thread([&] {
+    for (size_t i = 0; isCommitting; i++) {
+      shadowTree.commit([&](RootShadowNode const &oldRootShadowNode) {
+        return rootShadowNodes[i % rootShadowNodes.size()];
+      });
+    }
+  });
+
+  auto mountingCoordinator = shadowTree.getMountingCoordinator();
+  EXPECT_TRUE(mountingCoordinator->waitForTransaction(std::chrono::seconds(5)));
+  EXPECT_TRUE(mountingCoordinator->pullTransaction().has_value());
+
+  isCommitting = false;
+  committingThread.join();
+}
+
+TEST(ShadowTreeBackgroundLayoutTest, testEmptyTreeIsMountedSynchronously) {
+  auto builder = simpleComponentBuilder();
+  auto childShadowNode = std::shared_ptr<ViewShadowNode>{};
+  auto rootShadowNode = buildTree(builder, 100, childShadowNode);
+
+  auto shadowTreeDelegate = BackgroundLayoutShadowTreeDelegate{};
+  auto eventDispatcher = EventDispatcher::Shared{};
+  auto rootComponentDescriptor = RootComponentDescriptor{
+      ComponentDescriptorParameters{eventDispatcher, nullptr, nullptr}};
+  auto shadowTree = std::make_unique<ShadowTree>(
+      SurfaceId{11},
+      LayoutConstraints{},
+      LayoutContext{},
+      rootComponentDescriptor,
+      shadowTreeDelegate,
+      std::weak_ptr<MountingOverrideDelegate const>{},
+      false,
+      true);
+
+  shadowTree->commit(
+      [&](RootShadowNode const &oldRootShadowNode) { return rootShadowNode; });
+  auto mountingCoordinator = shadowTree->getMountingCoordinator();
+  EXPECT_TRUE(mountingCoordinator->waitForTransaction(std::chrono::seconds(5)));
+  EXPECT_TRUE(mountingCoordinator->pullTransaction().has_value());
+
+  // The empty tree committed when a surface stops is mounted before the
+  // commit returns, so it is not lost when the shadow tree is destroyed
+  // right after.
+  shadowTree->commitEmptyTree();
+  auto transaction = mountingCoordinator->pullTransaction();
+  shadowTree.reset();
+
+  EXPECT_TRUE(transaction.has_value());
+  EXPECT_FALSE(transaction->getMutations().empty());
+}
@@ -11,6 +11,7 @@
 #include <jsi/jsi.h>
 
 #include <react/renderer/componentregistry/ComponentDescriptorRegistry.h>
+#include <react/renderer/components/view/YogaLayoutableShadowNode.h>
 #include <react/renderer/core/LayoutContext.h>
 #include <react/renderer/debug/SystraceSection.h>
 #include <react/renderer/mounting/MountingOverrideDelegate.h>
@@ -49,10 +50,9 @@ Scheduler::Scheduler(
                        jsi::Runtime &runtime,
                        const EventTarget *eventTarget,
                        const std::string &type,
-                       const ValueFactory &payloadFactory) {
+                       const EventPayload &payload) {
     uiManager->visitBinding([&](UIManagerBinding const &uiManagerBinding) {
-      uiManagerBinding.dispatchEvent(
-          runtime, eventTarget, type, payloadFactory);
+      uiManagerBinding.dispatchEvent(runtime, eventTarget, type, payload);
     });
   };
 
@@ -73,6 +73,31 @@ Scheduler::Scheduler(
   auto eventDispatcher =
       EventDispatcher::Shared{eventDispatcher_, &eventDispatcher_->value()};
 
+#ifdef ANDROID
+  enableBackgroundLayout_ = reactNativeConfig_->getBool(
+      "react_fabric:enable_background_layout_android");
+  auto enableTextMeasurePrefetch = reactNativeConfig_->getBool(
+      "react_fabric:enable_text_measure_prefetch_android");
+#else
+  enableBackgroundLayout_ = reactNativeConfig_->getBool(
+      "react_fabric:enable_background_layout_ios");
+  auto enableTextMeasurePrefetch = reactNativeConfig_->getBool(
+      "react_fabric:enable_text_measure_prefetch_ios");
+#endif
+
+  // `ParagraphComponentDescriptor` measures text of committed trees ahead of
+  // background layout with this executor if it's available. Text is
+  // prefetched only while a commit waits for background layout (see
+  // `ShadowTree::tryCommit`); a synchronous commit lays out right away, so
+  // `enable_text_measure_prefetch_*` requires `enable_background_layout_*`.
+  auto textMeasurePrefetchExecutorKey = "TextMeasurePrefetchExecutor";
+  schedulerToolbox.contextContainer->erase(textMeasurePrefetchExecutorKey);
+  if (enableTextMeasurePrefetch && enableBackgroundLayout_ &&
+      schedulerToolbox.backgroundExecutor) {
+    schedulerToolbox.contextContainer->insert(
+        textMeasurePrefetchExecutorKey, schedulerToolbox.backgroundExecutor);
+  }
+
   componentDescriptorRegistry_ = schedulerToolbox.componentRegistryFactory(
       eventDispatcher, schedulerToolbox.contextContainer);
 
@@ -122,6 +147,13 @@ Scheduler::Scheduler(
       reactNativeConfig_->getBool(
           "react_fabric:enable_state_update_with_autorepeat_ios");
 #endif
+
+  // The profiler is process-wide; a scheduler only turns it on, so that
+  // instances created without the flag do not stop a running profile. It
+  // receives events only if Yoga is built with `YG_ENABLE_EVENTS`.
+  if (reactNativeConfig_->getBool("react_fabric:enable_yoga_layout_profiler")) {
+    YogaLayoutableShadowNode::setLayoutProfilerEnabled(true);
+  }
 }
 
 Scheduler::~Scheduler() {
@@ -192,7 +224,8 @@ void Scheduler::startSurface(
       *rootComponentDescriptor_,
       *uiManager_,
       mountingOverrideDelegate,
-      enableReparentingDetection_);
+      enableReparentingDetection_,
+      enableBackgroundLayout_);
 
   auto uiManager = uiManager_;
 
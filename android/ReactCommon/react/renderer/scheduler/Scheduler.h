@@ -138,6 +138,7 @@ class Scheduler final : public UIManagerDelegate {
    * Temporary flags.
    */
   bool enableReparentingDetection_{false};
+  bool enableBackgroundLayout_{false};
   bool removeOutstandingSurfacesOnDestruction_{false};
 };
 
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "PersistentTextMeasureCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace facebook {
+namespace react {
+
+namespace {
+
+// "RNTM" in the byte order of the device which wrote the file.
+constexpr uint32_t kMagic = 0x4D544E52;
+constexpr uint32_t kVersion = 2;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t fontFingerprint;
+  uint64_t entryCount;
+  uint64_t checksum;
+};
+
+// 64-bit FNV-1a.
+uint64_t checksum(void const *data, size_t size) {
+  auto bytes = static_cast<uint8_t const *>(data);
+  auto hash = uint64_t{0xcbf29ce484222325};
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * uint64_t{0x100000001b3};
+  }
+  return hash;
+}
+
+/*
+ * Hashes the fields of a key fed to it as fixed-width values, so the result
+ * doesn't depend on the process or on the width of `size_t`.
+ * Computes two independent hashes of the same bytes: 64-bit FNV-1a, and a
+ * multiply-rotate hash (with the constants of MurmurHash3) as the check.
+ */
+class StableKeyHasher final {
+ public:
+  void add(void const *data, size_t size) {
+    auto bytes = static_cast<uint8_t const *>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * uint64_t{0x100000001b3};
+
+      auto mixed = (check_ ^ bytes[i]) * uint64_t{0x87c37b91114253d5};
+      check_ = ((mixed << 31) | (mixed >> 33)) * uint64_t{0x4cf5ad432745937f};
+    }
+  }
+
+  void add(int64_t value) {
+    add(&value, sizeof(value));
+  }
+
+  void add(double value) {
+    // Values which compare as equal must hash equally.
+    if (std::isnan(value)) {
+      value = std::numeric_limits<double>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    add(&value, sizeof(value));
+  }
+
+  void add(std::string const &string) {
+    add(static_cast<int64_t>(string.size()));
+    add(string.data(), string.size());
+  }
+
+  template <typename T>
+  void add(better::optional<T> const &value) {
+    add(static_cast<int64_t>(value.has_value()));
+    if (value.has_value()) {
+      add(static_cast<int64_t>(*value));
+    }
+  }
+
+  uint64_t getHash() const {
+    return hash_;
+  }
+
+  uint64_t getCheck() const {
+    return check_;
+  }
+
+ private:
+  uint64_t hash_{0xcbf29ce484222325};
+  uint64_t check_{0x9e3779b97f4a7c15};
+};
+
+struct SharedCache {
+  std::mutex mutex;
+  std::shared_ptr<PersistentTextMeasureCache> cache;
+};
+
+SharedCache &getSharedCache() {
+  // Never deallocated, so it can be used during static destruction.
+  static auto &sharedCache = *new SharedCache();
+  return sharedCache;
+}
+
+bool writeAll(int fd, void const *data, size_t size) {
+  auto bytes = static_cast<char const *>(data);
+  while (size > 0) {
+    auto written = ::write(fd, bytes, size);
+    if (written < 0) {
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+} // namespace
+
+constexpr size_t PersistentTextMeasureCache::kDefaultSizeBudget;
+
+std::shared_ptr<PersistentTextMeasureCache> PersistentTextMeasureCache::shared(
+    ContextContainer::Shared const &contextContainer) {
+  if (!contextContainer) {
+    return nullptr;
+  }
+
+  auto path = contextContainer->find<std::string>("TextMeasureCachePath");
+  if (!path || path->empty()) {
+    return nullptr;
+  }
+
+  auto fontFingerprint = static_cast<uint64_t>(
+      contextContainer->find<int64_t>("TextMeasureCacheFontFingerprint")
+          .value_or(0));
+  auto sizeBudget =
+      contextContainer->find<size_t>("TextMeasureCacheSizeBudget")
+          .value_or(kDefaultSizeBudget);
+
+  auto &sharedCache = getSharedCache();
+  std::lock_guard<std::mutex> lock(sharedCache.mutex);
+
+  auto const &cache = sharedCache.cache;
+  if (cache && cache->path_ == *path &&
+      cache->fontFingerprint_ == fontFingerprint &&
+      cache->sizeBudget_ == sizeBudget) {
+    return cache;
+  }
+
+  auto newCache = std::make_shared<PersistentTextMeasureCache>(
+      *path, fontFingerprint, sizeBudget);
+  newCache->load();
+  sharedCache.cache = newCache;
+  return newCache;
+}
+
+bool PersistentTextMeasureCache::saveShared() {
+  auto &sharedCache = getSharedCache();
+  auto cache = std::shared_ptr<PersistentTextMeasureCache>{};
+  {
+    std::lock_guard<std::mutex> lock(sharedCache.mutex);
+    cache = sharedCache.cache;
+  }
+  return cache && cache->save();
+}
+
+PersistentTextMeasureCache::PersistentTextMeasureCache(
+    std::string path,
+    uint64_t fontFingerprint,
+    size_t sizeBudget)
+    : path_(std::move(path)),
+      fontFingerprint_(fontFingerprint),
+      sizeBudget_(sizeBudget),
+      maximumEntryCount_(
+          sizeBudget > sizeof(Header)
+              ? (sizeBudget - sizeof(Header)) / sizeof(Entry)
+              : size_t{0}) {}
+
+PersistentTextMeasureCache::~PersistentTextMeasureCache() {
+  unmap();
+}
+
+bool PersistentTextMeasureCache::load() {
+  unmap();
+
+  auto fd = ::open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat fileStat;
+  if (::fstat(fd, &fileStat) != 0 ||
+      static_cast<size_t>(fileStat.st_size) < sizeof(Header)) {
+    ::close(fd);
+    return false;
+  }
+
+  auto size = static_cast<size_t>(fileStat.st_size);
+  auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  mappedData_ = data;
+  mappedSize_ = size;
+
+  auto header = Header{};
+  std::memcpy(&header, data, sizeof(Header));
+  auto entries = reinterpret_cast<Entry const *>(
+      static_cast<char const *>(data) + sizeof(Header));
+  auto entriesSize = size - sizeof(Header);
+
+  if (header.magic != kMagic || header.version != kVersion ||
+      header.fontFingerprint != fontFingerprint_ ||
+      entriesSize % sizeof(Entry) != 0 ||
+      header.entryCount != entriesSize / sizeof(Entry) ||
+      checksum(entries, entriesSize) != header.checksum) {
+    unmap();
+    return false;
+  }
+
+  for (size_t i = 1; i < header.entryCount; i++) {
+    if (entries[i - 1].key >= entries[i].key) {
+      unmap();
+      return false;
+    }
+  }
+
+  loadedEntries_ = entries;
+  loadedEntryCount_ = header.entryCount;
+  return true;
+}
+
+better::optional<Size> PersistentTextMeasureCache::get(
+    TextMeasureCacheKey const &key) const {
+  if (!isStorable(key)) {
+    return {};
+  }
+
+  auto hash = hashKey(key);
+
+  auto entry = findLoadedEntry(hash.key);
+  if (entry == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iterator = recordedEntries_.find(hash.key);
+    if (iterator == recordedEntries_.end() ||
+        iterator->second.check != hash.check) {
+      return {};
+    }
+    return Size{iterator->second.width, iterator->second.height};
+  }
+
+  if (entry->check != hash.check) {
+    return {};
+  }
+
+  return Size{entry->width, entry->height};
+}
+
+void PersistentTextMeasureCache::record(
+    TextMeasureCacheKey const &key,
+    TextMeasurement const &measurement) const {
+  if (!isStorable(key) || !measurement.attachments.empty()) {
+    return;
+  }
+
+  auto hash = hashKey(key);
+  auto entry = Entry{hash.key,
+                     hash.check,
+                     static_cast<float>(measurement.size.width),
+                     static_cast<float>(measurement.size.height)};
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iterator = recordedEntries_.find(entry.key);
+  if (iterator != recordedEntries_.end()) {
+    iterator->second = entry;
+    return;
+  }
+
+  // More measurements than this would not be written anyway.
+  if (recordedEntries_.size() >= maximumEntryCount_) {
+    return;
+  }
+
+  recordedEntries_.emplace(entry.key, entry);
+}
+
+bool PersistentTextMeasureCache::save() const {
+  auto entries = std::vector<Entry>{};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries.reserve(std::min(
+        maximumEntryCount_, recordedEntries_.size() + loadedEntryCount_));
+    for (auto const &pair : recordedEntries_) {
+      if (entries.size() == maximumEntryCount_) {
+        break;
+      }
+      entries.push_back(pair.second);
+    }
+    for (size_t i = 0; i < loadedEntryCount_; i++) {
+      if (entries.size() == maximumEntryCount_) {
+        break;
+      }
+      if (recordedEntries_.find(loadedEntries_[i].key) ==
+          recordedEntries_.end()) {
+        entries.push_back(loadedEntries_[i]);
+      }
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(), [](Entry const &a, Entry const &b) {
+    return a.key < b.key;
+  });
+
+  auto header = Header{};
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.fontFingerprint = fontFingerprint_;
+  header.entryCount = entries.size();
+  header.checksum = checksum(entries.data(), entries.size() * sizeof(Entry));
+
+  // Every save writes its own file, so concurrent saves (e.g. by instances in
+  // other processes) never write into the same file.
+  auto temporaryPath = path_ + ".XXXXXX";
+  auto fd = ::mkstemp(&temporaryPath[0]);
+  if (fd < 0) {
+    return false;
+  }
+
+  auto isWritten = writeAll(fd, &header, sizeof(Header)) &&
+      writeAll(fd, entries.data(), entries.size() * sizeof(Entry));
+  isWritten = ::close(fd) == 0 && isWritten;
+
+  if (!isWritten || std::rename(temporaryPath.c_str(), path_.c_str()) != 0) {
+    std::remove(temporaryPath.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+PersistentTextMeasureCache::KeyHash PersistentTextMeasureCache::hashKey(
+    TextMeasureCacheKey const &key) {
+  // Taking into account the same fields as `operator==` of
+  // `TextMeasureCacheKey` does. The layout-wise hash of a sealed string is
+  // computed only once.
+  auto hasher = StableKeyHasher{};
+
+  hasher.add(
+      static_cast<int64_t>(key.attributedString.getLayoutWiseHash()));
+
+  auto const &paragraphAttributes = key.paragraphAttributes;
+  hasher.add(static_cast<int64_t>(paragraphAttributes.maximumNumberOfLines));
+  hasher.add(static_cast<int64_t>(paragraphAttributes.ellipsizeMode));
+  hasher.add(static_cast<int64_t>(paragraphAttributes.textBreakStrategy));
+  hasher.add(static_cast<int64_t>(paragraphAttributes.adjustsFontSizeToFit));
+  hasher.add(static_cast<int64_t>(paragraphAttributes.includeFontPadding));
+  hasher.add(static_cast<double>(paragraphAttributes.minimumFontSize));
+  hasher.add(static_cast<double>(paragraphAttributes.maximumFontSize));
+
+  hasher.add(static_cast<double>(key.layoutConstraints.maximumSize.width));
+
+  return KeyHash{hasher.getHash(), hasher.getCheck()};
+}
+
+bool PersistentTextMeasureCache::isStorable(TextMeasureCacheKey const &key) {
+  // Measurements of attachments depend on their layout metrics which the hash
+  // of the key doesn't include.
+  for (auto const &fragment : key.attributedString.getFragments()) {
+    if (fragment.isAttachment()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+PersistentTextMeasureCache::Entry const *
+PersistentTextMeasureCache::findLoadedEntry(uint64_t key) const {
+  auto end = loadedEntries_ + loadedEntryCount_;
+  auto iterator = std::lower_bound(
+      loadedEntries_, end, key, [](Entry const &entry, uint64_t key) {
+        return entry.key < key;
+      });
+  if (iterator == end || iterator->key != key) {
+    return nullptr;
+  }
+  return iterator;
+}
+
+void PersistentTextMeasureCache::unmap() {
+  if (mappedData_) {
+    ::munmap(mappedData_, mappedSize_);
+  }
+  mappedData_ = nullptr;
+  mappedSize_ = 0;
+  loadedEntries_ = nullptr;
+  loadedEntryCount_ = 0;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <better/optional.h>
+#include <react/renderer/textlayoutmanager/TextMeasureCache.h>
+#include <react/utils/ContextContainer.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Text measurements stored in a file, so the next start of the app doesn't
+ * need to measure the same strings again.
+ * Measurements are keyed by a 64-bit hash of the layout-wise fields of
+ * `TextMeasureCacheKey` and checked with a second, independent hash of them.
+ * The attributed string enters both through its layout-wise hash, which a
+ * sealed string stores (see `AttributedString::getLayoutWiseHash()`); that
+ * hash is the same in every process running the same build of the app (but
+ * has only 32 bits on 32-bit devices).
+ * Measurements are valid only for the font configuration with which they
+ * were measured, identified by a fingerprint provided by the app. The
+ * fingerprint must change whenever anything affecting text measurement does
+ * (fonts, font scale, locale, the version of the app).
+ * Measurements with attachments are not stored.
+ *
+ * The file is an array of entries sorted by key which is memory-mapped and
+ * searched in place, so loading it is cheap and doesn't depend on its size.
+ * Can be used from any thread.
+ */
+class PersistentTextMeasureCache final {
+ public:
+  /*
+   * Returns the cache of the process for the configuration found in a given
+   * `ContextContainer` (loading the file the first time), or `nullptr` if the
+   * file isn't configured. All `TextLayoutManager`s share the instance, so
+   * the file is mapped once and written by one instance only; a different
+   * configuration (e.g. a new font fingerprint) replaces the shared instance.
+   * Configuration is read from these keys:
+   * - "TextMeasureCachePath" (`std::string`), the path of the file;
+   * - "TextMeasureCacheFontFingerprint" (`int64_t`);
+   * - "TextMeasureCacheSizeBudget" (`size_t`), the maximum size of the file
+   *   in bytes (`kDefaultSizeBudget` by default).
+   */
+  static std::shared_ptr<PersistentTextMeasureCache> shared(
+      ContextContainer::Shared const &contextContainer);
+
+  /*
+   * Writes the shared cache (see `shared()`) to its file, if there is one.
+   * Meant to be called by the platform when the app goes to background.
+   * Returns `true` if the file was written.
+   */
+  static bool saveShared();
+
+  static constexpr size_t kDefaultSizeBudget = 256 * 1024;
+
+  PersistentTextMeasureCache(
+      std::string path,
+      uint64_t fontFingerprint,
+      size_t sizeBudget);
+  ~PersistentTextMeasureCache();
+
+  PersistentTextMeasureCache(PersistentTextMeasureCache const &) = delete;
+  PersistentTextMeasureCache &operator=(PersistentTextMeasureCache const &) =
+      delete;
+
+  /*
+   * Maps the file into memory. Files which are damaged, have a different
+   * format version, or were written for a different font fingerprint are
+   * ignored. Returns `true` if the file was loaded.
+   * Must be called before the cache is shared with other threads.
+   */
+  bool load();
+
+  /*
+   * Returns the stored size for `key`, either loaded from the file or
+   * recorded since then.
+   */
+  better::optional<Size> get(TextMeasureCacheKey const &key) const;
+
+  /*
+   * Records a measurement to be stored in the file with the next `save()`.
+   * Recorded measurements are capped at what fits into the size budget;
+   * measurements beyond that are dropped.
+   */
+  void record(
+      TextMeasureCacheKey const &key,
+      TextMeasurement const &measurement) const;
+
+  /*
+   * Writes the recorded measurements and as many of the loaded ones as the
+   * size budget allows (recorded measurements go first) to the file.
+   * The file is replaced atomically (through a temporary file of its own, so
+   * concurrent saves don't interfere). Returns `true` if the file was
+   * written.
+   */
+  bool save() const;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    uint64_t check;
+    float width;
+    float height;
+  };
+
+  struct KeyHash {
+    uint64_t key;
+    uint64_t check;
+  };
+
+  static KeyHash hashKey(TextMeasureCacheKey const &key);
+  static bool isStorable(TextMeasureCacheKey const &key);
+
+  Entry const *findLoadedEntry(uint64_t key) const;
+  void unmap();
+
+  std::string const path_;
+  uint64_t const fontFingerprint_;
+  size_t const sizeBudget_;
+  // The number of entries which fit into `sizeBudget_`.
+  size_t const maximumEntryCount_;
+
+  // The mapped file; immutable once loaded.
+  void *mappedData_{nullptr};
+  size_t mappedSize_{0};
+  Entry const *loadedEntries_{nullptr};
+  size_t loadedEntryCount_{0};
+
+  mutable std::mutex mutex_;
+  // Protected by `mutex_`.
+  mutable std::unordered_map<uint64_t, Entry> recordedEntries_;
+};
+
+/*
+ * Returns the measurement for `key` stored in `persistentMeasureCache` or
+ * measures it using `measure` and records the result.
+ * `persistentMeasureCache` can be `nullptr`.
+ */
+template <typename MeasureT>
+TextMeasurement measureWithPersistentCache(
+    PersistentTextMeasureCache const *persistentMeasureCache,
+    TextMeasureCacheKey const &key,
+    MeasureT &&measure) {
+  if (!persistentMeasureCache) {
+    return measure();
+  }
+
+  auto size = persistentMeasureCache->get(key);
+  if (size) {
+    return TextMeasurement{*size, {}};
+  }
+
+  auto measurement = measure();
+  persistentMeasureCache->record(key, measurement);
+  return measurement;
+}
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+#include <react/renderer/attributedstring/AttributedString.h>
+#include <react/renderer/attributedstring/ParagraphAttributes.h>
+#include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
+#include <react/renderer/textlayoutmanager/TextMeasureCache.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Arguments of a single measurement in `TextLayoutManager::measureBatch`.
+ */
+class TextMeasureRequest final {
+ public:
+  AttributedString attributedString{};
+  ParagraphAttributes paragraphAttributes{};
+  LayoutConstraints layoutConstraints{};
+};
+
+/*
+ * Arguments of a single measurement in
+ * `TextLayoutManager::measureLinesBatch`.
+ */
+class LinesMeasureRequest final {
+ public:
+  AttributedString attributedString{};
+  ParagraphAttributes paragraphAttributes{};
+  Size size{};
+};
+
+/*
+ * Returns measurements for all `requests` (in the same order), taking them
+ * from `measureCache` and `persistentMeasureCache` (which can be `nullptr`)
+ * where possible. The rest of the requests are passed to `measure` at once
+ * (each distinct one only once), and its results are stored in the caches.
+ * Like `TextMeasureCache::get`, measurements which are in flight in other
+ * calls are waited for, and the ones measured by this call are in flight
+ * until `measure` returns (see `SimpleThreadSafeCache::getBatch`).
+ * `measure` is called with `std::vector<TextMeasureRequest const *>` and must
+ * return a measurement for each of them; it's not called if all the
+ * measurements were cached.
+ */
+template <typename MeasureT>
+std::vector<TextMeasurement> measureBatchWithCaches(
+    TextMeasureCache const &measureCache,
+    PersistentTextMeasureCache const *persistentMeasureCache,
+    std::vector<TextMeasureRequest> const &requests,
+    MeasureT &&measure) {
+  auto keys = std::vector<TextMeasureCacheKey>{};
+  keys.reserve(requests.size());
+  for (auto const &request : requests) {
+    keys.push_back({request.attributedString,
+                    request.paragraphAttributes,
+                    request.layoutConstraints});
+  }
+
+  return measureCache.getBatch(
+      keys, [&](std::vector<TextMeasureCacheKey const *> const &missedKeys) {
+        auto measurements = std::vector<TextMeasurement>(missedKeys.size());
+
+        auto measuredRequests = std::vector<TextMeasureRequest const *>{};
+        // Maps each request in `measuredRequests` to its index in
+        // `missedKeys`.
+        auto measuredIndices = std::vector<size_t>{};
+
+        for (size_t i = 0; i < missedKeys.size(); i++) {
+          if (persistentMeasureCache) {
+            auto size = persistentMeasureCache->get(*missedKeys[i]);
+            if (size) {
+              measurements[i] = TextMeasurement{*size, {}};
+              continue;
+            }
+          }
+
+          // Keys point into `keys`, which is parallel to `requests`.
+          measuredRequests.push_back(&requests[missedKeys[i] - keys.data()]);
+          measuredIndices.push_back(i);
+        }
+
+        if (measuredRequests.empty()) {
+          return measurements;
+        }
+
+        auto newMeasurements = measure(measuredRequests);
+        assert(newMeasurements.size() == measuredRequests.size());
+
+        for (size_t i = 0; i < measuredIndices.size(); i++) {
+          auto index = measuredIndices[i];
+          if (persistentMeasureCache) {
+            persistentMeasureCache->record(
+                *missedKeys[index], newMeasurements[i]);
+          }
+          measurements[index] = std::move(newMeasurements[i]);
+        }
+
+        return measurements;
+      });
+}
+
+} // namespace react
+} // namespace facebook
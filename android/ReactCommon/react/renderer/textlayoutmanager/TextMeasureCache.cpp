@@ -10,6 +10,16 @@
 namespace facebook {
 namespace react {
 
+size_t getTextMeasureCacheSizeCap(
+    ContextContainer::Shared const &contextContainer) {
+  if (!contextContainer) {
+    return kSimpleThreadSafeCacheSizeCap;
+  }
+
+  return contextContainer->find<size_t>("TextMeasureCacheSizeCap")
+      .value_or(kSimpleThreadSafeCacheSizeCap);
+}
+
 static Rect rectFromDynamic(folly::dynamic const &data) {
   Point origin;
   origin.x = data.getDefault("x", 0).getDouble();
@@ -34,7 +44,8 @@ LineMeasurement::LineMeasurement(
       frame(frame),
       descender(descender),
       capHeight(capHeight),
-      ascender(ascender) {}
+      ascender(ascender),
+      xHeight(xHeight) {}
 
 LineMeasurement::LineMeasurement(folly::dynamic const &data)
     : text(data.getDefault("text", "").getString()),
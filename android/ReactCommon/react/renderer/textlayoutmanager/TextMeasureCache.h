@@ -10,6 +10,7 @@
 #include <react/renderer/attributedstring/AttributedString.h>
 #include <react/renderer/attributedstring/ParagraphAttributes.h>
 #include <react/renderer/core/LayoutConstraints.h>
+#include <react/utils/ContextContainer.h>
 #include <react/utils/FloatComparison.h>
 #include <react/utils/SimpleThreadSafeCache.h>
 
@@ -73,6 +74,14 @@ class TextMeasureCacheKey final {
  */
 constexpr auto kSimpleThreadSafeCacheSizeCap = size_t{256};
 
+/*
+ * Returns the maximum size of the Cache for a `TextLayoutManager` created with
+ * a given `ContextContainer`. The default cap can be overridden by registering
+ * a `size_t` value for the "TextMeasureCacheSizeCap" key.
+ */
+size_t getTextMeasureCacheSizeCap(
+    ContextContainer::Shared const &contextContainer);
+
 /*
  * Thread-safe, evicting hash table designed to store text measurement
  * information.
@@ -108,24 +117,6 @@ inline bool areTextAttributesEquivalentLayoutWise(
       floatEquality(lhs.lineHeight, rhs.lineHeight);
 }
 
-inline size_t textAttributesHashLayoutWise(
-    TextAttributes const &textAttributes) {
-  // Taking into account the same props as
-  // `areTextAttributesEquivalentLayoutWise` mentions.
-  return folly::hash::hash_combine(
-      0,
-      textAttributes.fontFamily,
-      textAttributes.fontSize,
-      textAttributes.fontSizeMultiplier,
-      textAttributes.fontWeight,
-      textAttributes.fontStyle,
-      textAttributes.fontVariant,
-      textAttributes.allowFontScaling,
-      textAttributes.letterSpacing,
-      textAttributes.lineHeight,
-      textAttributes.alignment);
-}
-
 inline bool areAttributedStringFragmentsEquivalentLayoutWise(
     AttributedString::Fragment const &lhs,
     AttributedString::Fragment const &rhs) {
@@ -139,17 +130,6 @@ inline bool areAttributedStringFragmentsEquivalentLayoutWise(
         rhs.parentShadowView.layoutMetrics));
 }
 
-inline size_t textAttributesHashLayoutWise(
-    AttributedString::Fragment const &fragment) {
-  // Here we are not taking `isAttachment` and `layoutMetrics` into account
-  // because they are logically interdependent and this can break an invariant
-  // between hash and equivalence functions (and cause cache misses).
-  return folly::hash::hash_combine(
-      0,
-      fragment.string,
-      textAttributesHashLayoutWise(fragment.textAttributes));
-}
-
 inline bool areAttributedStringsEquivalentLayoutWise(
     AttributedString const &lhs,
     AttributedString const &rhs) {
@@ -173,14 +153,8 @@ inline bool areAttributedStringsEquivalentLayoutWise(
 
 inline size_t textAttributedStringHashLayoutWise(
     AttributedString const &attributedString) {
-  auto seed = size_t{0};
-
-  for (auto const &fragment : attributedString.getFragments()) {
-    seed =
-        folly::hash::hash_combine(seed, textAttributesHashLayoutWise(fragment));
-  }
-
-  return seed;
+  // The hash of a sealed string (and of its copies) is computed only once.
+  return attributedString.getLayoutWiseHash();
 }
 
 inline bool operator==(
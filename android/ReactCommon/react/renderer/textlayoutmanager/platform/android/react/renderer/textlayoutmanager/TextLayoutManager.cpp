@@ -7,6 +7,7 @@
 
 #include "TextLayoutManager.h"
 
+#include <react/jni/ReadableNativeArray.h>
 #include <react/jni/ReadableNativeMap.h>
 #include <react/renderer/attributedstring/conversions.h>
 #include <react/renderer/core/conversions.h>
@@ -22,6 +23,10 @@ void *TextLayoutManager::getNativeTextLayoutManager() const {
   return self_;
 }
 
+TextMeasureCache::Stats TextLayoutManager::getMeasureCacheStats() const {
+  return measureCache_.getStats();
+}
+
 TextMeasurement TextLayoutManager::measure(
     AttributedStringBox attributedStringBox,
     ParagraphAttributes paragraphAttributes,
@@ -31,8 +36,22 @@ TextMeasurement TextLayoutManager::measure(
   return measureCache_.get(
       {attributedString, paragraphAttributes, layoutConstraints},
       [&](TextMeasureCacheKey const &key) {
-        return doMeasure(
-            attributedString, paragraphAttributes, layoutConstraints);
+        return measureWithPersistentCache(
+            persistentMeasureCache_.get(), key, [&] {
+              return doMeasure(
+                  attributedString, paragraphAttributes, layoutConstraints);
+            });
+      });
+}
+
+std::vector<TextMeasurement> TextLayoutManager::measureBatch(
+    std::vector<TextMeasureRequest> const &requests) const {
+  return measureBatchWithCaches(
+      measureCache_,
+      persistentMeasureCache_.get(),
+      requests,
+      [&](std::vector<TextMeasureRequest const *> const &missedRequests) {
+        return doMeasureBatch(missedRequests);
       });
 }
 
@@ -155,6 +174,122 @@ LinesMeasurements TextLayoutManager::measureLines(
   return lineMeasurements;
 }
 
+std::vector<LinesMeasurements> TextLayoutManager::measureLinesBatch(
+    std::vector<LinesMeasureRequest> const &requests) const {
+  if (requests.empty()) {
+    return {};
+  }
+
+  const jni::global_ref<jobject> &fabricUIManager =
+      contextContainer_->at<jni::global_ref<jobject>>("FabricUIManager");
+  static auto measureLinesBatch =
+      jni::findClassStatic("com/facebook/react/fabric/FabricUIManager")
+          ->getMethod<NativeArray::javaobject(ReadableArray::javaobject)>(
+              "measureLinesBatch");
+
+  auto serializedRequests = folly::dynamic::array();
+  for (auto const &request : requests) {
+    serializedRequests.push_back(folly::dynamic::object(
+        "attributedString", toDynamic(request.attributedString))(
+        "paragraphAttributes", toDynamic(request.paragraphAttributes))(
+        "width", request.size.width)("height", request.size.height));
+  }
+
+  local_ref<ReadableNativeArray::javaobject> requestsRNA =
+      ReadableNativeArray::newObjectCxxArgs(std::move(serializedRequests));
+  local_ref<ReadableArray::javaobject> requestsRA = make_local(
+      reinterpret_cast<ReadableArray::javaobject>(requestsRNA.get()));
+
+  auto array = measureLinesBatch(fabricUIManager, requestsRA.get());
+
+  auto dynamicArray = cthis(array)->consume();
+  auto linesMeasurements = std::vector<LinesMeasurements>{};
+  linesMeasurements.reserve(dynamicArray.size());
+
+  for (auto const &data : dynamicArray) {
+    auto lineMeasurements = LinesMeasurements{};
+    lineMeasurements.reserve(data.size());
+    for (auto const &lineData : data) {
+      lineMeasurements.push_back(LineMeasurement(lineData));
+    }
+    linesMeasurements.push_back(std::move(lineMeasurements));
+  }
+
+  // Explicitly release smart pointers to free up space faster in JNI tables
+  requestsRA.reset();
+  requestsRNA.reset();
+
+  return linesMeasurements;
+}
+
+std::vector<TextMeasurement> TextLayoutManager::doMeasureBatch(
+    std::vector<TextMeasureRequest const *> const &requests) const {
+  auto measurements = std::vector<TextMeasurement>(requests.size());
+
+  // Positions of attachments are returned through an array which is specific
+  // to a string, so strings with attachments are measured one by one.
+  auto batchedIndices = std::vector<size_t>{};
+  auto serializedRequests = folly::dynamic::array();
+  for (size_t i = 0; i < requests.size(); i++) {
+    auto const &request = *requests[i];
+
+    auto hasAttachments = false;
+    for (auto const &fragment : request.attributedString.getFragments()) {
+      if (fragment.isAttachment()) {
+        hasAttachments = true;
+        break;
+      }
+    }
+
+    if (hasAttachments) {
+      measurements[i] = doMeasure(
+          request.attributedString,
+          request.paragraphAttributes,
+          request.layoutConstraints);
+      continue;
+    }
+
+    auto minimumSize = request.layoutConstraints.minimumSize;
+    auto maximumSize = request.layoutConstraints.maximumSize;
+    serializedRequests.push_back(folly::dynamic::object(
+        "attributedString", toDynamic(request.attributedString))(
+        "paragraphAttributes", toDynamic(request.paragraphAttributes))(
+        "minWidth", minimumSize.width)("maxWidth", maximumSize.width)(
+        "minHeight", minimumSize.height)("maxHeight", maximumSize.height));
+    batchedIndices.push_back(i);
+  }
+
+  if (batchedIndices.empty()) {
+    return measurements;
+  }
+
+  const jni::global_ref<jobject> &fabricUIManager =
+      contextContainer_->at<jni::global_ref<jobject>>("FabricUIManager");
+  static auto measureBatch =
+      jni::findClassStatic("com/facebook/react/fabric/FabricUIManager")
+          ->getMethod<jlongArray(ReadableArray::javaobject)>("measureBatch");
+
+  local_ref<ReadableNativeArray::javaobject> requestsRNA =
+      ReadableNativeArray::newObjectCxxArgs(std::move(serializedRequests));
+  local_ref<ReadableArray::javaobject> requestsRA = make_local(
+      reinterpret_cast<ReadableArray::javaobject>(requestsRNA.get()));
+
+  auto sizes = measureBatch(fabricUIManager, requestsRA.get());
+  auto sizesRegion = sizes->getRegion(0, sizes->size());
+
+  for (size_t i = 0; i < batchedIndices.size(); i++) {
+    measurements[batchedIndices[i]] =
+        TextMeasurement{yogaMeassureToSize(sizesRegion[i]), {}};
+  }
+
+  // Explicitly release smart pointers to free up space faster in JNI tables
+  sizes.reset();
+  requestsRA.reset();
+  requestsRNA.reset();
+
+  return measurements;
+}
+
 TextMeasurement TextLayoutManager::doMeasure(
     AttributedString attributedString,
     ParagraphAttributes paragraphAttributes,
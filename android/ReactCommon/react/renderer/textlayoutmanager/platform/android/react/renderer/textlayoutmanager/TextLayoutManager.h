@@ -10,6 +10,8 @@
 #include <react/renderer/attributedstring/AttributedString.h>
 #include <react/renderer/attributedstring/AttributedStringBox.h>
 #include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
+#include <react/renderer/textlayoutmanager/TextMeasureBatch.h>
 #include <react/renderer/textlayoutmanager/TextMeasureCache.h>
 #include <react/utils/ContextContainer.h>
 
@@ -26,7 +28,10 @@ using SharedTextLayoutManager = std::shared_ptr<const TextLayoutManager>;
 class TextLayoutManager {
  public:
   TextLayoutManager(const ContextContainer::Shared &contextContainer)
-      : contextContainer_(contextContainer){};
+      : contextContainer_(contextContainer),
+        measureCache_(getTextMeasureCacheSizeCap(contextContainer)),
+        persistentMeasureCache_(
+            PersistentTextMeasureCache::shared(contextContainer)){};
   ~TextLayoutManager();
 
   /*
@@ -37,6 +42,15 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Measures a batch of attributed strings, returning a measurement for each
+   * request (in the same order). Equivalent to calling `measure` for each of
+   * them, but the strings which aren't cached are serialized and measured
+   * together with a single JNI call.
+   */
+  std::vector<TextMeasurement> measureBatch(
+      std::vector<TextMeasureRequest> const &requests) const;
+
   /**
    * Measures an AttributedString on the platform, as identified by some
    * opaque cache ID.
@@ -55,21 +69,37 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       Size size) const;
 
+  /*
+   * Measures lines of a batch of attributed strings with a single JNI call,
+   * returning measurements for each request (in the same order).
+   */
+  std::vector<LinesMeasurements> measureLinesBatch(
+      std::vector<LinesMeasureRequest> const &requests) const;
+
   /*
    * Returns an opaque pointer to platform-specific TextLayoutManager.
    * Is used on a native views layer to delegate text rendering to the manager.
    */
   void *getNativeTextLayoutManager() const;
 
+  /*
+   * Returns hit and miss counters of the text measure cache.
+   */
+  TextMeasureCache::Stats getMeasureCacheStats() const;
+
  private:
   TextMeasurement doMeasure(
       AttributedString attributedString,
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  std::vector<TextMeasurement> doMeasureBatch(
+      std::vector<TextMeasureRequest const *> const &requests) const;
+
   void *self_;
   ContextContainer::Shared contextContainer_;
-  TextMeasureCache measureCache_{};
+  TextMeasureCache measureCache_;
+  std::shared_ptr<PersistentTextMeasureCache> persistentMeasureCache_;
 };
 
 } // namespace react
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "FontMetrics.h"
+
+#include <string>
+
+namespace facebook {
+namespace react {
+
+static void setAdvances(
+    FontMetrics &fontMetrics,
+    char const *characters,
+    Float advance) {
+  for (auto character = characters; *character != '\0'; character++) {
+    fontMetrics.setAdvance(static_cast<char32_t>(*character), advance);
+  }
+}
+
+FontMetrics::Shared FontMetrics::defaultFontMetrics() {
+  static auto const fontMetrics = [] {
+    auto fontMetrics = std::make_shared<FontMetrics>();
+    setAdvances(*fontMetrics, " ", 0.28);
+    setAdvances(*fontMetrics, "\t", 1.12);
+    setAdvances(*fontMetrics, "ijl.,:;'!|", 0.24);
+    setAdvances(*fontMetrics, "frtI()[]{}\"-/\\`", 0.34);
+    setAdvances(*fontMetrics, "abcdeghknopqsuvxyz", 0.54);
+    setAdvances(*fontMetrics, "0123456789$*+<=>?^_~#", 0.56);
+    setAdvances(*fontMetrics, "ABCDEFGHJKLNOPQRSTUVXYZ&", 0.66);
+    setAdvances(*fontMetrics, "mwMW%@", 0.86);
+    return fontMetrics;
+  }();
+
+  return fontMetrics;
+}
+
+FontMetrics FontMetrics::fromDynamic(folly::dynamic const &data) {
+  auto fontMetrics = *defaultFontMetrics();
+
+  auto readValue = [&](char const *key, Float &value) {
+    value = static_cast<Float>(data.getDefault(key, value).asDouble());
+  };
+
+  readValue("ascent", fontMetrics.ascent);
+  readValue("descent", fontMetrics.descent);
+  readValue("lineHeight", fontMetrics.lineHeight);
+  readValue("capHeight", fontMetrics.capHeight);
+  readValue("xHeight", fontMetrics.xHeight);
+  readValue("defaultAdvance", fontMetrics.defaultAdvance);
+
+  auto advances = data.getDefault("advances", folly::dynamic::object());
+  for (auto const &pair : advances.items()) {
+    auto codePoint = static_cast<char32_t>(std::stoul(pair.first.asString()));
+    fontMetrics.setAdvance(
+        codePoint, static_cast<Float>(pair.second.asDouble()));
+  }
+
+  return fontMetrics;
+}
+
+Float FontMetrics::getAdvance(char32_t codePoint) const {
+  if (codePoint < kAsciiCount) {
+    auto advance = asciiAdvances_[codePoint];
+    return advance < 0 ? defaultAdvance : advance;
+  }
+
+  auto iterator = advances_.find(codePoint);
+  return iterator == advances_.end() ? defaultAdvance : iterator->second;
+}
+
+void FontMetrics::setAdvance(char32_t codePoint, Float advance) {
+  if (codePoint < kAsciiCount) {
+    asciiAdvances_[codePoint] = advance;
+    return;
+  }
+
+  advances_[codePoint] = advance;
+}
+
+std::array<Float, FontMetrics::kAsciiCount>
+FontMetrics::filledAsciiAdvances() {
+  auto advances = std::array<Float, kAsciiCount>{};
+  advances.fill(-1);
+  return advances;
+}
+
+} // namespace react
+} // namespace facebook
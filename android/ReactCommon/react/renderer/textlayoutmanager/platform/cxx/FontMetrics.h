@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+#include <folly/dynamic.h>
+#include <react/renderer/graphics/Float.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Metrics of a font which the cxx `TextLayoutManager` uses to measure text
+ * without any platform text rendering infrastructure.
+ * All values are relative to the font size (in ems).
+ */
+class FontMetrics final {
+ public:
+  using Shared = std::shared_ptr<FontMetrics const>;
+
+  /*
+   * Returns metrics approximating a regular proportional sans-serif font.
+   * Used when no other metrics are registered in `ContextContainer` (as
+   * `FontMetrics::Shared` for the "FontMetrics" key).
+   */
+  static FontMetrics::Shared defaultFontMetrics();
+
+  /*
+   * Creates metrics from a table like this one:
+   * {
+   *   "ascent": 0.8, "descent": 0.2, "lineHeight": 1.2,
+   *   "capHeight": 0.7, "xHeight": 0.5,
+   *   "defaultAdvance": 0.55,
+   *   "advances": {"32": 0.25, "105": 0.22}
+   * }
+   * Keys of "advances" are decimal Unicode code points. Missing values are
+   * taken from `defaultFontMetrics()`.
+   */
+  static FontMetrics fromDynamic(folly::dynamic const &data);
+
+  /*
+   * Distances from the baseline to the top and to the bottom of the line box
+   * and the default height of the line.
+   */
+  Float ascent{0.8};
+  Float descent{0.2};
+  Float lineHeight{1.2};
+
+  Float capHeight{0.7};
+  Float xHeight{0.5};
+
+  /*
+   * Advance of the glyphs which have no advance of their own.
+   */
+  Float defaultAdvance{0.55};
+
+  /*
+   * Returns and sets the advance of the glyph representing `codePoint`.
+   */
+  Float getAdvance(char32_t codePoint) const;
+  void setAdvance(char32_t codePoint, Float advance);
+
+ private:
+  static constexpr auto kAsciiCount = size_t{128};
+
+  // Negative values stand for the default advance.
+  std::array<Float, kAsciiCount> asciiAdvances_ = filledAsciiAdvances();
+  std::unordered_map<char32_t, Float> advances_;
+
+  static std::array<Float, kAsciiCount> filledAsciiAdvances();
+};
+
+} // namespace react
+} // namespace facebook
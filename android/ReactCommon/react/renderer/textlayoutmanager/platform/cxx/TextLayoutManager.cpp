@@ -7,20 +7,680 @@
 
 #include "TextLayoutManager.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace facebook {
 namespace react {
 
+namespace {
+
+constexpr auto kDefaultFontSize = Float{14};
+constexpr auto kEllipsisCodePoint = char32_t{0x2026};
+constexpr auto kNoIndex = std::numeric_limits<size_t>::max();
+
+/*
+ * Metrics of a fragment scaled to its font size. For attachments, the ascent
+ * is the height of the attachment (they sit on the baseline).
+ */
+struct RunMetrics {
+  Float fontSize{0};
+  Float letterSpacing{0};
+  Float ascent{0};
+  Float descent{0};
+  Float capHeight{0};
+  Float xHeight{0};
+};
+
+enum class GlyphKind { Regular, Whitespace, LineBreak, Attachment };
+
+struct Glyph {
+  size_t fragmentIndex;
+  size_t offset;
+  size_t length;
+  Float advance;
+  GlyphKind kind;
+  // Lines can break before and after the glyph (ideographs, attachments).
+  bool isBreakableAround;
+  size_t attachmentIndex;
+};
+
+/*
+ * Visible glyphs of a line are `[begin, end)`, followed by the ellipsis (if
+ * any) and `[tailBegin, tailEnd)`.
+ */
+struct Line {
+  size_t begin{0};
+  size_t end{0};
+  size_t tailBegin{0};
+  size_t tailEnd{0};
+  bool hasEllipsis{false};
+  Float ellipsisAdvance{0};
+
+  // Fragment which defines the metrics of the line if it has no glyphs.
+  size_t fragmentIndex{0};
+
+  Rect frame{};
+  RunMetrics metrics{};
+};
+
+struct TextLayout {
+  AttributedString::Fragments const &fragments;
+  std::vector<RunMetrics> runs;
+  std::vector<Glyph> glyphs;
+  std::vector<Line> lines;
+  size_t attachmentCount{0};
+  Size size{};
+};
+
+char32_t decodeUtf8(std::string const &string, size_t offset, size_t &length) {
+  auto byte = static_cast<unsigned char>(string[offset]);
+  auto codePoint = char32_t{byte};
+
+  if (byte < 0x80) {
+    length = 1;
+    return codePoint;
+  } else if ((byte & 0xE0) == 0xC0) {
+    length = 2;
+    codePoint = byte & 0x1F;
+  } else if ((byte & 0xF0) == 0xE0) {
+    length = 3;
+    codePoint = byte & 0x0F;
+  } else if ((byte & 0xF8) == 0xF0) {
+    length = 4;
+    codePoint = byte & 0x07;
+  } else {
+    length = 1;
+    return 0xFFFD;
+  }
+
+  if (offset + length > string.size()) {
+    length = 1;
+    return 0xFFFD;
+  }
+
+  for (size_t i = 1; i < length; i++) {
+    auto continuation = static_cast<unsigned char>(string[offset + i]);
+    if ((continuation & 0xC0) != 0x80) {
+      length = 1;
+      return 0xFFFD;
+    }
+    codePoint = (codePoint << 6) | (continuation & 0x3F);
+  }
+
+  return codePoint;
+}
+
+bool isLineBreak(char32_t codePoint) {
+  return codePoint == '\n' || codePoint == '\r' || codePoint == 0x2028 ||
+      codePoint == 0x2029;
+}
+
+bool isWhitespace(char32_t codePoint) {
+  return codePoint == ' ' || codePoint == '\t' || codePoint == 0x1680 ||
+      (codePoint >= 0x2000 && codePoint <= 0x200B) || codePoint == 0x205F ||
+      codePoint == 0x3000;
+}
+
+bool isIdeographic(char32_t codePoint) {
+  return (codePoint >= 0x2E80 && codePoint <= 0x9FFF) ||
+      (codePoint >= 0xAC00 && codePoint <= 0xD7AF) ||
+      (codePoint >= 0xF900 && codePoint <= 0xFAFF) ||
+      (codePoint >= 0xFF00 && codePoint <= 0xFFEF) ||
+      (codePoint >= 0x20000 && codePoint <= 0x2FFFF);
+}
+
+RunMetrics runMetrics(
+    AttributedString::Fragment const &fragment,
+    FontMetrics const &fontMetrics) {
+  auto const &textAttributes = fragment.textAttributes;
+  auto runMetrics = RunMetrics{};
+
+  if (fragment.isAttachment()) {
+    runMetrics.ascent =
+        fragment.parentShadowView.layoutMetrics.frame.size.height;
+    return runMetrics;
+  }
+
+  auto fontSizeMultiplier = textAttributes.allowFontScaling.value_or(true) &&
+          !std::isnan(textAttributes.fontSizeMultiplier)
+      ? textAttributes.fontSizeMultiplier
+      : Float{1};
+  auto fontSize = std::isnan(textAttributes.fontSize) ? kDefaultFontSize
+                                                      : textAttributes.fontSize;
+  fontSize *= fontSizeMultiplier;
+
+  auto ascent = fontMetrics.ascent * fontSize;
+  auto descent = fontMetrics.descent * fontSize;
+  auto lineHeight = std::isnan(textAttributes.lineHeight)
+      ? fontMetrics.lineHeight * fontSize
+      : textAttributes.lineHeight * fontSizeMultiplier;
+  // The difference between the line height and the height of the font is
+  // split evenly above and below the glyphs.
+  auto halfLeading = (lineHeight - ascent - descent) / 2;
+
+  runMetrics.fontSize = fontSize;
+  runMetrics.letterSpacing = std::isnan(textAttributes.letterSpacing)
+      ? Float{0}
+      : textAttributes.letterSpacing;
+  runMetrics.ascent = ascent + halfLeading;
+  runMetrics.descent = descent + halfLeading;
+  runMetrics.capHeight = fontMetrics.capHeight * fontSize;
+  runMetrics.xHeight = fontMetrics.xHeight * fontSize;
+  return runMetrics;
+}
+
+void buildGlyphs(TextLayout &layout, FontMetrics const &fontMetrics) {
+  for (size_t index = 0; index < layout.fragments.size(); index++) {
+    auto const &fragment = layout.fragments[index];
+    auto const &string = fragment.string;
+    auto const &run = layout.runs[index];
+
+    if (fragment.isAttachment()) {
+      layout.glyphs.push_back(
+          {index,
+           0,
+           string.size(),
+           fragment.parentShadowView.layoutMetrics.frame.size.width,
+           GlyphKind::Attachment,
+           true,
+           layout.attachmentCount++});
+      continue;
+    }
+
+    auto offset = size_t{0};
+    while (offset < string.size()) {
+      auto length = size_t{0};
+      auto codePoint = decodeUtf8(string, offset, length);
+
+      auto kind = GlyphKind::Regular;
+      if (isLineBreak(codePoint)) {
+        kind = GlyphKind::LineBreak;
+        if (codePoint == '\r' && offset + 1 < string.size() &&
+            string[offset + 1] == '\n') {
+          length++;
+        }
+      } else if (isWhitespace(codePoint)) {
+        kind = GlyphKind::Whitespace;
+      }
+
+      auto advance = kind == GlyphKind::LineBreak
+          ? Float{0}
+          : fontMetrics.getAdvance(codePoint) * run.fontSize +
+              run.letterSpacing;
+
+      layout.glyphs.push_back(
+          {index,
+           offset,
+           length,
+           advance,
+           kind,
+           isIdeographic(codePoint),
+           kNoIndex});
+      offset += length;
+    }
+  }
+}
+
+void addLine(TextLayout &layout, size_t begin, size_t end) {
+  auto line = Line{};
+  line.begin = begin;
+  line.end = end;
+  line.tailBegin = end;
+  line.tailEnd = end;
+  line.fragmentIndex =
+      layout.glyphs[std::min(begin, layout.glyphs.size() - 1)].fragmentIndex;
+  layout.lines.push_back(line);
+}
+
+/*
+ * Greedy line breaking: lines break at the last opportunity before the
+ * glyph which doesn't fit; words longer than a line are broken anywhere.
+ * Whitespace at the end of a line may overflow it.
+ */
+void breakLines(TextLayout &layout, Float maximumWidth) {
+  auto const &glyphs = layout.glyphs;
+  if (glyphs.empty()) {
+    return;
+  }
+
+  auto lineBegin = size_t{0};
+  auto lineWidth = Float{0};
+  auto breakIndex = kNoIndex;
+
+  for (size_t index = 0; index < glyphs.size(); index++) {
+    auto const &glyph = glyphs[index];
+
+    if (glyph.kind == GlyphKind::LineBreak) {
+      addLine(layout, lineBegin, index);
+      lineBegin = index + 1;
+      lineWidth = 0;
+      breakIndex = kNoIndex;
+      continue;
+    }
+
+    if (glyph.isBreakableAround && index > lineBegin) {
+      breakIndex = index;
+    }
+
+    if (glyph.kind != GlyphKind::Whitespace && index > lineBegin &&
+        lineWidth + glyph.advance > maximumWidth) {
+      auto lineEnd = breakIndex == kNoIndex ? index : breakIndex;
+      addLine(layout, lineBegin, lineEnd);
+      lineBegin = lineEnd;
+      lineWidth = 0;
+      for (auto i = lineEnd; i < index; i++) {
+        lineWidth += glyphs[i].advance;
+      }
+      breakIndex = kNoIndex;
+    }
+
+    lineWidth += glyph.advance;
+
+    if (glyph.kind == GlyphKind::Whitespace || glyph.isBreakableAround) {
+      breakIndex = index + 1;
+    }
+  }
+
+  addLine(layout, lineBegin, glyphs.size());
+}
+
+Float advanceSum(TextLayout const &layout, size_t begin, size_t end) {
+  auto sum = Float{0};
+  for (auto i = begin; i < end; i++) {
+    sum += layout.glyphs[i].advance;
+  }
+  return sum;
+}
+
+bool isWhitespaceGlyph(TextLayout const &layout, size_t index) {
+  return layout.glyphs[index].kind == GlyphKind::Whitespace;
+}
+
+/*
+ * Replaces the end (or, for single lines, the beginning or the middle) of the
+ * last line with an ellipsis. `paragraphEnd` is the end of the text which the
+ * line stands for.
+ */
+void ellipsizeLine(
+    TextLayout &layout,
+    Line &line,
+    size_t paragraphEnd,
+    EllipsizeMode ellipsizeMode,
+    FontMetrics const &fontMetrics,
+    Float maximumWidth) {
+  auto const &glyphs = layout.glyphs;
+  auto runIndex = line.end > line.begin ? glyphs[line.end - 1].fragmentIndex
+                                        : line.fragmentIndex;
+  auto const &run = layout.runs[runIndex];
+  auto ellipsisAdvance =
+      fontMetrics.getAdvance(kEllipsisCodePoint) * run.fontSize +
+      run.letterSpacing;
+
+  line.hasEllipsis = true;
+  line.ellipsisAdvance = ellipsisAdvance;
+
+  switch (ellipsizeMode) {
+    case EllipsizeMode::Clip:
+    case EllipsizeMode::Tail: {
+      auto end = line.end;
+      auto width = advanceSum(layout, line.begin, end);
+      while (end > line.begin &&
+             (isWhitespaceGlyph(layout, end - 1) ||
+              width + ellipsisAdvance > maximumWidth)) {
+        width -= glyphs[end - 1].advance;
+        end--;
+      }
+      line.end = end;
+      line.tailBegin = end;
+      line.tailEnd = end;
+      break;
+    }
+
+    case EllipsizeMode::Head: {
+      auto begin = paragraphEnd;
+      auto width = ellipsisAdvance;
+      while (begin > line.begin &&
+             width + glyphs[begin - 1].advance <= maximumWidth) {
+        width += glyphs[begin - 1].advance;
+        begin--;
+      }
+      while (begin < paragraphEnd && isWhitespaceGlyph(layout, begin)) {
+        begin++;
+      }
+      line.tailBegin = begin;
+      line.tailEnd = paragraphEnd;
+      line.end = line.begin;
+      break;
+    }
+
+    case EllipsizeMode::Middle: {
+      auto end = line.begin;
+      auto tailBegin = paragraphEnd;
+      auto width = ellipsisAdvance;
+      auto hasProgress = true;
+      while (hasProgress && end < tailBegin) {
+        hasProgress = false;
+        if (width + glyphs[end].advance <= maximumWidth) {
+          width += glyphs[end].advance;
+          end++;
+          hasProgress = true;
+        }
+        if (end < tailBegin &&
+            width + glyphs[tailBegin - 1].advance <= maximumWidth) {
+          width += glyphs[tailBegin - 1].advance;
+          tailBegin--;
+          hasProgress = true;
+        }
+      }
+      line.end = end;
+      line.tailBegin = tailBegin;
+      line.tailEnd = paragraphEnd;
+      break;
+    }
+  }
+}
+
+void truncateLines(
+    TextLayout &layout,
+    ParagraphAttributes const &paragraphAttributes,
+    FontMetrics const &fontMetrics,
+    Float maximumWidth) {
+  auto maximumNumberOfLines = paragraphAttributes.maximumNumberOfLines;
+  if (maximumNumberOfLines <= 0 ||
+      layout.lines.size() <= static_cast<size_t>(maximumNumberOfLines)) {
+    return;
+  }
+
+  layout.lines.resize(maximumNumberOfLines);
+
+  auto ellipsizeMode = paragraphAttributes.ellipsizeMode;
+  if (ellipsizeMode == EllipsizeMode::Clip) {
+    return;
+  }
+
+  // Like the platforms, only single lines are ellipsized at the beginning or
+  // in the middle.
+  if (maximumNumberOfLines > 1) {
+    ellipsizeMode = EllipsizeMode::Tail;
+  }
+
+  auto &line = layout.lines.back();
+  auto paragraphEnd = line.end;
+  while (paragraphEnd < layout.glyphs.size() &&
+         layout.glyphs[paragraphEnd].kind != GlyphKind::LineBreak) {
+    paragraphEnd++;
+  }
+
+  ellipsizeLine(
+      layout, line, paragraphEnd, ellipsizeMode, fontMetrics, maximumWidth);
+}
+
+void includeRunMetrics(RunMetrics &metrics, RunMetrics const &run) {
+  metrics.ascent = std::max(metrics.ascent, run.ascent);
+  metrics.descent = std::max(metrics.descent, run.descent);
+  metrics.capHeight = std::max(metrics.capHeight, run.capHeight);
+  metrics.xHeight = std::max(metrics.xHeight, run.xHeight);
+}
+
+void measureLines(TextLayout &layout) {
+  auto top = Float{0};
+  auto width = Float{0};
+
+  for (auto &line : layout.lines) {
+    auto end = line.end;
+    if (!line.hasEllipsis) {
+      while (end > line.begin && isWhitespaceGlyph(layout, end - 1)) {
+        end--;
+      }
+    }
+
+    auto lineWidth = advanceSum(layout, line.begin, end) +
+        (line.hasEllipsis ? line.ellipsisAdvance : 0) +
+        advanceSum(layout, line.tailBegin, line.tailEnd);
+
+    auto metrics = RunMetrics{};
+    auto isEmpty = true;
+    for (auto range : {std::make_pair(line.begin, line.end),
+                       std::make_pair(line.tailBegin, line.tailEnd)}) {
+      for (auto i = range.first; i < range.second; i++) {
+        includeRunMetrics(metrics, layout.runs[layout.glyphs[i].fragmentIndex]);
+        isEmpty = false;
+      }
+    }
+    if (isEmpty) {
+      includeRunMetrics(metrics, layout.runs[line.fragmentIndex]);
+    }
+
+    line.metrics = metrics;
+    line.frame.origin = {0, top};
+    line.frame.size = {lineWidth, metrics.ascent + metrics.descent};
+
+    top += line.frame.size.height;
+    width = std::max(width, lineWidth);
+  }
+
+  layout.size = {width, top};
+}
+
+/*
+ * Aligns lines horizontally inside of a container of given width.
+ */
+void alignLines(TextLayout &layout, Float containerWidth) {
+  if (layout.fragments.empty()) {
+    return;
+  }
+
+  auto const &textAttributes = layout.fragments.front().textAttributes;
+  auto alignment = textAttributes.alignment.value_or(TextAlignment::Natural);
+  if (alignment == TextAlignment::Natural) {
+    alignment = textAttributes.layoutDirection.value_or(
+                    LayoutDirection::LeftToRight) ==
+            LayoutDirection::RightToLeft
+        ? TextAlignment::Right
+        : TextAlignment::Left;
+  }
+
+  for (auto &line : layout.lines) {
+    auto freeSpace = std::max(Float{0}, containerWidth - line.frame.size.width);
+    switch (alignment) {
+      case TextAlignment::Center:
+        line.frame.origin.x = freeSpace / 2;
+        break;
+      case TextAlignment::Right:
+        line.frame.origin.x = freeSpace;
+        break;
+      default:
+        line.frame.origin.x = 0;
+        break;
+    }
+  }
+}
+
+TextLayout layoutText(
+    AttributedString const &attributedString,
+    ParagraphAttributes const &paragraphAttributes,
+    FontMetrics const &fontMetrics,
+    Float maximumWidth) {
+  auto layout = TextLayout{attributedString.getFragments()};
+
+  layout.runs.reserve(layout.fragments.size());
+  for (auto const &fragment : layout.fragments) {
+    layout.runs.push_back(runMetrics(fragment, fontMetrics));
+  }
+
+  buildGlyphs(layout, fontMetrics);
+  breakLines(layout, maximumWidth);
+  truncateLines(layout, paragraphAttributes, fontMetrics, maximumWidth);
+  measureLines(layout);
+  alignLines(
+      layout,
+      std::isfinite(maximumWidth) ? maximumWidth : layout.size.width);
+  return layout;
+}
+
+std::string lineText(TextLayout const &layout, Line const &line) {
+  auto text = std::string{};
+  auto appendGlyphs = [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto const &glyph = layout.glyphs[i];
+      text.append(
+          layout.fragments[glyph.fragmentIndex].string,
+          glyph.offset,
+          glyph.length);
+    }
+  };
+
+  appendGlyphs(line.begin, line.end);
+  if (line.hasEllipsis) {
+    text += u8"\u2026";
+  }
+  appendGlyphs(line.tailBegin, line.tailEnd);
+  return text;
+}
+
+TextMeasurement::Attachments attachmentFrames(TextLayout const &layout) {
+  auto attachments = TextMeasurement::Attachments(
+      layout.attachmentCount, TextMeasurement::Attachment{{}, true});
+
+  for (auto const &line : layout.lines) {
+    auto x = line.frame.origin.x;
+    auto positionGlyphs = [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; i++) {
+        auto const &glyph = layout.glyphs[i];
+        if (glyph.kind == GlyphKind::Attachment) {
+          auto size = Size{glyph.advance,
+                           layout.runs[glyph.fragmentIndex].ascent};
+          auto y = line.frame.origin.y + line.metrics.ascent - size.height;
+          attachments[glyph.attachmentIndex] =
+              TextMeasurement::Attachment{{{x, y}, size}, false};
+        }
+        x += glyph.advance;
+      }
+    };
+
+    positionGlyphs(line.begin, line.end);
+    x += line.hasEllipsis ? line.ellipsisAdvance : 0;
+    positionGlyphs(line.tailBegin, line.tailEnd);
+  }
+
+  return attachments;
+}
+
+} // namespace
+
+TextLayoutManager::TextLayoutManager(
+    const ContextContainer::Shared &contextContainer)
+    : contextContainer_(contextContainer),
+      measureCache_(getTextMeasureCacheSizeCap(contextContainer)),
+      persistentMeasureCache_(
+          PersistentTextMeasureCache::shared(contextContainer)) {
+  auto fontMetrics = contextContainer
+      ? contextContainer->find<FontMetrics::Shared>("FontMetrics")
+      : better::optional<FontMetrics::Shared>{};
+  fontMetrics_ = fontMetrics && *fontMetrics
+      ? *fontMetrics
+      : FontMetrics::defaultFontMetrics();
+}
+
 TextLayoutManager::~TextLayoutManager() {}
 
 void *TextLayoutManager::getNativeTextLayoutManager() const {
   return self_;
 }
 
+TextMeasureCache::Stats TextLayoutManager::getMeasureCacheStats() const {
+  return measureCache_.getStats();
+}
+
 TextMeasurement TextLayoutManager::measure(
     AttributedStringBox attributedStringBox,
     ParagraphAttributes paragraphAttributes,
     LayoutConstraints layoutConstraints) const {
-  return TextMeasurement{{0, 0}, {}};
+  if (attributedStringBox.getMode() != AttributedStringBox::Mode::Value) {
+    // Opaque (platform-specific) strings cannot be measured here.
+    return TextMeasurement{{0, 0}, {}};
+  }
+
+  auto &attributedString = attributedStringBox.getValue();
+
+  return measureCache_.get(
+      {attributedString, paragraphAttributes, layoutConstraints},
+      [&](TextMeasureCacheKey const &key) {
+        return measureWithPersistentCache(
+            persistentMeasureCache_.get(), key, [&] {
+              return doMeasure(
+                  attributedString, paragraphAttributes, layoutConstraints);
+            });
+      });
+}
+
+std::vector<TextMeasurement> TextLayoutManager::measureBatch(
+    std::vector<TextMeasureRequest> const &requests) const {
+  return measureBatchWithCaches(
+      measureCache_,
+      persistentMeasureCache_.get(),
+      requests,
+      [&](std::vector<TextMeasureRequest const *> const &missedRequests) {
+        auto measurements = std::vector<TextMeasurement>{};
+        measurements.reserve(missedRequests.size());
+        for (auto request : missedRequests) {
+          measurements.push_back(doMeasure(
+              request->attributedString,
+              request->paragraphAttributes,
+              request->layoutConstraints));
+        }
+        return measurements;
+      });
+}
+
+LinesMeasurements TextLayoutManager::measureLines(
+    AttributedString attributedString,
+    ParagraphAttributes paragraphAttributes,
+    Size size) const {
+  auto layout = layoutText(
+      attributedString, paragraphAttributes, *fontMetrics_, size.width);
+
+  auto linesMeasurements = LinesMeasurements{};
+  linesMeasurements.reserve(layout.lines.size());
+
+  for (auto const &line : layout.lines) {
+    linesMeasurements.push_back(LineMeasurement(
+        lineText(layout, line),
+        line.frame,
+        line.metrics.descent,
+        line.metrics.capHeight,
+        line.metrics.ascent,
+        line.metrics.xHeight));
+  }
+
+  return linesMeasurements;
+}
+
+std::vector<LinesMeasurements> TextLayoutManager::measureLinesBatch(
+    std::vector<LinesMeasureRequest> const &requests) const {
+  auto linesMeasurements = std::vector<LinesMeasurements>{};
+  linesMeasurements.reserve(requests.size());
+  for (auto const &request : requests) {
+    linesMeasurements.push_back(measureLines(
+        request.attributedString, request.paragraphAttributes, request.size));
+  }
+  return linesMeasurements;
+}
+
+TextMeasurement TextLayoutManager::doMeasure(
+    AttributedString const &attributedString,
+    ParagraphAttributes const &paragraphAttributes,
+    LayoutConstraints const &layoutConstraints) const {
+  auto layout = layoutText(
+      attributedString,
+      paragraphAttributes,
+      *fontMetrics_,
+      layoutConstraints.maximumSize.width);
+
+  return TextMeasurement{layoutConstraints.clamp(layout.size),
+                         attachmentFrames(layout)};
 }
 
 } // namespace react
@@ -13,6 +13,9 @@
 #include <react/renderer/attributedstring/AttributedStringBox.h>
 #include <react/renderer/attributedstring/ParagraphAttributes.h>
 #include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/textlayoutmanager/FontMetrics.h>
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
+#include <react/renderer/textlayoutmanager/TextMeasureBatch.h>
 #include <react/renderer/textlayoutmanager/TextMeasureCache.h>
 #include <react/utils/ContextContainer.h>
 
@@ -24,32 +27,70 @@ class TextLayoutManager;
 using SharedTextLayoutManager = std::shared_ptr<const TextLayoutManager>;
 
 /*
- * Cross platform facade for Android-specific TextLayoutManager.
+ * Platform-independent TextLayoutManager.
+ * Lays out text using a table of font metrics (see `FontMetrics`) and greedy
+ * line breaking. The results are deterministic and only approximate what
+ * platform text rendering would produce.
  */
 class TextLayoutManager {
  public:
-  TextLayoutManager(const ContextContainer::Shared &contextContainer)
-      : contextContainer_(contextContainer){};
+  TextLayoutManager(const ContextContainer::Shared &contextContainer);
   ~TextLayoutManager();
 
   /*
-   * Measures `attributedStringBox` using native text rendering infrastructure.
+   * Measures `attributedStringBox` using the font metrics.
    */
   TextMeasurement measure(
       AttributedStringBox attributedStringBox,
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Measures a batch of attributed strings, returning a measurement for each
+   * request (in the same order). Equivalent to calling `measure` for each of
+   * them, but the strings which aren't cached are measured together.
+   */
+  std::vector<TextMeasurement> measureBatch(
+      std::vector<TextMeasureRequest> const &requests) const;
+
+  /*
+   * Measures lines of `attributedString` laid out in a box of given `size`.
+   */
+  LinesMeasurements measureLines(
+      AttributedString attributedString,
+      ParagraphAttributes paragraphAttributes,
+      Size size) const;
+
+  /*
+   * Measures lines of a batch of attributed strings, returning measurements
+   * for each request (in the same order).
+   */
+  std::vector<LinesMeasurements> measureLinesBatch(
+      std::vector<LinesMeasureRequest> const &requests) const;
+
   /*
    * Returns an opaque pointer to platform-specific TextLayoutManager.
    * Is used on a native views layer to delegate text rendering to the manager.
    */
   void *getNativeTextLayoutManager() const;
 
+  /*
+   * Returns hit and miss counters of the text measure cache.
+   */
+  TextMeasureCache::Stats getMeasureCacheStats() const;
+
  private:
-  void *self_;
+  TextMeasurement doMeasure(
+      AttributedString const &attributedString,
+      ParagraphAttributes const &paragraphAttributes,
+      LayoutConstraints const &layoutConstraints) const;
+
+  void *self_{nullptr};
 
   ContextContainer::Shared contextContainer_;
+  FontMetrics::Shared fontMetrics_;
+  TextMeasureCache measureCache_;
+  std::shared_ptr<PersistentTextMeasureCache> persistentMeasureCache_;
 };
 
 } // namespace react
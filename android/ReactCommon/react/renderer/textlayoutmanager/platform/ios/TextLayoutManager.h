@@ -12,6 +12,8 @@
 #include <react/renderer/attributedstring/AttributedStringBox.h>
 #include <react/renderer/attributedstring/ParagraphAttributes.h>
 #include <react/renderer/core/LayoutConstraints.h>
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
+#include <react/renderer/textlayoutmanager/TextMeasureBatch.h>
 #include <react/renderer/textlayoutmanager/TextMeasureCache.h>
 #include <react/utils/ContextContainer.h>
 
@@ -39,6 +41,14 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       LayoutConstraints layoutConstraints) const;
 
+  /*
+   * Measures a batch of attributed strings, returning a measurement for each
+   * request (in the same order). Equivalent to calling `measure` for each of
+   * them, but the strings which aren't cached are measured together.
+   */
+  std::vector<TextMeasurement> measureBatch(
+      std::vector<TextMeasureRequest> const &requests) const;
+
   /*
    * Measures lines of `attributedString` using native text rendering
    * infrastructure.
@@ -48,15 +58,28 @@ class TextLayoutManager {
       ParagraphAttributes paragraphAttributes,
       Size size) const;
 
+  /*
+   * Measures lines of a batch of attributed strings, returning measurements
+   * for each request (in the same order).
+   */
+  std::vector<LinesMeasurements> measureLinesBatch(
+      std::vector<LinesMeasureRequest> const &requests) const;
+
   /*
    * Returns an opaque pointer to platform-specific TextLayoutManager.
    * Is used on a native views layer to delegate text rendering to the manager.
    */
   std::shared_ptr<void> getNativeTextLayoutManager() const;
 
+  /*
+   * Returns hit and miss counters of the text measure cache.
+   */
+  TextMeasureCache::Stats getMeasureCacheStats() const;
+
  private:
   std::shared_ptr<void> self_;
-  TextMeasureCache measureCache_{};
+  TextMeasureCache measureCache_;
+  std::shared_ptr<PersistentTextMeasureCache> persistentMeasureCache_;
 };
 
 } // namespace react
@@ -14,6 +14,8 @@ namespace facebook {
 namespace react {
 
 TextLayoutManager::TextLayoutManager(ContextContainer::Shared const &contextContainer)
+    : measureCache_(getTextMeasureCacheSizeCap(contextContainer)),
+      persistentMeasureCache_(PersistentTextMeasureCache::shared(contextContainer))
 {
   self_ = wrapManagedObject([RCTTextLayoutManager new]);
 }
@@ -24,6 +26,11 @@ std::shared_ptr<void> TextLayoutManager::getNativeTextLayoutManager() const
   return self_;
 }
 
+TextMeasureCache::Stats TextLayoutManager::getMeasureCacheStats() const
+{
+  return measureCache_.getStats();
+}
+
 TextMeasurement TextLayoutManager::measure(
     AttributedStringBox attributedStringBox,
     ParagraphAttributes paragraphAttributes,
@@ -39,9 +46,11 @@ TextMeasurement TextLayoutManager::measure(
 
       measurement = measureCache_.get(
           {attributedString, paragraphAttributes, layoutConstraints}, [&](TextMeasureCacheKey const &key) {
-            return [textLayoutManager measureAttributedString:attributedString
-                                          paragraphAttributes:paragraphAttributes
-                                            layoutConstraints:layoutConstraints];
+            return measureWithPersistentCache(persistentMeasureCache_.get(), key, [&] {
+              return [textLayoutManager measureAttributedString:attributedString
+                                            paragraphAttributes:paragraphAttributes
+                                              layoutConstraints:layoutConstraints];
+            });
           });
       break;
     }
@@ -62,6 +71,19 @@ TextMeasurement TextLayoutManager::measure(
   return measurement;
 }
 
+std::vector<TextMeasurement> TextLayoutManager::measureBatch(std::vector<TextMeasureRequest> const &requests) const
+{
+  // Measuring doesn't cross any boundary here, so there is nothing to gain
+  // from measuring the strings together.
+  auto measurements = std::vector<TextMeasurement>{};
+  measurements.reserve(requests.size());
+  for (auto const &request : requests) {
+    measurements.push_back(
+        measure(AttributedStringBox{request.attributedString}, request.paragraphAttributes, request.layoutConstraints));
+  }
+  return measurements;
+}
+
 LinesMeasurements TextLayoutManager::measureLines(
     AttributedString attributedString,
     ParagraphAttributes paragraphAttributes,
@@ -73,5 +95,16 @@ LinesMeasurements TextLayoutManager::measureLines(
                                                    size:{size.width, size.height}];
 }
 
+std::vector<LinesMeasurements> TextLayoutManager::measureLinesBatch(
+    std::vector<LinesMeasureRequest> const &requests) const
+{
+  auto linesMeasurements = std::vector<LinesMeasurements>{};
+  linesMeasurements.reserve(requests.size());
+  for (auto const &request : requests) {
+    linesMeasurements.push_back(measureLines(request.attributedString, request.paragraphAttributes, request.size));
+  }
+  return linesMeasurements;
+}
+
 } // namespace react
 } // namespace facebook
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <dirent.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <react/renderer/textlayoutmanager/PersistentTextMeasureCache.h>
+
+using namespace facebook::react;
+
+static TextMeasureCacheKey keyWithString(std::string const &string) {
+  auto fragment = AttributedString::Fragment{};
+  fragment.string = string;
+  fragment.textAttributes.fontSize = 12;
+
+  auto key = TextMeasureCacheKey{};
+  key.attributedString.appendFragment(fragment);
+  key.layoutConstraints.maximumSize = Size{100, 100};
+  return key;
+}
+
+static std::string temporaryPath() {
+  auto path = testing::TempDir() + "PersistentTextMeasureCacheTest";
+  std::remove(path.c_str());
+  return path;
+}
+
+static ContextContainer::Shared contextContainerWithCache(
+    std::string const &path,
+    int64_t fontFingerprint) {
+  auto contextContainer = std::make_shared<ContextContainer const>();
+  contextContainer->insert("TextMeasureCachePath", path);
+  contextContainer->insert("TextMeasureCacheFontFingerprint", fontFingerprint);
+  return contextContainer;
+}
+
+static std::vector<std::string> filesStartingWith(
+    std::string const &directory,
+    std::string const &prefix) {
+  auto files = std::vector<std::string>{};
+  auto dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return files;
+  }
+  while (auto entry = readdir(dir)) {
+    auto name = std::string{entry->d_name};
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      files.push_back(name);
+    }
+  }
+  closedir(dir);
+  return files;
+}
+
+TEST(PersistentTextMeasureCacheTest, testMeasurementsSurviveReload) {
+  auto path = temporaryPath();
+
+  {
+    auto cache = PersistentTextMeasureCache{path, 42, 4096};
+    EXPECT_FALSE(cache.load());
+    EXPECT_FALSE(cache.get(keyWithString("Hello")));
+
+    cache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+    EXPECT_EQ(*cache.get(keyWithString("Hello")), (Size{30, 15}));
+    EXPECT_TRUE(cache.save());
+  }
+
+  {
+    auto cache = PersistentTextMeasureCache{path, 42, 4096};
+    EXPECT_TRUE(cache.load());
+    EXPECT_EQ(*cache.get(keyWithString("Hello")), (Size{30, 15}));
+    EXPECT_FALSE(cache.get(keyWithString("World")));
+
+    // Loaded measurements are written again together with the new ones.
+    cache.record(keyWithString("World"), TextMeasurement{{40, 15}, {}});
+    EXPECT_TRUE(cache.save());
+  }
+
+  {
+    auto cache = PersistentTextMeasureCache{path, 42, 4096};
+    EXPECT_TRUE(cache.load());
+    EXPECT_EQ(*cache.get(keyWithString("Hello")), (Size{30, 15}));
+    EXPECT_EQ(*cache.get(keyWithString("World")), (Size{40, 15}));
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(PersistentTextMeasureCacheTest, testFilesForOtherFontsAreIgnored) {
+  auto path = temporaryPath();
+
+  {
+    auto cache = PersistentTextMeasureCache{path, 42, 4096};
+    cache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+    EXPECT_TRUE(cache.save());
+  }
+
+  auto cache = PersistentTextMeasureCache{path, 43, 4096};
+  EXPECT_FALSE(cache.load());
+  EXPECT_FALSE(cache.get(keyWithString("Hello")));
+
+  std::remove(path.c_str());
+}
+
+TEST(PersistentTextMeasureCacheTest, testDamagedFilesAreIgnored) {
+  auto path = temporaryPath();
+
+  {
+    auto cache = PersistentTextMeasureCache{path, 42, 4096};
+    cache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+    EXPECT_TRUE(cache.save());
+  }
+
+  auto file = std::fopen(path.c_str(), "r+b");
+  ASSERT_NE(file, nullptr);
+  std::fseek(file, -1, SEEK_END);
+  std::fputc(0x7F, file);
+  std::fclose(file);
+
+  auto cache = PersistentTextMeasureCache{path, 42, 4096};
+  EXPECT_FALSE(cache.load());
+  EXPECT_FALSE(cache.get(keyWithString("Hello")));
+
+  std::remove(path.c_str());
+}
+
+TEST(PersistentTextMeasureCacheTest, testSizeBudget) {
+  auto path = temporaryPath();
+
+  {
+    // Enough for the header and two entries.
+    auto cache = PersistentTextMeasureCache{path, 42, 80};
+    for (auto string : {"a", "b", "c", "d"}) {
+      cache.record(keyWithString(string), TextMeasurement{{10, 10}, {}});
+    }
+    EXPECT_TRUE(cache.save());
+  }
+
+  auto cache = PersistentTextMeasureCache{path, 42, 80};
+  EXPECT_TRUE(cache.load());
+  auto count = 0;
+  for (auto string : {"a", "b", "c", "d"}) {
+    count += cache.get(keyWithString(string)) ? 1 : 0;
+  }
+  EXPECT_EQ(count, 2);
+
+  std::remove(path.c_str());
+}
+
+TEST(PersistentTextMeasureCacheTest, testAttachmentsAreNotStored) {
+  auto cache = PersistentTextMeasureCache{temporaryPath(), 42, 4096};
+
+  auto key = keyWithString("Hello");
+  auto attachment = AttributedString::Fragment{};
+  attachment.string = AttributedString::Fragment::AttachmentCharacter();
+  key.attributedString.appendFragment(attachment);
+
+  cache.record(key, TextMeasurement{{30, 15}, {}});
+  EXPECT_FALSE(cache.get(key));
+}
+
+TEST(PersistentTextMeasureCacheTest, testRecordedMeasurementsAreCapped) {
+  // Enough for the header and two entries.
+  auto cache = PersistentTextMeasureCache{temporaryPath(), 42, 80};
+  for (auto string : {"a", "b", "c"}) {
+    cache.record(keyWithString(string), TextMeasurement{{10, 10}, {}});
+  }
+
+  EXPECT_TRUE(cache.get(keyWithString("a")));
+  EXPECT_TRUE(cache.get(keyWithString("b")));
+  EXPECT_FALSE(cache.get(keyWithString("c")));
+
+  // Recorded measurements can still be updated.
+  cache.record(keyWithString("a"), TextMeasurement{{20, 10}, {}});
+  EXPECT_EQ(*cache.get(keyWithString("a")), (Size{20, 10}));
+}
+
+TEST(PersistentTextMeasureCacheTest, testKeysDifferingLayoutWiseDontMatch) {
+  auto cache = PersistentTextMeasureCache{temporaryPath(), 42, 4096};
+  cache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+
+  auto equivalentKey = keyWithString("Hello");
+  equivalentKey.attributedString.getFragments()[0]
+      .textAttributes.foregroundColor = colorFromComponents({1, 0, 0, 1});
+  equivalentKey.layoutConstraints.maximumSize.height = 200;
+  EXPECT_EQ(*cache.get(equivalentKey), (Size{30, 15}));
+
+  auto biggerFontKey = keyWithString("Hello");
+  biggerFontKey.attributedString.getFragments()[0].textAttributes.fontSize = 14;
+  EXPECT_FALSE(cache.get(biggerFontKey));
+
+  auto narrowerKey = keyWithString("Hello");
+  narrowerKey.layoutConstraints.maximumSize.width = 50;
+  EXPECT_FALSE(cache.get(narrowerKey));
+
+  auto singleLineKey = keyWithString("Hello");
+  singleLineKey.paragraphAttributes.maximumNumberOfLines = 1;
+  EXPECT_FALSE(cache.get(singleLineKey));
+}
+
+TEST(PersistentTextMeasureCacheTest, testSharedCacheIsReused) {
+  auto path = temporaryPath();
+
+  EXPECT_EQ(
+      PersistentTextMeasureCache::shared(
+          std::make_shared<ContextContainer const>()),
+      nullptr);
+
+  auto cache = PersistentTextMeasureCache::shared(
+      contextContainerWithCache(path, 42));
+  ASSERT_NE(cache, nullptr);
+
+  /* Text layout managers created with the same configuration share it. */
+  EXPECT_EQ(
+      PersistentTextMeasureCache::shared(contextContainerWithCache(path, 42)),
+      cache);
+
+  cache->record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+  EXPECT_TRUE(PersistentTextMeasureCache::saveShared());
+
+  /* A new configuration replaces the shared cache. */
+  auto otherCache = PersistentTextMeasureCache::shared(
+      contextContainerWithCache(path, 43));
+  ASSERT_NE(otherCache, nullptr);
+  EXPECT_NE(otherCache, cache);
+  EXPECT_FALSE(otherCache->get(keyWithString("Hello")));
+
+  std::remove(path.c_str());
+}
+
+TEST(PersistentTextMeasureCacheTest, testConcurrentSavesLeaveNoTemporaryFiles) {
+  auto path = temporaryPath();
+  auto fileName = std::string{"PersistentTextMeasureCacheTest"};
+
+  /* Separate instances, as in separate processes, writing the same file. */
+  auto cache = PersistentTextMeasureCache{path, 42, 4096};
+  auto otherCache = PersistentTextMeasureCache{path, 42, 4096};
+  cache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+  otherCache.record(keyWithString("Hello"), TextMeasurement{{30, 15}, {}});
+
+  auto threads = std::vector<std::thread>{};
+  for (auto instance : {&cache, &otherCache}) {
+    threads.emplace_back([instance]() {
+      for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(instance->save());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  auto loadedCache = PersistentTextMeasureCache{path, 42, 4096};
+  EXPECT_TRUE(loadedCache.load());
+  EXPECT_EQ(*loadedCache.get(keyWithString("Hello")), (Size{30, 15}));
+
+  EXPECT_EQ(
+      filesStartingWith(testing::TempDir(), fileName),
+      std::vector<std::string>{fileName});
+
+  std::remove(path.c_str());
+}
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <limits>
 #include <memory>
 
 #include <gtest/gtest.h>
@@ -16,3 +17,171 @@ using namespace facebook::react;
 TEST(TextLayoutManagerTest, testSomething) {
   // TODO:
 }
+
+static AttributedString attributedStringWithFragments(
+    std::vector<std::string> const &strings,
+    Float fontSize = 10) {
+  auto attributedString = AttributedString{};
+  for (auto const &string : strings) {
+    auto fragment = AttributedString::Fragment{};
+    fragment.string = string;
+    fragment.textAttributes.fontSize = fontSize;
+    attributedString.appendFragment(fragment);
+  }
+  return attributedString;
+}
+
+static std::shared_ptr<ContextContainer const> monospaceContextContainer() {
+  // Every glyph is 1 em wide, lines are 1.5 em high.
+  auto fontMetrics = std::make_shared<FontMetrics>();
+  fontMetrics->ascent = 1;
+  fontMetrics->descent = 0.5;
+  fontMetrics->lineHeight = 1.5;
+  fontMetrics->defaultAdvance = 1;
+  fontMetrics->setAdvance(' ', 1);
+
+  auto contextContainer = std::make_shared<ContextContainer>();
+  contextContainer->insert("FontMetrics", FontMetrics::Shared{fontMetrics});
+  return contextContainer;
+}
+
+static LayoutConstraints layoutConstraintsWithMaximumWidth(Float width) {
+  return LayoutConstraints{
+      {0, 0}, {width, std::numeric_limits<Float>::infinity()}};
+}
+
+TEST(TextLayoutManagerTest, testMeasureSingleLine) {
+  auto textLayoutManager = TextLayoutManager{monospaceContextContainer()};
+
+  auto measurement = textLayoutManager.measure(
+      AttributedStringBox{attributedStringWithFragments({"Hello"})},
+      ParagraphAttributes{},
+      layoutConstraintsWithMaximumWidth(1000));
+
+  EXPECT_EQ(measurement.size, (Size{50, 15}));
+}
+
+TEST(TextLayoutManagerTest, testGreedyLineBreaking) {
+  auto textLayoutManager = TextLayoutManager{monospaceContextContainer()};
+  auto attributedString =
+      attributedStringWithFragments({"aaa bb ", "cccc dddddddd"});
+
+  auto linesMeasurements = textLayoutManager.measureLines(
+      attributedString, ParagraphAttributes{}, Size{65, 1000});
+
+  ASSERT_EQ(linesMeasurements.size(), 4);
+  EXPECT_EQ(linesMeasurements[0].text, "aaa bb ");
+  EXPECT_EQ(linesMeasurements[0].frame, (Rect{{0, 0}, {60, 15}}));
+  EXPECT_EQ(linesMeasurements[1].text, "cccc ");
+  EXPECT_EQ(linesMeasurements[1].frame, (Rect{{0, 15}, {40, 15}}));
+  // Words longer than a line are broken anywhere.
+  EXPECT_EQ(linesMeasurements[2].text, "dddddd");
+  EXPECT_EQ(linesMeasurements[3].text, "dd");
+  EXPECT_EQ(linesMeasurements[3].ascender, 10);
+  EXPECT_EQ(linesMeasurements[3].descender, 5);
+
+  auto measurement = textLayoutManager.measure(
+      AttributedStringBox{attributedString},
+      ParagraphAttributes{},
+      layoutConstraintsWithMaximumWidth(65));
+  EXPECT_EQ(measurement.size, (Size{60, 60}));
+}
+
+TEST(TextLayoutManagerTest, testMaximumNumberOfLines) {
+  auto textLayoutManager = TextLayoutManager{monospaceContextContainer()};
+  auto attributedString = attributedStringWithFragments({"aaa bbb ccc"});
+
+  auto paragraphAttributes = ParagraphAttributes{};
+  paragraphAttributes.maximumNumberOfLines = 2;
+  paragraphAttributes.ellipsizeMode = EllipsizeMode::Tail;
+
+  auto linesMeasurements = textLayoutManager.measureLines(
+      attributedString, paragraphAttributes, Size{30, 1000});
+  ASSERT_EQ(linesMeasurements.size(), 2);
+  EXPECT_EQ(linesMeasurements[1].text, u8"bb…");
+
+  paragraphAttributes.maximumNumberOfLines = 1;
+  paragraphAttributes.ellipsizeMode = EllipsizeMode::Head;
+  linesMeasurements = textLayoutManager.measureLines(
+      attributedString, paragraphAttributes, Size{50, 1000});
+  ASSERT_EQ(linesMeasurements.size(), 1);
+  EXPECT_EQ(linesMeasurements[0].text, u8"…ccc");
+
+  paragraphAttributes.ellipsizeMode = EllipsizeMode::Middle;
+  linesMeasurements = textLayoutManager.measureLines(
+      attributedString, paragraphAttributes, Size{50, 1000});
+  EXPECT_EQ(linesMeasurements[0].text, u8"aa…cc");
+
+  paragraphAttributes.ellipsizeMode = EllipsizeMode::Clip;
+  linesMeasurements = textLayoutManager.measureLines(
+      attributedString, paragraphAttributes, Size{50, 1000});
+  EXPECT_EQ(linesMeasurements[0].text, "aaa ");
+}
+
+TEST(TextLayoutManagerTest, testAttachments) {
+  auto textLayoutManager = TextLayoutManager{monospaceContextContainer()};
+  auto attributedString = attributedStringWithFragments({"aa"});
+
+  auto attachment = AttributedString::Fragment{};
+  attachment.string = AttributedString::Fragment::AttachmentCharacter();
+  attachment.parentShadowView.layoutMetrics.frame.size = {20, 20};
+  attributedString.appendFragment(attachment);
+  attributedString.appendAttributedString(
+      attributedStringWithFragments({"bb"}));
+
+  auto measurement = textLayoutManager.measure(
+      AttributedStringBox{attributedString},
+      ParagraphAttributes{},
+      layoutConstraintsWithMaximumWidth(1000));
+
+  // The attachment sits on the baseline and makes the line taller.
+  EXPECT_EQ(measurement.size, (Size{60, 25}));
+  ASSERT_EQ(measurement.attachments.size(), 1);
+  EXPECT_EQ(measurement.attachments[0].frame, (Rect{{20, 0}, {20, 20}}));
+  EXPECT_FALSE(measurement.attachments[0].isClipped);
+}
+
+TEST(TextLayoutManagerTest, testMeasureBatch) {
+  auto textLayoutManager = TextLayoutManager{monospaceContextContainer()};
+
+  auto hello = attributedStringWithFragments({"Hello"});
+  auto helloWorld = attributedStringWithFragments({"Hello World"});
+
+  // Measured one by one, "Hello" is cached.
+  auto helloMeasurement = textLayoutManager.measure(
+      AttributedStringBox{hello}, {}, layoutConstraintsWithMaximumWidth(1000));
+
+  auto requests = std::vector<TextMeasureRequest>{
+      {helloWorld, {}, layoutConstraintsWithMaximumWidth(1000)},
+      {hello, {}, layoutConstraintsWithMaximumWidth(1000)},
+      {helloWorld, {}, layoutConstraintsWithMaximumWidth(60)},
+      {helloWorld, {}, layoutConstraintsWithMaximumWidth(1000)}};
+
+  auto missCount = textLayoutManager.getMeasureCacheStats().missCount;
+  auto measurements = textLayoutManager.measureBatch(requests);
+  ASSERT_EQ(measurements.size(), requests.size());
+
+  EXPECT_EQ(measurements[0].size, (Size{110, 15}));
+  EXPECT_EQ(measurements[1].size, helloMeasurement.size);
+  EXPECT_EQ(measurements[2].size, (Size{50, 30}));
+  EXPECT_EQ(measurements[3].size, measurements[0].size);
+  // The repeated request is measured once and counts as a hit.
+  EXPECT_EQ(
+      textLayoutManager.getMeasureCacheStats().missCount - missCount, 2);
+
+  // The batch filled the cache.
+  missCount = textLayoutManager.getMeasureCacheStats().missCount;
+  auto measurement = textLayoutManager.measure(
+      AttributedStringBox{helloWorld},
+      {},
+      layoutConstraintsWithMaximumWidth(60));
+  EXPECT_EQ(measurement.size, measurements[2].size);
+  EXPECT_EQ(textLayoutManager.getMeasureCacheStats().missCount, missCount);
+
+  auto linesMeasurements = textLayoutManager.measureLinesBatch(
+      {{helloWorld, {}, measurements[0].size},
+       {helloWorld, {}, measurements[2].size}});
+  ASSERT_EQ(linesMeasurements.size(), 2);
+  EXPECT_EQ(linesMeasurements[0].size(), 1);
+  EXPECT_EQ(linesMeasurements[1].size(), 2);
+}
@@ -140,7 +140,8 @@ ShadowNode::Shared UIManager::getNewestCloneOfShadowNode(
   auto ancestorShadowNode = ShadowNode::Shared{};
   shadowTreeRegistry_.visit(
       shadowNode.getSurfaceId(), [&](ShadowTree const &shadowTree) {
-        ancestorShadowNode = shadowTree.getCurrentRevision().rootShadowNode;
+        ancestorShadowNode =
+            shadowTree.getCurrentLaidOutRevision().rootShadowNode;
       });
 
   if (!ancestorShadowNode) {
@@ -177,7 +178,7 @@ LayoutMetrics UIManager::getRelativeLayoutMetrics(
     shadowTreeRegistry_.visit(
         shadowNode.getSurfaceId(), [&](ShadowTree const &shadowTree) {
           owningAncestorShadowNode =
-              shadowTree.getCurrentRevision().rootShadowNode;
+              shadowTree.getCurrentLaidOutRevision().rootShadowNode;
           ancestorShadowNode = owningAncestorShadowNode.get();
         });
   } else {
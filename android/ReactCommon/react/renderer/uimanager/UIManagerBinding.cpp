@@ -130,10 +130,10 @@ void UIManagerBinding::dispatchEvent(
     jsi::Runtime &runtime,
     EventTarget const *eventTarget,
     std::string const &type,
-    ValueFactory const &payloadFactory) const {
+    EventPayload const &eventPayload) const {
   SystraceSection s("UIManagerBinding::dispatchEvent");
 
-  auto payload = payloadFactory(runtime);
+  auto payload = eventPayload.toValue(runtime);
 
   // If a payload is null, the factory has decided to cancel the event
   if (payload.isNull()) {
@@ -9,6 +9,7 @@
 
 #include <folly/dynamic.h>
 #include <jsi/jsi.h>
+#include <react/renderer/core/EventPayload.h>
 #include <react/renderer/core/RawValue.h>
 #include <react/renderer/uimanager/UIManager.h>
 #include <react/renderer/uimanager/primitives.h>
@@ -64,7 +65,7 @@ class UIManagerBinding : public jsi::HostObject {
       jsi::Runtime &runtime,
       EventTarget const *eventTarget,
       std::string const &type,
-      ValueFactory const &payloadFactory) const;
+      EventPayload const &eventPayload) const;
 
   /*
    * Invalidates the binding and underlying UIManager.
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Small fixed-size memoization cache where every key maps to exactly one slot
+ * (a newer entry simply replaces an older one that occupies the same slot).
+ * The cache is NOT thread-safe; it's designed to be used as a `thread_local`
+ * instance which makes lookups lock-free and very cheap.
+ * `size` must be a power of two.
+ */
+template <
+    typename KeyT,
+    typename ValueT,
+    int size,
+    typename HashT = std::hash<KeyT>>
+class DirectMappedCache {
+  static_assert(
+      size > 0 && (size & (size - 1)) == 0,
+      "DirectMappedCache size must be a power of two.");
+
+ public:
+  /*
+   * Returns a value from the cache with a given key.
+   * If the value wasn't found in the cache, constructs the value using given
+   * generator function, stores it inside the cache and returns it.
+   */
+  template <typename GeneratorT>
+  ValueT const &get(KeyT const &key, GeneratorT &&generator) {
+    auto hash = HashT{}(key);
+    auto &entry = entries_[hash & (size - 1)];
+
+    if (entry.occupied && entry.hash == hash && entry.key == key) {
+      return entry.value;
+    }
+
+    entry.value = generator(key);
+    entry.key = key;
+    entry.hash = hash;
+    entry.occupied = true;
+    return entry.value;
+  }
+
+ private:
+  struct Entry {
+    bool occupied{false};
+    size_t hash{0};
+    KeyT key{};
+    ValueT value{};
+  };
+
+  std::array<Entry, size> entries_{};
+};
+
+} // namespace react
+} // namespace facebook
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <better/optional.h>
+
+namespace facebook {
+namespace react {
+
+/*
+ * Multi-producer single-consumer FIFO queue.
+ * Values are stored in a ring of `capacity` slots which producers claim with
+ * a compare-and-swap and consumer releases without taking any locks, so
+ * producers and the consumer never wait for each other. When the ring is full,
+ * values are appended to a growable overflow buffer protected by a mutex
+ * instead (until the consumer drains it), so pushing never fails.
+ * Values pushed by the same thread are popped in the order they were pushed.
+ * `push` can be called from any thread; `popAll` must not be called
+ * concurrently with itself. `capacity` must be a power of two.
+ */
+template <typename T, int capacity>
+class MPSCQueue final {
+  static_assert(
+      capacity > 0 && (capacity & (capacity - 1)) == 0,
+      "MPSCQueue capacity must be a power of two.");
+
+ public:
+  MPSCQueue() : cells_(new Cell[kCapacity]) {
+    for (size_t i = 0; i < kCapacity; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MPSCQueue(MPSCQueue const &) = delete;
+  MPSCQueue &operator=(MPSCQueue const &) = delete;
+
+  /*
+   * Appends `value` to the queue.
+   */
+  void push(T value) {
+    if (!isOverflowing_.load(std::memory_order_acquire)) {
+      auto position = enqueuePosition_.load(std::memory_order_relaxed);
+      while (true) {
+        auto &cell = cells_[position & kMask];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        auto difference =
+            static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (difference < 0) {
+          // The consumer hasn't released the slot yet; the ring is full.
+          break;
+        }
+
+        if (difference > 0) {
+          // Another producer claimed the slot.
+          position = enqueuePosition_.load(std::memory_order_relaxed);
+          continue;
+        }
+
+        if (enqueuePosition_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return;
+        }
+      }
+    }
+
+    // Once a value goes to the overflow buffer, the following ones have to go
+    // there as well (until the consumer drains it) to keep them in order.
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    isOverflowing_.store(true, std::memory_order_release);
+    overflow_.push_back(std::move(value));
+  }
+
+  /*
+   * Removes and returns all the values which were pushed completely.
+   */
+  std::vector<T> popAll() {
+    auto values = std::vector<T>{};
+
+    auto position = dequeuePosition_.load(std::memory_order_relaxed);
+    while (true) {
+      auto &cell = cells_[position & kMask];
+      if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+        // The slot is empty or its value is being written.
+        break;
+      }
+
+      values.push_back(std::move(*cell.value));
+      cell.value.reset();
+      cell.sequence.store(position + kCapacity, std::memory_order_release);
+      position++;
+    }
+    dequeuePosition_.store(position, std::memory_order_relaxed);
+
+    // Values in the overflow buffer were pushed after the ones in the ring, so
+    // the buffer can be drained only if nothing is left in the ring.
+    if (isOverflowing_.load(std::memory_order_acquire) &&
+        position == enqueuePosition_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(overflowMutex_);
+      // A producer may have claimed a slot of the ring since the check above
+      // and then pushed to the buffer; the value in the ring must go first.
+      // Values are pushed to the buffer under the lock, so checking again
+      // here sees every slot claimed before them.
+      if (position != enqueuePosition_.load(std::memory_order_acquire)) {
+        return values;
+      }
+
+      values.reserve(values.size() + overflow_.size());
+      for (auto &value : overflow_) {
+        values.push_back(std::move(value));
+      }
+      overflow_.clear();
+      isOverflowing_.store(false, std::memory_order_release);
+    }
+
+    return values;
+  }
+
+ private:
+  static constexpr size_t kCapacity = capacity;
+  static constexpr size_t kMask = kCapacity - 1;
+
+  struct Cell {
+    // Equals the position of the slot when it's free, and the position plus
+    // one when it holds a value.
+    std::atomic<size_t> sequence;
+    better::optional<T> value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> enqueuePosition_{0};
+  std::atomic<size_t> dequeuePosition_{0};
+
+  std::atomic<bool> isOverflowing_{false};
+  std::mutex overflowMutex_;
+  // Protected by `overflowMutex_`.
+  std::vector<T> overflow_;
+};
+
+} // namespace react
+} // namespace facebook
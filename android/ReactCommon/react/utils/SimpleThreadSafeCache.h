@@ -5,9 +5,19 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <better/optional.h>
 #include <folly/container/EvictingCacheMap.h>
@@ -17,29 +27,187 @@ namespace react {
 
 /*
  * Simple thread-safe LRU cache.
+ * Keys are distributed among `shardCount` independently locked shards (each
+ * one evicts its own least recently used entries), so lookups of different
+ * keys rarely contend. Values are generated outside of the lock: concurrent
+ * misses on different keys are computed in parallel, and concurrent misses on
+ * the same key wait for the single computation which is already in flight.
  */
-template <typename KeyT, typename ValueT, int maxSize>
+template <typename KeyT, typename ValueT, int maxSize, int shardCount = 8>
 class SimpleThreadSafeCache {
+  static_assert(shardCount > 0, "SimpleThreadSafeCache needs a shard.");
+
  public:
-  SimpleThreadSafeCache() : map_{maxSize} {}
+  /*
+   * Hit and miss counters of the cache.
+   * A miss which waited for a value generated by another caller counts as a
+   * hit since it didn't call the generator.
+   */
+  struct Stats {
+    size_t hitCount{0};
+    size_t missCount{0};
+  };
+
+  /*
+   * Creates a cache which stores up to (about) `sizeCap` values.
+   */
+  SimpleThreadSafeCache(size_t sizeCap = maxSize) {
+    auto shardSizeCap =
+        std::max(size_t{1}, (sizeCap + shardCount - 1) / shardCount);
+    for (auto &shard : shards_) {
+      shard = std::make_unique<Shard>(shardSizeCap);
+    }
+  }
 
   /*
    * Returns a value from the map with a given key.
    * If the value wasn't found in the cache, constructs the value using given
    * generator function, stores it inside a cache and returns it.
+   * The generator is called without holding any lock, but must not request
+   * the same key from the cache (that would never finish).
    * Can be called from any thread.
    */
-  ValueT get(const KeyT &key, std::function<ValueT(const KeyT &key)> generator)
-      const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iterator = map_.find(key);
-    if (iterator == map_.end()) {
+  template <typename GeneratorT>
+  ValueT get(const KeyT &key, GeneratorT &&generator) const {
+    auto hashedKey = HashedKey{key};
+    auto &shard = shardForKey(hashedKey);
+    auto promise = std::promise<ValueT>{};
+
+    {
+      std::unique_lock<std::mutex> lock(shard.mutex);
+      auto iterator = shard.map.find(hashedKey);
+      if (iterator != shard.map.end()) {
+        hitCount_.fetch_add(1, std::memory_order_relaxed);
+        return iterator->second;
+      }
+
+      auto inFlightIterator = shard.inFlight.find(hashedKey);
+      if (inFlightIterator != shard.inFlight.end()) {
+        auto future = inFlightIterator->second;
+        lock.unlock();
+        hitCount_.fetch_add(1, std::memory_order_relaxed);
+        return future.get();
+      }
+
+      hashedKey = hashedKey.makeOwning();
+      shard.inFlight.emplace(hashedKey, promise.get_future().share());
+    }
+
+    missCount_.fetch_add(1, std::memory_order_relaxed);
+
+    try {
       auto value = generator(key);
-      map_.set(key, value);
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.map.set(hashedKey, value);
+        shard.inFlight.erase(hashedKey);
+      }
+      promise.set_value(value);
       return value;
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.inFlight.erase(hashedKey);
+      }
+      promise.set_exception(std::current_exception());
+      throw;
     }
+  }
 
-    return iterator->second;
+  /*
+   * Returns values for all `keys` (in the same order), like calling
+   * `get(key, generator)` for each of them, but generating all the values
+   * missing from the cache with a single call of `generator`.
+   * `generator` is called with `std::vector<KeyT const *>` of the distinct
+   * missing keys (pointing into `keys`) and must return a value for each of
+   * them (in the same order). It's not called if all the values are cached
+   * or in flight. While it runs, the missing keys are in flight: concurrent
+   * `get` calls for them wait for it instead of generating the values again.
+   * Values in flight in other calls are waited for after `generator` returns.
+   * `ValueT` must be default-constructible.
+   * Can be called from any thread.
+   */
+  template <typename GeneratorT>
+  std::vector<ValueT> getBatch(
+      std::vector<KeyT> const &keys,
+      GeneratorT &&generator) const {
+    auto values = std::vector<ValueT>(keys.size());
+
+    // The keys which this call generates values for (reserved as in flight),
+    // and the indices of their values.
+    auto generatedKeys = std::vector<KeyT const *>{};
+    auto generatedHashedKeys = std::vector<HashedKey>{};
+    auto generatedIndices = std::vector<size_t>{};
+    auto promises = std::vector<std::promise<ValueT>>{};
+    // Values in flight (including the duplicates of generated keys) and the
+    // indices of their values.
+    auto waitedFutures =
+        std::vector<std::pair<size_t, std::shared_future<ValueT>>>{};
+
+    for (size_t i = 0; i < keys.size(); i++) {
+      auto hashedKey = HashedKey{keys[i]};
+      auto &shard = shardForKey(hashedKey);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      auto iterator = shard.map.find(hashedKey);
+      if (iterator != shard.map.end()) {
+        hitCount_.fetch_add(1, std::memory_order_relaxed);
+        values[i] = iterator->second;
+        continue;
+      }
+
+      auto inFlightIterator = shard.inFlight.find(hashedKey);
+      if (inFlightIterator != shard.inFlight.end()) {
+        hitCount_.fetch_add(1, std::memory_order_relaxed);
+        waitedFutures.emplace_back(i, inFlightIterator->second);
+        continue;
+      }
+
+      missCount_.fetch_add(1, std::memory_order_relaxed);
+      promises.emplace_back();
+      generatedKeys.push_back(&keys[i]);
+      generatedHashedKeys.push_back(hashedKey.makeOwning());
+      generatedIndices.push_back(i);
+      shard.inFlight.emplace(
+          generatedHashedKeys.back(), promises.back().get_future().share());
+    }
+
+    if (!generatedKeys.empty()) {
+      auto generatedValues = std::vector<ValueT>{};
+      try {
+        generatedValues = generator(generatedKeys);
+        assert(generatedValues.size() == generatedKeys.size());
+      } catch (...) {
+        for (size_t i = 0; i < generatedHashedKeys.size(); i++) {
+          {
+            auto &shard = shardForKey(generatedHashedKeys[i]);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.inFlight.erase(generatedHashedKeys[i]);
+          }
+          promises[i].set_exception(std::current_exception());
+        }
+        throw;
+      }
+
+      for (size_t i = 0; i < generatedHashedKeys.size(); i++) {
+        {
+          auto &shard = shardForKey(generatedHashedKeys[i]);
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          shard.map.set(generatedHashedKeys[i], generatedValues[i]);
+          shard.inFlight.erase(generatedHashedKeys[i]);
+        }
+        promises[i].set_value(generatedValues[i]);
+        values[generatedIndices[i]] = std::move(generatedValues[i]);
+      }
+    }
+
+    // Waiting only after fulfilling all the promises of this call, so calls
+    // waiting for each other's values cannot deadlock.
+    for (auto &pair : waitedFutures) {
+      values[pair.first] = pair.second.get();
+    }
+
+    return values;
   }
 
   /*
@@ -48,12 +216,16 @@ class SimpleThreadSafeCache {
    * Can be called from any thread.
    */
   better::optional<ValueT> get(const KeyT &key) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iterator = map_.find(key);
-    if (iterator == map_.end()) {
+    auto hashedKey = HashedKey{key};
+    auto &shard = shardForKey(hashedKey);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iterator = shard.map.find(hashedKey);
+    if (iterator == shard.map.end()) {
+      missCount_.fetch_add(1, std::memory_order_relaxed);
       return {};
     }
 
+    hitCount_.fetch_add(1, std::memory_order_relaxed);
     return iterator->second;
   }
 
@@ -62,13 +234,86 @@ class SimpleThreadSafeCache {
    * Can be called from any thread.
    */
   void set(const KeyT &key, const ValueT &value) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    map_.set(std::move(key), std::move(value));
+    auto hashedKey = HashedKey{key}.makeOwning();
+    auto &shard = shardForKey(hashedKey);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.map.set(hashedKey, value);
+  }
+
+  /*
+   * Returns hit and miss counters accumulated since the cache was created.
+   * Can be called from any thread.
+   */
+  Stats getStats() const {
+    auto stats = Stats{};
+    stats.hitCount = hitCount_.load(std::memory_order_relaxed);
+    stats.missCount = missCount_.load(std::memory_order_relaxed);
+    return stats;
   }
 
  private:
-  mutable folly::EvictingCacheMap<KeyT, ValueT> map_;
-  mutable std::mutex mutex_;
+  /*
+   * A key along with its hash, so the key is hashed once per call: the hash
+   * selects the shard and is reused by the hash tables of the shard.
+   * Keys used for lookups point to the key of the caller; keys stored in the
+   * cache own a copy of it.
+   */
+  class HashedKey {
+   public:
+    explicit HashedKey(const KeyT &key)
+        : key_(&key), hash_(std::hash<KeyT>{}(key)) {}
+
+    HashedKey makeOwning() const {
+      auto owningKey = *this;
+      owningKey.ownedKey_ = std::make_shared<KeyT const>(*key_);
+      owningKey.key_ = owningKey.ownedKey_.get();
+      return owningKey;
+    }
+
+    size_t getHash() const {
+      return hash_;
+    }
+
+    bool operator==(const HashedKey &rhs) const {
+      return hash_ == rhs.hash_ && *key_ == *rhs.key_;
+    }
+
+    struct Hasher {
+      size_t operator()(const HashedKey &hashedKey) const {
+        return hashedKey.hash_;
+      }
+    };
+
+   private:
+    std::shared_ptr<KeyT const> ownedKey_;
+    KeyT const *key_;
+    size_t hash_;
+  };
+
+  struct Shard {
+    Shard(size_t sizeCap) : map{sizeCap} {}
+
+    std::mutex mutex;
+    // Protected by `mutex`.
+    folly::EvictingCacheMap<HashedKey, ValueT, typename HashedKey::Hasher> map;
+    // Protected by `mutex`.
+    std::unordered_map<
+        HashedKey,
+        std::shared_future<ValueT>,
+        typename HashedKey::Hasher>
+        inFlight;
+  };
+
+  Shard &shardForKey(const HashedKey &hashedKey) const {
+    auto hash = hashedKey.getHash();
+    // Mixing in the high bits because hash tables inside of the shard rely on
+    // the low ones.
+    return *shards_[(hash ^ (hash >> 16)) % shardCount];
+  }
+
+  std::array<std::unique_ptr<Shard>, shardCount> shards_;
+  mutable std::atomic<size_t> hitCount_{0};
+  mutable std::atomic<size_t> missCount_{0};
 };
 
 } // namespace react
@@ -17,4 +17,10 @@ LOCAL_EXPORT_C_INCLUDES := $(LOCAL_C_INCLUDES)
 
 LOCAL_CFLAGS := -fexceptions -frtti -O3
 
+# Yoga events (which the layout profiler aggregates) are published only in
+# builds which opt in.
+ifeq ($(YOGA_ENABLE_EVENTS),true)
+  LOCAL_CFLAGS += -DYG_ENABLE_EVENTS
+endif
+
 include $(BUILD_STATIC_LIBRARY)
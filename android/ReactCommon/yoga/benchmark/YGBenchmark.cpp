@@ -0,0 +1,678 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Layout benchmarks for synthetic trees and for trees recorded with
+// `YGNodePrint` (`YGPrintOptionsLayout | YGPrintOptionsStyle |
+// YGPrintOptionsChildren`). Recorded trees are passed as
+// `--yoga_tree=<path>` (the flag can be repeated); nodes printed with
+// `has-custom-measure="true"` get a measure function that returns the recorded
+// size of the node.
+//
+// Every tree is benchmarked in three scenarios:
+//  - `cold`: every node is dirty, so no cached results can be used;
+//  - `warm`: the tree is clean and the width of the root alternates between
+//    two values, so every node is laid out from its cached results;
+//  - `dirty_leaf`: a single (deepest) leaf is dirty.
+
+#include <benchmark/benchmark.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Trees
+
+// Measured content of a leaf: either a text of given length or a recorded
+// size.
+struct Content {
+  float textLength;
+  YGSize recordedSize;
+};
+
+constexpr float kCharacterWidth = 7;
+constexpr float kLineHeight = 17;
+constexpr float kRootWidth = 400;
+
+YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const auto& content = *static_cast<Content*>(node->getContext());
+  const float textWidth = content.textLength * kCharacterWidth;
+  const float lineWidth = widthMode == YGMeasureModeUndefined
+      ? textWidth
+      : std::fmin(textWidth, width);
+  const float lineCount =
+      lineWidth > 0 ? std::ceil(textWidth / std::fmax(lineWidth, 1)) : 1;
+  float measuredHeight = lineCount * kLineHeight;
+  if (heightMode == YGMeasureModeAtMost) {
+    measuredHeight = std::fmin(measuredHeight, height);
+  }
+  return {lineWidth, measuredHeight};
+}
+
+YGSize measureRecorded(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const auto& content = *static_cast<Content*>(node->getContext());
+  YGSize size = content.recordedSize;
+  if (widthMode != YGMeasureModeUndefined) {
+    size.width = widthMode == YGMeasureModeExactly
+        ? width
+        : std::fmin(size.width, width);
+  }
+  if (heightMode != YGMeasureModeUndefined) {
+    size.height = heightMode == YGMeasureModeExactly
+        ? height
+        : std::fmin(size.height, height);
+  }
+  return size;
+}
+
+class Tree {
+public:
+  Tree() : config_(YGConfigNew()) {}
+
+  Tree(const Tree&) = delete;
+  Tree& operator=(const Tree&) = delete;
+
+  ~Tree() {
+    if (root_ != nullptr) {
+      YGNodeFreeRecursive(root_);
+    }
+    YGConfigFree(config_);
+  }
+
+  YGNodeRef newNode() {
+    return YGNodeNewWithConfig(config_);
+  }
+
+  YGNodeRef newTextNode(float textLength) {
+    auto node = newNode();
+    contents_.push_back({textLength, {0, 0}});
+    node->setContext(&contents_.back());
+    YGNodeSetMeasureFunc(node, measureText);
+    return node;
+  }
+
+  YGNodeRef newRecordedNode(YGSize recordedSize) {
+    auto node = newNode();
+    contents_.push_back({0, recordedSize});
+    node->setContext(&contents_.back());
+    YGNodeSetMeasureFunc(node, measureRecorded);
+    return node;
+  }
+
+  YGNodeRef root() const {
+    return root_;
+  }
+
+  void setRoot(YGNodeRef root) {
+    root_ = root;
+  }
+
+  // Returns the first of the deepest leaves.
+  YGNodeRef deepestLeaf() const {
+    YGNodeRef deepest = root_;
+    size_t maxDepth = 0;
+    std::function<void(YGNodeRef, size_t)> visit = [&](YGNodeRef node,
+                                                       size_t depth) {
+      if (YGNodeGetChildCount(node) == 0 && depth > maxDepth) {
+        deepest = node;
+        maxDepth = depth;
+      }
+      for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+        visit(YGNodeGetChild(node, i), depth + 1);
+      }
+    };
+    visit(root_, 0);
+    return deepest;
+  }
+
+private:
+  YGConfigRef config_;
+  YGNodeRef root_ = nullptr;
+  std::deque<Content> contents_;
+};
+
+using TreeFactory = std::function<std::unique_ptr<Tree>()>;
+
+// A chain of nested containers with padding.
+std::unique_ptr<Tree> buildDeepTree(int depth) {
+  auto tree = std::make_unique<Tree>();
+  auto root = tree->newNode();
+  auto parent = root;
+  for (int i = 0; i < depth; i++) {
+    auto node = tree->newNode();
+    YGNodeStyleSetPadding(node, YGEdgeAll, 0.1f);
+    YGNodeStyleSetFlexDirection(
+        node, i % 2 == 0 ? YGFlexDirectionRow : YGFlexDirectionColumn);
+    YGNodeInsertChild(parent, node, 0);
+    parent = node;
+  }
+  YGNodeInsertChild(parent, tree->newTextNode(20), 0);
+  tree->setRoot(root);
+  return tree;
+}
+
+// A single container with many flexible children.
+std::unique_ptr<Tree> buildWideTree(int width) {
+  auto tree = std::make_unique<Tree>();
+  auto root = tree->newNode();
+  for (int i = 0; i < width; i++) {
+    auto node = tree->newNode();
+    YGNodeStyleSetHeight(node, 10);
+    YGNodeStyleSetFlexGrow(node, 1);
+    YGNodeStyleSetMargin(node, YGEdgeVertical, 1);
+    YGNodeInsertChild(root, node, i);
+  }
+  tree->setRoot(root);
+  return tree;
+}
+
+// A wrapping row of cells, each of them containing a text.
+std::unique_ptr<Tree> buildWrapTree(int count) {
+  auto tree = std::make_unique<Tree>();
+  auto root = tree->newNode();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  YGNodeStyleSetAlignContent(root, YGAlignStretch);
+  for (int i = 0; i < count; i++) {
+    auto cell = tree->newNode();
+    YGNodeStyleSetWidthPercent(cell, 25 + (i % 3) * 10);
+    YGNodeStyleSetPadding(cell, YGEdgeAll, 4);
+    YGNodeInsertChild(cell, tree->newTextNode(5 + (i * 7) % 40), 0);
+    YGNodeInsertChild(root, cell, i);
+  }
+  tree->setRoot(root);
+  return tree;
+}
+
+// A container with many absolutely positioned children.
+std::unique_ptr<Tree> buildAbsoluteTree(int count) {
+  auto tree = std::make_unique<Tree>();
+  auto root = tree->newNode();
+  YGNodeStyleSetHeight(root, 800);
+  for (int i = 0; i < count; i++) {
+    auto node = tree->newNode();
+    YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute);
+    YGNodeStyleSetPositionPercent(node, YGEdgeLeft, (i * 13) % 90);
+    YGNodeStyleSetPositionPercent(node, YGEdgeTop, (i * 29) % 90);
+    YGNodeStyleSetWidthPercent(node, 10);
+    YGNodeInsertChild(node, tree->newTextNode(3 + i % 10), 0);
+    YGNodeInsertChild(root, node, i);
+  }
+  tree->setRoot(root);
+  return tree;
+}
+
+// A list of rows, each of them containing an image-like fixed size node and
+// a column with a title and a multiline text (a typical feed).
+std::unique_ptr<Tree> buildTextTree(int rowCount) {
+  auto tree = std::make_unique<Tree>();
+  auto root = tree->newNode();
+  for (int i = 0; i < rowCount; i++) {
+    auto row = tree->newNode();
+    YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+    YGNodeStyleSetPadding(row, YGEdgeAll, 8);
+
+    auto image = tree->newNode();
+    YGNodeStyleSetWidth(image, 48);
+    YGNodeStyleSetHeight(image, 48);
+    YGNodeStyleSetMargin(image, YGEdgeRight, 8);
+    YGNodeInsertChild(row, image, 0);
+
+    auto column = tree->newNode();
+    YGNodeStyleSetFlexGrow(column, 1);
+    YGNodeStyleSetFlexShrink(column, 1);
+    YGNodeInsertChild(column, tree->newTextNode(10 + i % 20), 0);
+    YGNodeInsertChild(column, tree->newTextNode(40 + (i * 37) % 160), 1);
+    YGNodeInsertChild(row, column, 1);
+
+    YGNodeInsertChild(root, row, i);
+  }
+  tree->setRoot(root);
+  return tree;
+}
+
+// YGNodePrint parsing
+
+template <typename Enum>
+bool parseEnum(
+    const std::string& string,
+    const char* (*toString)(Enum),
+    Enum& value) {
+  for (int i = 0; i < facebook::yoga::enums::count<Enum>(); i++) {
+    if (string == toString(static_cast<Enum>(i))) {
+      value = static_cast<Enum>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+YGValue parseValue(const std::string& string) {
+  if (string == "auto") {
+    return {0, YGUnitAuto};
+  }
+  char* end = nullptr;
+  const float number = std::strtof(string.c_str(), &end);
+  if (end == string.c_str()) {
+    return {0, YGUnitUndefined};
+  }
+  return {number, *end == '%' ? YGUnitPercent : YGUnitPoint};
+}
+
+using PointSetter = void (*)(YGNodeRef, float);
+using EdgeSetter = void (*)(YGNodeRef, YGEdge, float);
+
+void setValue(
+    YGNodeRef node,
+    const YGValue& value,
+    PointSetter setPoint,
+    PointSetter setPercent,
+    void (*setAuto)(YGNodeRef)) {
+  switch (value.unit) {
+    case YGUnitPoint:
+      setPoint(node, value.value);
+      break;
+    case YGUnitPercent:
+      setPercent(node, value.value);
+      break;
+    case YGUnitAuto:
+      if (setAuto != nullptr) {
+        setAuto(node);
+      }
+      break;
+    case YGUnitUndefined:
+      break;
+  }
+}
+
+void setEdgeValue(
+    YGNodeRef node,
+    const std::string& edgeName,
+    const YGValue& value,
+    EdgeSetter setPoint,
+    EdgeSetter setPercent,
+    void (*setAuto)(YGNodeRef, YGEdge)) {
+  YGEdge edge = YGEdgeAll;
+  if (!edgeName.empty() && !parseEnum(edgeName, YGEdgeToString, edge)) {
+    return;
+  }
+  switch (value.unit) {
+    case YGUnitPoint:
+      setPoint(node, edge, value.value);
+      break;
+    case YGUnitPercent:
+      if (setPercent != nullptr) {
+        setPercent(node, edge, value.value);
+      }
+      break;
+    case YGUnitAuto:
+      if (setAuto != nullptr) {
+        setAuto(node, edge);
+      }
+      break;
+    case YGUnitUndefined:
+      break;
+  }
+}
+
+void applyStyle(YGNodeRef node, const std::string& key, std::string value) {
+  // `YGNodePrint` prints percentages as `%%`.
+  const auto percent = value.find("%%");
+  if (percent != std::string::npos) {
+    value.erase(percent, 1);
+  }
+
+  const auto dash = key.find('-');
+  const auto prefix = key.substr(0, dash);
+  const auto suffix = dash == std::string::npos ? "" : key.substr(dash + 1);
+
+  if (key == "flex-direction") {
+    YGFlexDirection flexDirection;
+    if (parseEnum(value, YGFlexDirectionToString, flexDirection)) {
+      YGNodeStyleSetFlexDirection(node, flexDirection);
+    }
+  } else if (key == "justify-content") {
+    YGJustify justify;
+    if (parseEnum(value, YGJustifyToString, justify)) {
+      YGNodeStyleSetJustifyContent(node, justify);
+    }
+  } else if (
+      key == "align-items" || key == "align-content" || key == "align-self") {
+    YGAlign align;
+    if (parseEnum(value, YGAlignToString, align)) {
+      (key == "align-items"
+           ? YGNodeStyleSetAlignItems
+           : key == "align-content" ? YGNodeStyleSetAlignContent
+                                    : YGNodeStyleSetAlignSelf)(node, align);
+    }
+  } else if (key == "flex-wrap") {
+    YGWrap wrap;
+    if (parseEnum(value, YGWrapToString, wrap)) {
+      YGNodeStyleSetFlexWrap(node, wrap);
+    }
+  } else if (key == "overflow") {
+    YGOverflow overflow;
+    if (parseEnum(value, YGOverflowToString, overflow)) {
+      YGNodeStyleSetOverflow(node, overflow);
+    }
+  } else if (key == "display") {
+    YGDisplay display;
+    if (parseEnum(value, YGDisplayToString, display)) {
+      YGNodeStyleSetDisplay(node, display);
+    }
+  } else if (key == "position") {
+    YGPositionType positionType;
+    if (parseEnum(value, YGPositionTypeToString, positionType)) {
+      YGNodeStyleSetPositionType(node, positionType);
+    }
+  } else if (key == "flex-grow") {
+    YGNodeStyleSetFlexGrow(node, std::strtof(value.c_str(), nullptr));
+  } else if (key == "flex-shrink") {
+    YGNodeStyleSetFlexShrink(node, std::strtof(value.c_str(), nullptr));
+  } else if (key == "flex") {
+    YGNodeStyleSetFlex(node, std::strtof(value.c_str(), nullptr));
+  } else if (key == "flex-basis") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetFlexBasis,
+        YGNodeStyleSetFlexBasisPercent,
+        YGNodeStyleSetFlexBasisAuto);
+  } else if (key == "width") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetWidth,
+        YGNodeStyleSetWidthPercent,
+        YGNodeStyleSetWidthAuto);
+  } else if (key == "height") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetHeight,
+        YGNodeStyleSetHeightPercent,
+        YGNodeStyleSetHeightAuto);
+  } else if (key == "min-width") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetMinWidth,
+        YGNodeStyleSetMinWidthPercent,
+        nullptr);
+  } else if (key == "min-height") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetMinHeight,
+        YGNodeStyleSetMinHeightPercent,
+        nullptr);
+  } else if (key == "max-width") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetMaxWidth,
+        YGNodeStyleSetMaxWidthPercent,
+        nullptr);
+  } else if (key == "max-height") {
+    setValue(
+        node,
+        parseValue(value),
+        YGNodeStyleSetMaxHeight,
+        YGNodeStyleSetMaxHeightPercent,
+        nullptr);
+  } else if (prefix == "margin") {
+    setEdgeValue(
+        node,
+        suffix,
+        parseValue(value),
+        YGNodeStyleSetMargin,
+        YGNodeStyleSetMarginPercent,
+        YGNodeStyleSetMarginAuto);
+  } else if (prefix == "padding") {
+    setEdgeValue(
+        node,
+        suffix,
+        parseValue(value),
+        YGNodeStyleSetPadding,
+        YGNodeStyleSetPaddingPercent,
+        nullptr);
+  } else if (prefix == "border") {
+    setEdgeValue(
+        node,
+        suffix,
+        parseValue(value),
+        YGNodeStyleSetBorder,
+        nullptr,
+        nullptr);
+  } else if (
+      key == "left" || key == "right" || key == "top" || key == "bottom") {
+    setEdgeValue(
+        node,
+        key,
+        parseValue(value),
+        YGNodeStyleSetPosition,
+        YGNodeStyleSetPositionPercent,
+        nullptr);
+  }
+}
+
+// Calls `callback(key, value)` for every `key: value;` pair of a CSS-like
+// attribute value.
+template <typename Callback>
+void forEachDeclaration(const std::string& declarations, Callback callback) {
+  std::istringstream stream(declarations);
+  std::string declaration;
+  while (std::getline(stream, declaration, ';')) {
+    const auto colon = declaration.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    auto trim = [](const std::string& string) {
+      const auto begin = string.find_first_not_of(" \t\n");
+      const auto end = string.find_last_not_of(" \t\n");
+      return begin == std::string::npos
+          ? std::string{}
+          : string.substr(begin, end - begin + 1);
+    };
+    callback(
+        trim(declaration.substr(0, colon)), trim(declaration.substr(colon + 1)));
+  }
+}
+
+std::string attributeValue(const std::string& tag, const std::string& name) {
+  const auto begin = tag.find(name + "=\"");
+  if (begin == std::string::npos) {
+    return {};
+  }
+  const auto valueBegin = begin + name.size() + 2;
+  const auto valueEnd = tag.find('"', valueBegin);
+  return tag.substr(valueBegin, valueEnd - valueBegin);
+}
+
+// Builds a tree from `YGNodePrint` output. Anything outside of `<div>` tags
+// (e.g. log prefixes) is ignored.
+std::unique_ptr<Tree> parseTree(const std::string& source) {
+  auto tree = std::make_unique<Tree>();
+  std::vector<YGNodeRef> stack;
+  YGNodeRef root = nullptr;
+
+  size_t position = 0;
+  while (true) {
+    const auto open = source.find("<div", position);
+    const auto close = source.find("</div>", position);
+    if (open == std::string::npos && close == std::string::npos) {
+      break;
+    }
+
+    if (close < open) {
+      if (!stack.empty()) {
+        stack.pop_back();
+      }
+      position = close + 6;
+      continue;
+    }
+
+    const auto end = source.find('>', open);
+    if (end == std::string::npos) {
+      break;
+    }
+    const auto tag = source.substr(open, end - open);
+    position = end + 1;
+
+    YGSize recordedSize = {0, 0};
+    forEachDeclaration(
+        attributeValue(tag, "layout"),
+        [&](const std::string& key, const std::string& value) {
+          if (key == "width") {
+            recordedSize.width = std::strtof(value.c_str(), nullptr);
+          } else if (key == "height") {
+            recordedSize.height = std::strtof(value.c_str(), nullptr);
+          }
+        });
+
+    auto node = attributeValue(tag, "has-custom-measure") == "true"
+        ? tree->newRecordedNode(recordedSize)
+        : tree->newNode();
+    forEachDeclaration(
+        attributeValue(tag, "style"),
+        [&](const std::string& key, const std::string& value) {
+          applyStyle(node, key, value);
+        });
+
+    if (stack.empty()) {
+      if (root != nullptr) {
+        // Only the first tree of the output is used.
+        YGNodeFree(node);
+        break;
+      }
+      root = node;
+    } else {
+      auto parent = stack.back();
+      YGNodeInsertChild(parent, node, YGNodeGetChildCount(parent));
+    }
+    stack.push_back(node);
+  }
+
+  if (root == nullptr) {
+    return nullptr;
+  }
+  tree->setRoot(root);
+  return tree;
+}
+
+// Scenarios
+
+void calculateLayout(YGNodeRef root, float width) {
+  YGNodeCalculateLayout(root, width, YGUndefined, YGDirectionLTR);
+}
+
+void layoutCold(benchmark::State& state, const TreeFactory& factory) {
+  auto tree = factory();
+  for (auto _ : state) {
+    YGNodeMarkDirtyAndPropogateToDescendants(tree->root());
+    calculateLayout(tree->root(), kRootWidth);
+  }
+}
+
+void layoutWarm(benchmark::State& state, const TreeFactory& factory) {
+  auto tree = factory();
+  calculateLayout(tree->root(), kRootWidth);
+  calculateLayout(tree->root(), kRootWidth - 1);
+  size_t iteration = 0;
+  for (auto _ : state) {
+    calculateLayout(tree->root(), kRootWidth - (iteration++ % 2));
+  }
+}
+
+void layoutDirtyLeaf(benchmark::State& state, const TreeFactory& factory) {
+  auto tree = factory();
+  auto leaf = tree->deepestLeaf();
+  calculateLayout(tree->root(), kRootWidth);
+  size_t iteration = 0;
+  for (auto _ : state) {
+    if (YGNodeHasMeasureFunc(leaf)) {
+      YGNodeMarkDirty(leaf);
+    } else {
+      // Nodes without measure functions can only be dirtied by changes of
+      // their style.
+      YGNodeStyleSetMinHeight(leaf, iteration++ % 2);
+    }
+    calculateLayout(tree->root(), kRootWidth);
+  }
+}
+
+void registerTree(const std::string& name, const TreeFactory& factory) {
+  benchmark::RegisterBenchmark(
+      (name + "/cold").c_str(),
+      [factory](benchmark::State& state) { layoutCold(state, factory); });
+  benchmark::RegisterBenchmark(
+      (name + "/warm").c_str(),
+      [factory](benchmark::State& state) { layoutWarm(state, factory); });
+  benchmark::RegisterBenchmark(
+      (name + "/dirty_leaf").c_str(),
+      [factory](benchmark::State& state) { layoutDirtyLeaf(state, factory); });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  registerTree("deep_100", [] { return buildDeepTree(100); });
+  registerTree("wide_1000", [] { return buildWideTree(1000); });
+  registerTree("wrap_500", [] { return buildWrapTree(500); });
+  registerTree("absolute_500", [] { return buildAbsoluteTree(500); });
+  registerTree("text_200", [] { return buildTextTree(200); });
+
+  // Consuming our own flags before passing the rest to the library.
+  const std::string treeFlag = "--yoga_tree=";
+  int benchmarkArgc = 0;
+  for (int i = 0; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (argument.compare(0, treeFlag.size(), treeFlag) != 0) {
+      argv[benchmarkArgc++] = argv[i];
+      continue;
+    }
+
+    const auto path = argument.substr(treeFlag.size());
+    std::ifstream file(path);
+    std::stringstream source;
+    source << file.rdbuf();
+    const auto contents = source.str();
+    if (!file || parseTree(contents) == nullptr) {
+      fprintf(stderr, "Cannot load a Yoga tree from %s\n", path.c_str());
+      return 1;
+    }
+    registerTree(
+        "recorded:" + path, [contents] { return parseTree(contents); });
+  }
+
+  benchmark::Initialize(&benchmarkArgc, argv);
+  if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/CopyOnWrite.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include <thread>
+#include <vector>
+
+using facebook::yoga::detail::BlockCache;
+using facebook::yoga::detail::CopyOnWrite;
+
+namespace {
+
+// Counts its copies, so tests can tell whether a value was copied.
+struct Counted {
+  static int copyCount;
+
+  Counted() = default;
+  Counted(const Counted& other) : value{other.value} { copyCount++; }
+  Counted& operator=(const Counted& other) {
+    value = other.value;
+    copyCount++;
+    return *this;
+  }
+
+  int value = 0;
+};
+
+int Counted::copyCount = 0;
+
+} // namespace
+
+TEST(YogaTest, copy_on_write_default_values_share_a_block) {
+  Counted::copyCount = 0;
+  CopyOnWrite<Counted> a;
+  CopyOnWrite<Counted> b;
+
+  ASSERT_TRUE(a.isSharedWith(b));
+  ASSERT_EQ(0, a->value);
+
+  // The default block is never unique, so mutating a default value copies it
+  // instead of changing every default value.
+  a.mutate().value = 1;
+  ASSERT_EQ(1, Counted::copyCount);
+  ASSERT_FALSE(a.isSharedWith(b));
+  ASSERT_EQ(1, a->value);
+  ASSERT_EQ(0, b->value);
+  ASSERT_EQ(0, CopyOnWrite<Counted>{}->value);
+}
+
+TEST(YogaTest, copy_on_write_copies_share_until_mutated) {
+  CopyOnWrite<Counted> a;
+  a.mutate().value = 1;
+  Counted::copyCount = 0;
+
+  auto b = a;
+  ASSERT_TRUE(a.isSharedWith(b));
+  ASSERT_EQ(0, Counted::copyCount);
+
+  b.mutate().value = 2;
+  ASSERT_EQ(1, Counted::copyCount);
+  ASSERT_FALSE(a.isSharedWith(b));
+  ASSERT_EQ(1, a->value);
+  ASSERT_EQ(2, b->value);
+
+  // Both values are unique now, so they are mutated in place.
+  a.mutate().value = 3;
+  b.mutate().value = 4;
+  ASSERT_EQ(1, Counted::copyCount);
+  ASSERT_EQ(3, a->value);
+  ASSERT_EQ(4, b->value);
+}
+
+TEST(YogaTest, copy_on_write_set_assigns_unique_values_in_place) {
+  Counted value;
+  value.value = 5;
+
+  CopyOnWrite<Counted> a;
+  a.set(value);
+  auto b = a;
+  a.set(value);
+  ASSERT_FALSE(a.isSharedWith(b));
+
+  const auto block = &a.get();
+  a.set(value);
+  ASSERT_EQ(block, &a.get());
+  ASSERT_EQ(5, a->value);
+  ASSERT_EQ(5, b->value);
+}
+
+TEST(YogaTest, copy_on_write_assignment_and_move) {
+  CopyOnWrite<Counted> a;
+  a.mutate().value = 1;
+  CopyOnWrite<Counted> b;
+  b.mutate().value = 2;
+
+  b = a;
+  ASSERT_TRUE(a.isSharedWith(b));
+  ASSERT_EQ(1, b->value);
+
+  const auto& self = b;
+  b = self;
+  ASSERT_TRUE(a.isSharedWith(b));
+  ASSERT_EQ(1, b->value);
+
+  auto c = std::move(b);
+  ASSERT_TRUE(a.isSharedWith(c));
+  ASSERT_TRUE(b.isSharedWith(CopyOnWrite<Counted>{}));
+
+  CopyOnWrite<Counted> d;
+  d = std::move(c);
+  ASSERT_TRUE(a.isSharedWith(d));
+  ASSERT_EQ(1, d->value);
+}
+
+TEST(YogaTest, copy_on_write_reuses_blocks_freed_by_the_same_thread) {
+  const Counted* block = nullptr;
+  size_t cachedBlockCount = 0;
+  {
+    CopyOnWrite<Counted> a;
+    a.mutate().value = 1;
+    block = &a.get();
+    cachedBlockCount = CopyOnWrite<Counted>::cachedBlockCount();
+  }
+  ASSERT_EQ(cachedBlockCount + 1, CopyOnWrite<Counted>::cachedBlockCount());
+
+  CopyOnWrite<Counted> b;
+  b.mutate().value = 2;
+  ASSERT_EQ(block, &b.get());
+  ASSERT_EQ(cachedBlockCount, CopyOnWrite<Counted>::cachedBlockCount());
+}
+
+TEST(YogaTest, block_cache_is_bounded_and_released) {
+  BlockCache cache{};
+  std::vector<void*> blocks;
+  for (int i = 0; i < 4; i++) {
+    blocks.push_back(cache.allocate(16));
+  }
+  for (auto block : blocks) {
+    cache.deallocate(block, 2);
+  }
+  ASSERT_EQ(2u, cache.cachedBlockCount());
+
+  // The last cached block is reused first.
+  ASSERT_EQ(blocks[1], cache.allocate(16));
+  ASSERT_EQ(1u, cache.cachedBlockCount());
+
+  cache.release();
+  ASSERT_EQ(0u, cache.cachedBlockCount());
+
+  // Blocks freed after the cache was released are not cached anymore.
+  cache.deallocate(blocks[1], 2);
+  ASSERT_EQ(0u, cache.cachedBlockCount());
+}
+
+TEST(YogaTest, copy_on_write_values_can_be_freed_on_other_threads) {
+  constexpr int count = 1000;
+  std::vector<CopyOnWrite<Counted>> values(count);
+  for (int i = 0; i < count; i++) {
+    values[i].mutate().value = i;
+  }
+
+  std::vector<CopyOnWrite<Counted>> copies = values;
+  std::thread([&values]() {
+    // Blocks shared with `copies` are kept alive; the others are cached by
+    // this thread and released when it exits.
+    for (int i = 0; i < count; i++) {
+      values[i].mutate().value = -i;
+    }
+    values.clear();
+    ASSERT_LE(CopyOnWrite<Counted>::cachedBlockCount(), 256u);
+  }).join();
+
+  std::thread([&copies]() {
+    for (int i = 0; i < count; i++) {
+      ASSERT_EQ(i, copies[i]->value);
+    }
+    copies.clear();
+  }).join();
+}
+
+TEST(YogaTest, cloned_node_shares_style_and_layout_until_written) {
+  const auto node = YGNodeNew();
+  YGNodeStyleSetWidth(node, 100);
+  YGNodeCalculateLayout(node, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const auto clone = YGNodeClone(node);
+  ASSERT_EQ(&node->getStyle(), &clone->getStyle());
+  ASSERT_EQ(&node->getLayout(), &clone->getLayout());
+
+  YGNodeStyleSetWidth(clone, 100);
+  ASSERT_EQ(&node->getStyle(), &clone->getStyle());
+
+  YGNodeStyleSetWidth(clone, 50);
+  ASSERT_NE(&node->getStyle(), &clone->getStyle());
+  ASSERT_FLOAT_EQ(100, YGNodeStyleGetWidth(node).value);
+  ASSERT_FLOAT_EQ(50, YGNodeStyleGetWidth(clone).value);
+
+  YGNodeCalculateLayout(clone, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_NE(&node->getLayout(), &clone->getLayout());
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(node));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(clone));
+
+  YGNodeFree(clone);
+  YGNodeFree(node);
+}
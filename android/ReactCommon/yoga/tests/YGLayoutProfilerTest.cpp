@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/event.h>
+#include <yoga/event/profiler.h>
+
+#include <array>
+#include <mutex>
+
+using facebook::yoga::Event;
+using facebook::yoga::LayoutData;
+using facebook::yoga::LayoutPassReason;
+using facebook::yoga::LayoutProfiler;
+using facebook::yoga::LayoutType;
+
+namespace {
+
+// Aggregates the same events independently from the profiler.
+struct EventCounts {
+  std::mutex mutex;
+  bool isCounting = false;
+  size_t passCount = 0;
+  LayoutData totals = {};
+  std::array<int, 8> measureCallbackReasons = {};
+};
+
+EventCounts& eventCounts() {
+  static auto counts = []() {
+    auto counts = new EventCounts();
+    Event::subscribe([counts](
+                         const YGNode& node,
+                         Event::Type type,
+                         Event::Data data) {
+      std::lock_guard<std::mutex> lock(counts->mutex);
+      if (!counts->isCounting) {
+        return;
+      }
+      if (type == Event::LayoutPassEnd) {
+        const auto& layoutData = *data.get<Event::LayoutPassEnd>().layoutData;
+        counts->passCount++;
+        counts->totals.layouts += layoutData.layouts;
+        counts->totals.measures += layoutData.measures;
+        counts->totals.measureCallbacks += layoutData.measureCallbacks;
+        for (size_t i = 0; i < layoutData.nodeLayoutReasonsCount.size(); i++) {
+          for (size_t j = 0; j < layoutData.nodeLayoutReasonsCount[i].size();
+               j++) {
+            counts->totals.nodeLayoutReasonsCount[i][j] +=
+                layoutData.nodeLayoutReasonsCount[i][j];
+          }
+        }
+      } else if (type == Event::MeasureCallbackEnd) {
+        const auto reason = data.get<Event::MeasureCallbackEnd>().reason;
+        counts->measureCallbackReasons[static_cast<size_t>(reason)]++;
+      }
+    });
+    return counts;
+  }();
+  return *counts;
+}
+
+YGSize measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  return YGSize{widthMode == YGMeasureModeUndefined ? 120 : width, 20};
+}
+
+// A row with a flexible text, a stretched column with texts and an absolutely
+// positioned text, so measure callbacks are made for several reasons.
+YGNodeRef newTree(YGConfigRef config) {
+  const auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 300);
+
+  const auto flexible = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(flexible, 1);
+  YGNodeSetMeasureFunc(flexible, measureText);
+  YGNodeInsertChild(root, flexible, 0);
+
+  const auto column = YGNodeNewWithConfig(config);
+  for (uint32_t i = 0; i < 2; i++) {
+    const auto text = YGNodeNewWithConfig(config);
+    YGNodeSetMeasureFunc(text, measureText);
+    YGNodeInsertChild(column, text, i);
+  }
+  YGNodeInsertChild(root, column, 1);
+
+  const auto absolute = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(absolute, YGPositionTypeAbsolute);
+  YGNodeSetMeasureFunc(absolute, measureText);
+  YGNodeInsertChild(root, absolute, 2);
+
+  return root;
+}
+
+} // namespace
+
+TEST(YogaTest, layout_profiler_ignores_passes_while_disabled) {
+  auto& profiler = LayoutProfiler::shared();
+  profiler.setEnabled(true);
+  profiler.setEnabled(false);
+  profiler.reset();
+
+  const auto config = YGConfigNew();
+  const auto root = newTree(config);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FALSE(profiler.isEnabled());
+  ASSERT_EQ(0u, profiler.getPassCount());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_profiler_counts_layouts_and_measures_by_reason) {
+  auto& counts = eventCounts();
+  auto& profiler = LayoutProfiler::shared();
+  profiler.setEnabled(true);
+  profiler.reset();
+  {
+    std::lock_guard<std::mutex> lock(counts.mutex);
+    counts.isCounting = true;
+  }
+
+  const auto config = YGConfigNew();
+  const auto root = newTree(config);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  profiler.setEnabled(false);
+  {
+    std::lock_guard<std::mutex> lock(counts.mutex);
+    counts.isCounting = false;
+  }
+
+  const auto totals = profiler.getTotals();
+  ASSERT_EQ(2u, profiler.getPassCount());
+  ASSERT_EQ(counts.passCount, profiler.getPassCount());
+  ASSERT_EQ(counts.totals.layouts, totals.layouts);
+  ASSERT_EQ(counts.totals.measures, totals.measures);
+  ASSERT_EQ(counts.totals.measureCallbacks, totals.measureCallbacks);
+  ASSERT_GT(totals.measureCallbacks, 0);
+
+  int measureCallbacks = 0;
+  for (size_t reason = 0; reason < counts.measureCallbackReasons.size();
+       reason++) {
+    ASSERT_EQ(
+        counts.measureCallbackReasons[reason],
+        totals.measureCallbackReasonsCount[reason]);
+    measureCallbacks += totals.measureCallbackReasonsCount[reason];
+  }
+  ASSERT_EQ(totals.measureCallbacks, measureCallbacks);
+  ASSERT_GT(
+      totals.measureCallbackReasonsCount[static_cast<size_t>(
+          LayoutPassReason::kAbsMeasureChild)],
+      0);
+
+  for (size_t type = 0; type < totals.nodeLayoutReasonsCount.size(); type++) {
+    for (size_t reason = 0;
+         reason < totals.nodeLayoutReasonsCount[type].size();
+         reason++) {
+      ASSERT_EQ(
+          counts.totals.nodeLayoutReasonsCount[type][reason],
+          totals.nodeLayoutReasonsCount[type][reason]);
+    }
+  }
+  ASSERT_GT(
+      totals.nodeLayoutReasonsCount[static_cast<size_t>(LayoutType::kLayout)]
+                                   [static_cast<size_t>(
+                                       LayoutPassReason::kInitial)],
+      0);
+
+  const auto json = profiler.toJSON();
+  ASSERT_NE(std::string::npos, json.find("\"passCount\":2"));
+  ASSERT_NE(std::string::npos, json.find("\"measureCallbackReasons\":{"));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGMeasureCache.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include <memory>
+#include <string>
+
+struct _MeasuredText {
+  std::string text;
+  uint64_t hash;
+  int measureCount;
+};
+
+static YGSize _measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  auto& text = *static_cast<_MeasuredText*>(node->getContext());
+  text.measureCount++;
+  return YGSize{static_cast<float>(text.text.size()) * 10, 20};
+}
+
+static uint64_t _hashText(YGNodeRef node) {
+  return static_cast<_MeasuredText*>(node->getContext())->hash;
+}
+
+class _TextContent : public YGMeasureCache::Content {
+public:
+  explicit _TextContent(std::string text) : text_(std::move(text)) {}
+
+  bool isEqual(const YGMeasureCache::Content& other) const override {
+    return text_ == static_cast<const _TextContent&>(other).text_;
+  }
+
+private:
+  std::string text_;
+};
+
+static std::shared_ptr<const YGMeasureCache::Content> _textContent(
+    YGNodeRef node) {
+  return std::make_shared<_TextContent>(
+      static_cast<_MeasuredText*>(node->getContext())->text);
+}
+
+// A row with a text leaf per element of `texts`.
+static YGNodeRef _newRow(
+    YGConfigRef config,
+    std::initializer_list<_MeasuredText*> texts) {
+  const auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  uint32_t index = 0;
+  for (auto text : texts) {
+    const auto leaf = YGNodeNewWithConfig(config);
+    leaf->setContext(text);
+    YGNodeSetMeasureFunc(leaf, _measureText);
+    YGNodeInsertChild(root, leaf, index++);
+  }
+  return root;
+}
+
+TEST(YogaTest, measure_cache_shares_measurements_of_equal_contents) {
+  const auto cache = YGMeasureCacheNew(16);
+  const auto config = YGConfigNew();
+  YGConfigSetMeasureCache(config, cache, _hashText);
+
+  _MeasuredText first{"hello", 1, 0};
+  _MeasuredText second{"hello", 1, 0};
+  const auto root = _newRow(config, {&first, &second});
+
+  YGNodeCalculateLayout(root, 200, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(1, first.measureCount + second.measureCount);
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(YGNodeGetChild(root, 0)));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(YGNodeGetChild(root, 1)));
+  ASSERT_EQ(1u, cache->size());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGMeasureCacheFree(cache);
+}
+
+TEST(YogaTest, measure_cache_skips_nodes_with_zero_hash) {
+  const auto cache = YGMeasureCacheNew(16);
+  const auto config = YGConfigNew();
+  YGConfigSetMeasureCache(config, cache, _hashText);
+
+  _MeasuredText first{"hello", 0, 0};
+  _MeasuredText second{"hello", 0, 0};
+  const auto root = _newRow(config, {&first, &second});
+
+  YGNodeCalculateLayout(root, 200, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(1, first.measureCount);
+  ASSERT_EQ(1, second.measureCount);
+  ASSERT_EQ(0u, cache->size());
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGMeasureCacheFree(cache);
+}
+
+TEST(YogaTest, measure_cache_compares_contents_with_colliding_hashes) {
+  const auto cache = YGMeasureCacheNew(16);
+  const auto config = YGConfigNew();
+  YGConfigSetMeasureCache(config, cache, _hashText);
+  config->measureContentFunc = _textContent;
+
+  _MeasuredText first{"hello", 7, 0};
+  _MeasuredText colliding{"hello, world", 7, 0};
+  _MeasuredText equal{"hello", 7, 0};
+  const auto root = _newRow(config, {&first, &colliding, &equal});
+
+  YGNodeCalculateLayout(root, 500, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(1, first.measureCount);
+  ASSERT_EQ(1, colliding.measureCount);
+  ASSERT_EQ(0, equal.measureCount);
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(YGNodeGetChild(root, 0)));
+  ASSERT_FLOAT_EQ(120, YGNodeLayoutGetWidth(YGNodeGetChild(root, 1)));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(YGNodeGetChild(root, 2)));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+  YGMeasureCacheFree(cache);
+}
+
+TEST(YogaTest, measure_cache_evicts_least_recently_used_entries) {
+  YGMeasureCache cache{2};
+  const auto key = [](uint64_t hash) {
+    return YGMeasureCache::Key{
+        hash, 100, YGUndefined, YGMeasureModeAtMost, YGMeasureModeUndefined};
+  };
+
+  cache.set(key(1), {10, 10});
+  cache.set(key(2), {20, 20});
+
+  YGSize size;
+  ASSERT_TRUE(cache.get(key(1), size));
+  ASSERT_FLOAT_EQ(10, size.width);
+
+  cache.set(key(3), {30, 30});
+
+  ASSERT_EQ(2u, cache.size());
+  ASSERT_TRUE(cache.get(key(1), size));
+  ASSERT_FALSE(cache.get(key(2), size));
+  ASSERT_TRUE(cache.get(key(3), size));
+  ASSERT_FLOAT_EQ(30, size.height);
+
+  cache.clear();
+  ASSERT_EQ(0u, cache.size());
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+static YGSize _measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const auto textWidth =
+      static_cast<float>(*static_cast<int*>(node->getContext())) * 10;
+  const auto lineWidth =
+      widthMode == YGMeasureModeUndefined ? textWidth : fminf(textWidth, width);
+  const auto lineCount = lineWidth > 0 ? ceilf(textWidth / lineWidth) : 1;
+  return YGSize{lineWidth, lineCount * 20};
+}
+
+static int _textLengths[] = {3, 12, 7, 25, 1, 9};
+
+static YGNodeRef _newTextNode(YGConfigRef config, int index) {
+  const auto node = YGNodeNewWithConfig(config);
+  node->setContext(&_textLengths[index % 6]);
+  YGNodeSetMeasureFunc(node, _measureText);
+  return node;
+}
+
+// Flex items whose sizes are resolved by distributing the free space.
+static YGNodeRef _flexFixture(YGConfigRef config) {
+  const auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 400);
+  YGNodeStyleSetHeight(root, 100);
+
+  for (uint32_t i = 0; i < 5; i++) {
+    const auto child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexGrow(child, i % 3);
+    YGNodeStyleSetFlexShrink(child, 1);
+    YGNodeStyleSetFlexBasis(child, 40 + 10 * i);
+    YGNodeStyleSetMargin(child, YGEdgeHorizontal, 2);
+    YGNodeInsertChild(child, _newTextNode(config, i), 0);
+    YGNodeInsertChild(root, child, i);
+  }
+  return root;
+}
+
+// Stretched items of a column and of a wrapping row.
+static YGNodeRef _stretchFixture(YGConfigRef config) {
+  const auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 5);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    YGNodeInsertChild(root, _newTextNode(config, i), i);
+  }
+
+  const auto row = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(row, YGFlexDirectionRow);
+  YGNodeStyleSetFlexWrap(row, YGWrapWrap);
+  YGNodeStyleSetAlignContent(row, YGAlignStretch);
+  YGNodeStyleSetHeight(row, 120);
+  for (uint32_t i = 0; i < 6; i++) {
+    const auto child = _newTextNode(config, i);
+    YGNodeStyleSetMinWidth(child, 40);
+    YGNodeInsertChild(row, child, i);
+  }
+  YGNodeInsertChild(root, row, 4);
+
+  const auto centered = _newTextNode(config, 5);
+  YGNodeStyleSetAlignSelf(centered, YGAlignCenter);
+  YGNodeInsertChild(root, centered, 5);
+  return root;
+}
+
+// Absolutely positioned children.
+static YGNodeRef _absoluteFixture(YGConfigRef config) {
+  const auto root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeStyleSetHeight(root, 200);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 10);
+  YGNodeStyleSetJustifyContent(root, YGJustifyCenter);
+
+  const auto stretched = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(stretched, YGPositionTypeAbsolute);
+  YGNodeStyleSetPosition(stretched, YGEdgeLeft, 10);
+  YGNodeStyleSetPosition(stretched, YGEdgeRight, 20);
+  YGNodeStyleSetPosition(stretched, YGEdgeTop, 30);
+  YGNodeStyleSetPosition(stretched, YGEdgeBottom, 40);
+  YGNodeInsertChild(stretched, _newTextNode(config, 3), 0);
+  YGNodeInsertChild(root, stretched, 0);
+
+  const auto percent = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(percent, YGPositionTypeAbsolute);
+  YGNodeStyleSetWidthPercent(percent, 50);
+  YGNodeStyleSetPosition(percent, YGEdgeBottom, 5);
+  YGNodeStyleSetPosition(percent, YGEdgeRight, 5);
+  YGNodeInsertChild(percent, _newTextNode(config, 1), 0);
+  YGNodeInsertChild(root, percent, 1);
+
+  const auto text = _newTextNode(config, 2);
+  YGNodeStyleSetPositionType(text, YGPositionTypeAbsolute);
+  YGNodeStyleSetAlignSelf(text, YGAlignFlexEnd);
+  YGNodeInsertChild(root, text, 2);
+
+  YGNodeInsertChild(root, _newTextNode(config, 4), 3);
+  return root;
+}
+
+struct ExpectedLayout {
+  float left;
+  float top;
+  float width;
+  float height;
+};
+
+// Expected layouts of the fixtures in pre-order, as computed by the serial
+// algorithm before child layout calls were batched.
+static const std::vector<ExpectedLayout> _flexLayout = {
+    {0, 0, 400, 100},
+    {2, 0, 40, 100},
+    {0, 0, 40, 20},
+    {46, 0, 70, 100},
+    {0, 0, 70, 40},
+    {120, 0, 100, 100},
+    {0, 0, 100, 20},
+    {224, 0, 70, 100},
+    {0, 0, 70, 80},
+    {298, 0, 100, 100},
+    {0, 0, 100, 20},
+};
+
+static const std::vector<ExpectedLayout> _stretchLayout = {
+    {0, 0, 200, 250},
+    {5, 5, 190, 20},
+    {5, 25, 190, 20},
+    {5, 45, 190, 20},
+    {5, 65, 190, 40},
+    {5, 105, 190, 120},
+    {0, 0, 40, 25},
+    {40, 0, 120, 25},
+    {0, 25, 70, 25},
+    {0, 50, 190, 45},
+    {0, 95, 40, 25},
+    {40, 95, 90, 25},
+    {55, 225, 90, 20},
+};
+
+static const std::vector<ExpectedLayout> _absoluteLayout = {
+    {0, 0, 200, 200},
+    {10, 30, 170, 130},
+    {0, 0, 170, 40},
+    {105, 155, 90, 40},
+    {0, 0, 90, 40},
+    {130, 90, 70, 20},
+    {10, 90, 180, 20},
+};
+
+static std::atomic<uint32_t> _parallelBatchCount{0};
+
+// Runs every task on its own thread (the first one on the calling thread).
+static void _parallelFor(
+    YGConfigRef config,
+    uint32_t count,
+    YGParallelTaskFunc task,
+    void* taskContext) {
+  _parallelBatchCount++;
+  std::vector<std::thread> threads;
+  for (uint32_t i = 1; i < count; i++) {
+    threads.emplace_back(task, taskContext, i);
+  }
+  task(taskContext, 0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static void _assertLayout(
+    YGNodeRef node,
+    const std::vector<ExpectedLayout>& expectedLayouts,
+    size_t& index) {
+  ASSERT_LT(index, expectedLayouts.size());
+  const auto& expected = expectedLayouts[index++];
+  ASSERT_FLOAT_EQ(expected.left, YGNodeLayoutGetLeft(node));
+  ASSERT_FLOAT_EQ(expected.top, YGNodeLayoutGetTop(node));
+  ASSERT_FLOAT_EQ(expected.width, YGNodeLayoutGetWidth(node));
+  ASSERT_FLOAT_EQ(expected.height, YGNodeLayoutGetHeight(node));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    _assertLayout(YGNodeGetChild(node, i), expectedLayouts, index);
+  }
+}
+
+static void _assertLayout(
+    YGNodeRef node,
+    const std::vector<ExpectedLayout>& expectedLayouts) {
+  size_t index = 0;
+  _assertLayout(node, expectedLayouts, index);
+  ASSERT_EQ(expectedLayouts.size(), index);
+}
+
+static void _assertSameLayout(YGNodeRef node, YGNodeRef expectedNode) {
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetLeft(expectedNode), YGNodeLayoutGetLeft(node));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expectedNode), YGNodeLayoutGetTop(node));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetWidth(expectedNode), YGNodeLayoutGetWidth(node));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expectedNode), YGNodeLayoutGetHeight(node));
+  ASSERT_EQ(
+      YGNodeLayoutGetHadOverflow(expectedNode),
+      YGNodeLayoutGetHadOverflow(node));
+  ASSERT_EQ(YGNodeGetChildCount(expectedNode), YGNodeGetChildCount(node));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    _assertSameLayout(YGNodeGetChild(node, i), YGNodeGetChild(expectedNode, i));
+  }
+}
+
+// Lays out the fixture serially and with the parallel executor, checks both
+// against the expected layout, then changes the root width and compares them
+// again.
+static void _assertSerialAndParallelLayout(
+    YGNodeRef (*fixture)(YGConfigRef),
+    const std::vector<ExpectedLayout>& expectedLayouts) {
+  const auto serialConfig = YGConfigNew();
+  const auto serialRoot = fixture(serialConfig);
+
+  const auto parallelConfig = YGConfigNew();
+  YGConfigSetParallelForFunc(parallelConfig, _parallelFor);
+  YGConfigSetParallelLayoutThreshold(parallelConfig, 1);
+  const auto parallelRoot = fixture(parallelConfig);
+
+  _parallelBatchCount = 0;
+  YGNodeCalculateLayout(serialRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0u, _parallelBatchCount.load());
+  YGNodeCalculateLayout(
+      parallelRoot, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_GT(_parallelBatchCount.load(), 0u);
+
+  _assertLayout(serialRoot, expectedLayouts);
+  _assertLayout(parallelRoot, expectedLayouts);
+
+  YGNodeStyleSetWidth(serialRoot, 137);
+  YGNodeStyleSetWidth(parallelRoot, 137);
+  YGNodeCalculateLayout(serialRoot, YGUndefined, YGUndefined, YGDirectionRTL);
+  YGNodeCalculateLayout(
+      parallelRoot, YGUndefined, YGUndefined, YGDirectionRTL);
+  _assertSameLayout(parallelRoot, serialRoot);
+
+  YGNodeFreeRecursive(serialRoot);
+  YGNodeFreeRecursive(parallelRoot);
+  YGConfigFree(serialConfig);
+  YGConfigFree(parallelConfig);
+}
+
+TEST(YogaTest, parallel_layout_of_flex_items) {
+  _assertSerialAndParallelLayout(_flexFixture, _flexLayout);
+}
+
+TEST(YogaTest, parallel_layout_of_stretched_items) {
+  _assertSerialAndParallelLayout(_stretchFixture, _stretchLayout);
+}
+
+TEST(YogaTest, parallel_layout_of_absolute_children) {
+  _assertSerialAndParallelLayout(_absoluteFixture, _absoluteLayout);
+}
+
+TEST(YogaTest, parallel_layout_threshold) {
+  const auto config = YGConfigNew();
+  YGConfigSetParallelForFunc(config, _parallelFor);
+  YGConfigSetParallelLayoutThreshold(config, 100);
+  const auto root = _flexFixture(config);
+
+  _parallelBatchCount = 0;
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(0u, _parallelBatchCount.load());
+  _assertLayout(root, _flexLayout);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
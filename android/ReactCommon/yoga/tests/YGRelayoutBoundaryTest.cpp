@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/YGNode.h>
+#include <yoga/Yoga.h>
+
+static YGSize _measureText(
+    YGNodeRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode) {
+  const auto textLength =
+      static_cast<float>(*static_cast<int*>(node->getContext()));
+  return YGSize{textLength * 10, textLength * 4};
+}
+
+// root (500x500)
+//   container (column, auto size)
+//     boundary (100x100)
+//       text (measured, 10x4 points per character)
+//     sibling (50x50)
+struct RelayoutBoundaryTree {
+  RelayoutBoundaryTree(bool useRelayoutBoundaries, int* textLength)
+      : config(YGConfigNew()) {
+    YGConfigSetUseRelayoutBoundaries(config, useRelayoutBoundaries);
+
+    root = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(root, 500);
+    YGNodeStyleSetHeight(root, 500);
+
+    container = YGNodeNewWithConfig(config);
+    YGNodeStyleSetPadding(container, YGEdgeAll, 5);
+    YGNodeInsertChild(root, container, 0);
+
+    boundary = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(boundary, 100);
+    YGNodeStyleSetHeight(boundary, 100);
+    YGNodeStyleSetAlignItems(boundary, YGAlignFlexStart);
+    YGNodeInsertChild(container, boundary, 0);
+
+    text = YGNodeNewWithConfig(config);
+    text->setContext(textLength);
+    YGNodeSetMeasureFunc(text, _measureText);
+    YGNodeInsertChild(boundary, text, 0);
+
+    sibling = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(sibling, 50);
+    YGNodeStyleSetHeight(sibling, 50);
+    YGNodeInsertChild(container, sibling, 1);
+  }
+
+  ~RelayoutBoundaryTree() {
+    YGNodeFreeRecursive(root);
+    YGConfigFree(config);
+  }
+
+  YGConfigRef config;
+  YGNodeRef root;
+  YGNodeRef container;
+  YGNodeRef boundary;
+  YGNodeRef text;
+  YGNodeRef sibling;
+};
+
+static void expectSameLayout(YGNodeRef node, YGNodeRef expectedNode) {
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetLeft(expectedNode), YGNodeLayoutGetLeft(node));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expectedNode), YGNodeLayoutGetTop(node));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetWidth(expectedNode), YGNodeLayoutGetWidth(node));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expectedNode), YGNodeLayoutGetHeight(node));
+  ASSERT_EQ(
+      YGNodeLayoutGetHadOverflow(expectedNode),
+      YGNodeLayoutGetHadOverflow(node));
+  ASSERT_EQ(YGNodeGetChildCount(expectedNode), YGNodeGetChildCount(node));
+  for (uint32_t i = 0; i < YGNodeGetChildCount(node); i++) {
+    expectSameLayout(
+        YGNodeGetChild(node, i), YGNodeGetChild(expectedNode, i));
+  }
+}
+
+TEST(YogaTest, relayout_boundary_detection) {
+  int textLength = 3;
+  RelayoutBoundaryTree tree{true, &textLength};
+
+  ASSERT_FALSE(tree.root->isRelayoutBoundary());
+  ASSERT_FALSE(tree.container->isRelayoutBoundary());
+  ASSERT_TRUE(tree.boundary->isRelayoutBoundary());
+  ASSERT_TRUE(tree.sibling->isRelayoutBoundary());
+  ASSERT_FALSE(tree.text->isRelayoutBoundary());
+
+  YGNodeStyleSetFlexGrow(tree.boundary, 1);
+  ASSERT_FALSE(tree.boundary->isRelayoutBoundary());
+  YGNodeStyleSetFlexGrow(tree.boundary, 0);
+
+  YGNodeStyleSetAlignSelf(tree.boundary, YGAlignBaseline);
+  ASSERT_FALSE(tree.boundary->isRelayoutBoundary());
+  YGNodeStyleSetAlignSelf(tree.boundary, YGAlignAuto);
+
+  YGNodeStyleSetWidthPercent(tree.boundary, 50);
+  ASSERT_FALSE(tree.boundary->isRelayoutBoundary());
+
+  YGConfigSetUseRelayoutBoundaries(tree.config, false);
+  ASSERT_FALSE(tree.sibling->isRelayoutBoundary());
+}
+
+TEST(YogaTest, dirty_leaf_under_relayout_boundary_leaves_ancestors_clean) {
+  int textLength = 3;
+  RelayoutBoundaryTree tree{true, &textLength};
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetWidth(tree.text));
+
+  textLength = 5;
+  YGNodeMarkDirty(tree.text);
+
+  ASSERT_TRUE(YGNodeIsDirty(tree.text));
+  ASSERT_TRUE(YGNodeIsDirty(tree.boundary));
+  ASSERT_FALSE(YGNodeIsDirty(tree.container));
+  ASSERT_FALSE(YGNodeIsDirty(tree.root));
+  ASSERT_TRUE(tree.container->hasDirtyRelayoutBoundary());
+  ASSERT_TRUE(tree.root->hasDirtyRelayoutBoundary());
+
+  YGNodeSetHasNewLayout(tree.sibling, false);
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(tree.text));
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetWidth(tree.boundary));
+  ASSERT_FALSE(YGNodeIsDirty(tree.text));
+  ASSERT_FALSE(YGNodeIsDirty(tree.boundary));
+  ASSERT_FALSE(tree.container->hasDirtyRelayoutBoundary());
+  ASSERT_FALSE(tree.root->hasDirtyRelayoutBoundary());
+
+  // Nodes outside of the path to the boundary are not laid out again.
+  ASSERT_FALSE(YGNodeGetHasNewLayout(tree.sibling));
+}
+
+TEST(YogaTest, relayout_boundary_style_change_propagates_to_owner) {
+  int textLength = 3;
+  RelayoutBoundaryTree tree{true, &textLength};
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetHeight(tree.boundary));
+  ASSERT_FLOAT_EQ(160, YGNodeLayoutGetHeight(tree.container));
+
+  YGNodeStyleSetHeight(tree.boundary, 200);
+
+  ASSERT_TRUE(YGNodeIsDirty(tree.container));
+  ASSERT_TRUE(YGNodeIsDirty(tree.root));
+
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(200, YGNodeLayoutGetHeight(tree.boundary));
+  ASSERT_FLOAT_EQ(260, YGNodeLayoutGetHeight(tree.container));
+  ASSERT_FLOAT_EQ(205, YGNodeLayoutGetTop(tree.sibling));
+}
+
+TEST(YogaTest, relayout_boundary_overflow_change_propagates_to_owner) {
+  int textLength = 3;
+  RelayoutBoundaryTree tree{true, &textLength};
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FALSE(YGNodeLayoutGetHadOverflow(tree.boundary));
+  ASSERT_FALSE(YGNodeLayoutGetHadOverflow(tree.container));
+
+  // The text does not fit into the boundary anymore, so the size of the
+  // boundary stays the same but its overflow (which its owner reports too)
+  // changes.
+  textLength = 30;
+  YGNodeMarkDirty(tree.text);
+  ASSERT_FALSE(YGNodeIsDirty(tree.container));
+
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  int expectedTextLength = 30;
+  RelayoutBoundaryTree expectedTree{false, &expectedTextLength};
+  YGNodeCalculateLayout(
+      expectedTree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FLOAT_EQ(100, YGNodeLayoutGetHeight(tree.boundary));
+  ASSERT_TRUE(YGNodeLayoutGetHadOverflow(tree.boundary));
+  expectSameLayout(tree.root, expectedTree.root);
+  ASSERT_FALSE(YGNodeIsDirty(tree.container));
+  ASSERT_FALSE(tree.root->hasDirtyRelayoutBoundary());
+}
+
+TEST(YogaTest, relayout_boundaries_match_full_layout) {
+  int textLength = 1;
+  int expectedTextLength = 1;
+  RelayoutBoundaryTree tree{true, &textLength};
+  RelayoutBoundaryTree expectedTree{false, &expectedTextLength};
+
+  for (int length : {4, 9, 2, 12, 7}) {
+    textLength = length;
+    expectedTextLength = length;
+    YGNodeMarkDirty(tree.text);
+    YGNodeMarkDirty(expectedTree.text);
+    if (length == 12) {
+      YGNodeStyleSetPadding(tree.boundary, YGEdgeLeft, 3);
+      YGNodeStyleSetPadding(expectedTree.boundary, YGEdgeLeft, 3);
+    }
+
+    YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeCalculateLayout(
+        expectedTree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    expectSameLayout(tree.root, expectedTree.root);
+  }
+}
+
+// root (500x500)
+//   container (padding 5.4, so positions are fractional)
+//     boundary (100x100, padding 0.4)
+//       text
+//     absoluteBoundary (absolute, 100x100, margin 10% and padding 10%)
+//       text
+struct FractionalRelayoutBoundaryTree {
+  FractionalRelayoutBoundaryTree(bool useRelayoutBoundaries, int* textLength)
+      : config(YGConfigNew()) {
+    YGConfigSetUseRelayoutBoundaries(config, useRelayoutBoundaries);
+
+    root = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(root, 500);
+    YGNodeStyleSetHeight(root, 500);
+
+    const auto container = YGNodeNewWithConfig(config);
+    YGNodeStyleSetPadding(container, YGEdgeAll, 5.4);
+    YGNodeInsertChild(root, container, 0);
+
+    boundary = YGNodeNewWithConfig(config);
+    YGNodeStyleSetWidth(boundary, 100);
+    YGNodeStyleSetHeight(boundary, 100);
+    YGNodeStyleSetPadding(boundary, YGEdgeAll, 0.4);
+    YGNodeStyleSetAlignItems(boundary, YGAlignFlexStart);
+    YGNodeInsertChild(container, boundary, 0);
+
+    absoluteBoundary = YGNodeNewWithConfig(config);
+    YGNodeStyleSetPositionType(absoluteBoundary, YGPositionTypeAbsolute);
+    YGNodeStyleSetWidth(absoluteBoundary, 100);
+    YGNodeStyleSetHeight(absoluteBoundary, 100);
+    YGNodeStyleSetMarginPercent(absoluteBoundary, YGEdgeLeft, 10);
+    YGNodeStyleSetPaddingPercent(absoluteBoundary, YGEdgeLeft, 10);
+    YGNodeStyleSetAlignItems(absoluteBoundary, YGAlignFlexStart);
+    YGNodeInsertChild(container, absoluteBoundary, 1);
+
+    for (const auto owner : {boundary, absoluteBoundary}) {
+      const auto text = YGNodeNewWithConfig(config);
+      text->setContext(textLength);
+      YGNodeSetMeasureFunc(text, _measureText);
+      YGNodeInsertChild(owner, text, 0);
+    }
+  }
+
+  ~FractionalRelayoutBoundaryTree() {
+    YGNodeFreeRecursive(root);
+    YGConfigFree(config);
+  }
+
+  YGConfigRef config;
+  YGNodeRef root;
+  YGNodeRef boundary;
+  YGNodeRef absoluteBoundary;
+};
+
+TEST(YogaTest, relayout_boundaries_match_full_layout_with_fractional_offsets) {
+  int textLength = 1;
+  int expectedTextLength = 1;
+  FractionalRelayoutBoundaryTree tree{true, &textLength};
+  FractionalRelayoutBoundaryTree expectedTree{false, &expectedTextLength};
+  YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCalculateLayout(
+      expectedTree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+  expectSameLayout(tree.root, expectedTree.root);
+
+  for (int length : {4, 2, 7}) {
+    textLength = length;
+    expectedTextLength = length;
+    for (const auto owner : {tree.boundary, tree.absoluteBoundary}) {
+      YGNodeMarkDirty(YGNodeGetChild(owner, 0));
+    }
+    for (const auto owner :
+         {expectedTree.boundary, expectedTree.absoluteBoundary}) {
+      YGNodeMarkDirty(YGNodeGetChild(owner, 0));
+    }
+    ASSERT_FALSE(YGNodeIsDirty(tree.root));
+
+    YGNodeCalculateLayout(tree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeCalculateLayout(
+        expectedTree.root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+    expectSameLayout(tree.root, expectedTree.root);
+  }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga-internal.h>
+#include <yoga/Yoga.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+// Rounds `values` with every combination of forced rounding in a batch and
+// compares the results to rounding them one at a time. Odd counts make sure
+// both the vectorized lanes and the scalar remainder are covered.
+static void expectSameRounding(
+    const std::vector<double>& values,
+    const double pointScaleFactor) {
+  for (int flags = 0; flags < 4; flags++) {
+    const size_t count = values.size();
+    const std::unique_ptr<bool[]> forceCeil{new bool[count]};
+    const std::unique_ptr<bool[]> forceFloor{new bool[count]};
+    for (size_t i = 0; i < count; i++) {
+      // Alternate the flags between lanes, too.
+      forceCeil[i] = (flags & 1) != 0 && i % 3 != 0;
+      forceFloor[i] = (flags & 2) != 0 && i % 2 == 0;
+    }
+    std::vector<float> results(count);
+
+    YGRoundValuesToPixelGrid(
+        values.data(),
+        forceCeil.get(),
+        forceFloor.get(),
+        results.data(),
+        count,
+        pointScaleFactor);
+
+    for (size_t i = 0; i < count; i++) {
+      const float expected = YGRoundValueToPixelGrid(
+          values[i], pointScaleFactor, forceCeil[i], forceFloor[i]);
+      if (YGFloatIsUndefined(expected)) {
+        ASSERT_TRUE(YGFloatIsUndefined(results[i]))
+            << "value " << values[i] << " at scale " << pointScaleFactor;
+      } else {
+        ASSERT_EQ(expected, results[i])
+            << "value " << values[i] << " at scale " << pointScaleFactor
+            << " forceCeil " << forceCeil[i] << " forceFloor "
+            << forceFloor[i];
+      }
+    }
+  }
+}
+
+TEST(YogaTest, round_values_to_pixel_grid_matches_scalar_rounding) {
+  const std::vector<double> values = {
+      0,
+      -0.0,
+      1,
+      -1,
+      0.5,
+      -0.5,
+      1.5,
+      -1.5,
+      2.5,
+      -2.5,
+      0.25,
+      -0.25,
+      0.75,
+      -0.75,
+      1.2,
+      -1.2,
+      1.8,
+      -1.8,
+      // Within the epsilon of `YGDoubleEqual` to integers and to .5 ties.
+      3.00005,
+      2.99995,
+      -3.00005,
+      -2.99995,
+      0.49995,
+      0.50005,
+      -0.49995,
+      -0.50005,
+      123456.789,
+      -123456.789,
+      // Big values which are integral already.
+      4503599627370496.0,
+      -4503599627370496.0,
+      9007199254740993.0,
+      YGUndefined,
+      -YGUndefined,
+  };
+
+  for (const double pointScaleFactor : {1.0, 2.0, 3.0, 2.5, 0.5, 1.0 / 3}) {
+    expectSameRounding(values, pointScaleFactor);
+  }
+  expectSameRounding(values, YGUndefined);
+}
+
+TEST(YogaTest, round_values_to_pixel_grid_matches_scalar_rounding_randomly) {
+  std::mt19937 random{42};
+  std::uniform_real_distribution<double> distribution{-1000, 1000};
+  std::uniform_int_distribution<int> halves{-4000, 4000};
+
+  std::vector<double> values;
+  for (int i = 0; i < 999; i++) {
+    // Every other value is a multiple of a half pixel at scale 2 and 3.
+    values.push_back(
+        i % 2 == 0 ? distribution(random) : halves(random) / 12.0);
+  }
+
+  for (const double pointScaleFactor : {1.0, 2.0, 3.0, 1.5}) {
+    expectSameRounding(values, pointScaleFactor);
+  }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/SparseValues.h>
+#include <yoga/YGValue.h>
+
+#include <utility>
+
+using facebook::yoga::detail::CompactValue;
+
+using Edges = facebook::yoga::detail::SparseValues<9>;
+
+static CompactValue points(float value) {
+  return CompactValue::of<YGUnitPoint>(value);
+}
+
+// Checks every value of `edges` against `expected`, through both the const
+// and the non-const `operator[]`.
+static void expectValues(Edges& edges, const CompactValue (&expected)[9]) {
+  const Edges& constEdges = edges;
+  for (size_t i = 0; i < 9; i++) {
+    ASSERT_EQ(expected[i], constEdges[i]) << "edge " << i;
+    ASSERT_EQ(expected[i], CompactValue(edges[i])) << "edge " << i;
+  }
+}
+
+TEST(YogaTest, sparse_values_are_undefined_by_default) {
+  Edges edges;
+  for (size_t i = 0; i < 9; i++) {
+    ASSERT_TRUE(CompactValue(edges[i]).isUndefined());
+    ASSERT_TRUE(edges[i].isUndefined());
+  }
+  ASSERT_EQ(YGUnitUndefined, edges.get<YGEdgeLeft>().unit);
+}
+
+TEST(YogaTest, sparse_values_set_and_erase_in_any_order) {
+  Edges edges;
+  CompactValue expected[9] = {};
+
+  // Inserting in front of, between and after the packed values, growing from
+  // inline to heap storage.
+  for (size_t i : {4, 1, 8, 0, 6, 2}) {
+    edges[i] = points(static_cast<float>(i + 1));
+    expected[i] = points(static_cast<float>(i + 1));
+    expectValues(edges, expected);
+  }
+
+  // Replacing a value keeps the others.
+  edges[6] = CompactValue::ofAuto();
+  expected[6] = CompactValue::ofAuto();
+  expectValues(edges, expected);
+  ASSERT_TRUE(edges[6].isAuto());
+
+  // Erasing values shrinks back to inline storage.
+  for (size_t i : {0, 8, 4, 2, 1, 6}) {
+    edges[i] = CompactValue{};
+    expected[i] = CompactValue{};
+    expectValues(edges, expected);
+  }
+  ASSERT_EQ(Edges{}, edges);
+}
+
+TEST(YogaTest, sparse_values_are_copied_and_moved_by_value) {
+  Edges inlineEdges;
+  inlineEdges[YGEdgeLeft] = points(1);
+
+  Edges heapEdges;
+  heapEdges[YGEdgeLeft] = points(1);
+  heapEdges[YGEdgeTop] = points(2);
+  heapEdges[YGEdgeAll] = points(3);
+
+  for (Edges* source : {&inlineEdges, &heapEdges}) {
+    Edges copy = *source;
+    ASSERT_EQ(*source, copy);
+    copy[YGEdgeRight] = points(4);
+    ASSERT_NE(*source, copy);
+    ASSERT_TRUE((*source)[YGEdgeRight].isUndefined());
+
+    Edges assigned;
+    assigned[YGEdgeBottom] = points(5);
+    assigned = *source;
+    ASSERT_EQ(*source, assigned);
+
+    const Edges expected = copy;
+    Edges moved = std::move(copy);
+    ASSERT_EQ(expected, moved);
+    ASSERT_EQ(Edges{}, copy);
+
+    Edges moveAssigned;
+    moveAssigned = std::move(moved);
+    ASSERT_EQ(expected, moveAssigned);
+  }
+}
+
+TEST(YogaTest, sparse_values_assign_through_references) {
+  Edges edges;
+  edges[YGEdgeLeft] = points(1);
+  edges[YGEdgeStart] = edges[YGEdgeLeft];
+  edges[YGEdgeLeft] = YGValueUndefined;
+
+  ASSERT_EQ(points(1), CompactValue(edges[YGEdgeStart]));
+  ASSERT_TRUE(edges[YGEdgeLeft].isUndefined());
+
+  // Comparing references and converting them to `YGValue` go through
+  // `CompactValue`.
+  ASSERT_TRUE(edges[YGEdgeStart] != YGValueUndefined);
+  ASSERT_TRUE(YGValueUndefined == edges[YGEdgeLeft]);
+  const YGValue value = CompactValue(edges[YGEdgeStart]);
+  ASSERT_EQ((YGValue{1, YGUnitPoint}), value);
+}
+
+TEST(YogaTest, sparse_values_equality_ignores_the_order_of_setting) {
+  Edges a;
+  a[YGEdgeTop] = points(1);
+  a[YGEdgeLeft] = points(2);
+  a[YGEdgeEnd] = points(3);
+
+  Edges b;
+  b[YGEdgeEnd] = points(3);
+  b[YGEdgeLeft] = points(2);
+  b[YGEdgeRight] = points(4);
+  b[YGEdgeTop] = points(1);
+  ASSERT_NE(a, b);
+
+  b[YGEdgeRight] = CompactValue{};
+  ASSERT_EQ(a, b);
+
+  b[YGEdgeTop] = CompactValue::of<YGUnitPercent>(1);
+  ASSERT_NE(a, b);
+}
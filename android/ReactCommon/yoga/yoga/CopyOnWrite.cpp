@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "CopyOnWrite.h"
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+void* BlockCache::allocate(size_t blockSize) {
+  if (freeList_ == nullptr) {
+    return ::operator new(blockSize);
+  }
+  auto block = freeList_;
+  freeList_ = block->next;
+  cachedBlockCount_--;
+  return block;
+}
+
+void BlockCache::deallocate(void* block, size_t maxCachedBlocks) noexcept {
+  if (isReleased_ || cachedBlockCount_ >= maxCachedBlocks) {
+    ::operator delete(block);
+    return;
+  }
+  auto freeBlock = static_cast<FreeBlock*>(block);
+  freeBlock->next = freeList_;
+  freeList_ = freeBlock;
+  cachedBlockCount_++;
+}
+
+void BlockCache::release() noexcept {
+  isReleased_ = true;
+  while (freeList_ != nullptr) {
+    auto block = freeList_;
+    freeList_ = block->next;
+    ::operator delete(block);
+  }
+  cachedBlockCount_ = 0;
+}
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
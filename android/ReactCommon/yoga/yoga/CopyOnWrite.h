@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "YGMacros.h"
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// A cache of freed blocks of one size, used by a single thread so that
+// allocating and freeing blocks does not take a lock. Blocks can be freed on
+// any thread; they are cached by the freeing thread. Blocks beyond
+// `maxCachedBlocks`, and all cached blocks once the thread exits, are returned
+// to the system.
+// The cache is trivially constructible and destructible, so a `thread_local`
+// cache stays usable while the thread exits (e.g. when other `thread_local`
+// objects free blocks); `BlockCacheReleaser` empties it.
+struct YOGA_EXPORT BlockCache {
+  void* allocate(size_t blockSize);
+  void deallocate(void* block, size_t maxCachedBlocks) noexcept;
+
+  // Returns the cached blocks to the system. Blocks freed afterwards are
+  // returned to the system immediately.
+  void release() noexcept;
+
+  size_t cachedBlockCount() const noexcept { return cachedBlockCount_; }
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* freeList_;
+  size_t cachedBlockCount_;
+  bool isReleased_;
+};
+
+// Releases a `BlockCache` when destroyed.
+class YOGA_EXPORT BlockCacheReleaser {
+public:
+  explicit BlockCacheReleaser(BlockCache& cache) noexcept : cache_(cache) {}
+  ~BlockCacheReleaser() { cache_.release(); }
+
+  BlockCacheReleaser(const BlockCacheReleaser&) = delete;
+  BlockCacheReleaser& operator=(const BlockCacheReleaser&) = delete;
+
+private:
+  BlockCache& cache_;
+};
+
+// A value of type `T` stored in a reference counted block allocated through
+// the `BlockCache` of the current thread. Copies share the block; the first
+// mutation of a shared value copies it into a block of its own.
+// Default-constructed values share a single, immortal block holding `T{}`, so
+// creating a value does not allocate until it is mutated. The reference count
+// of that block is never changed and is kept above one, so it is never
+// considered unique.
+template <typename T>
+class CopyOnWrite {
+public:
+  CopyOnWrite() noexcept : block_(defaultBlock()) {}
+
+  CopyOnWrite(const CopyOnWrite& other) noexcept : block_(other.block_) {
+    retain(block_);
+  }
+
+  CopyOnWrite(CopyOnWrite&& other) noexcept : block_(other.block_) {
+    other.block_ = defaultBlock();
+  }
+
+  CopyOnWrite& operator=(const CopyOnWrite& other) noexcept {
+    retain(other.block_);
+    release(block_);
+    block_ = other.block_;
+    return *this;
+  }
+
+  CopyOnWrite& operator=(CopyOnWrite&& other) noexcept {
+    std::swap(block_, other.block_);
+    return *this;
+  }
+
+  ~CopyOnWrite() { release(block_); }
+
+  const T& get() const noexcept { return block_->value; }
+  const T& operator*() const noexcept { return block_->value; }
+  const T* operator->() const noexcept { return &block_->value; }
+
+  // Returns a reference to a value which is not shared with any other
+  // `CopyOnWrite`, copying the value if needed.
+  T& mutate() {
+    if (!isUnique()) {
+      auto block = allocateBlock(block_->value);
+      release(block_);
+      block_ = block;
+    }
+    return block_->value;
+  }
+
+  void set(const T& value) {
+    if (isUnique()) {
+      block_->value = value;
+    } else {
+      auto block = allocateBlock(value);
+      release(block_);
+      block_ = block;
+    }
+  }
+
+  bool isSharedWith(const CopyOnWrite& other) const noexcept {
+    return block_ == other.block_;
+  }
+
+  // Number of freed blocks cached by the current thread.
+  static size_t cachedBlockCount() noexcept {
+    return blockCache().cachedBlockCount();
+  }
+
+private:
+  struct Block {
+    template <typename... Args>
+    explicit Block(uint32_t refCount, Args&&... args)
+        : refCount{refCount}, value(std::forward<Args>(args)...) {}
+
+    std::atomic<uint32_t> refCount;
+    T value;
+  };
+
+  static constexpr size_t maxCachedBlocks = 256;
+
+  static BlockCache& blockCache() noexcept {
+    // Zero-initialized; see `BlockCache`.
+    static thread_local BlockCache cache;
+    static thread_local BlockCacheReleaser releaser{cache};
+    return cache;
+  }
+
+  static Block* defaultBlock() noexcept {
+    static Block block{2};
+    return &block;
+  }
+
+  static Block* allocateBlock(const T& value) {
+    static_assert(
+        sizeof(Block) >= sizeof(BlockCache::FreeBlock),
+        "A freed block has to be able to hold a free list entry.");
+    auto memory = blockCache().allocate(sizeof(Block));
+    return new (memory) Block{1, value};
+  }
+
+  static void retain(Block* block) noexcept {
+    if (block != defaultBlock()) {
+      block->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  static void release(Block* block) noexcept {
+    if (block != defaultBlock() &&
+        block->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      block->~Block();
+      blockCache().deallocate(block, maxCachedBlocks);
+    }
+  }
+
+  bool isUnique() const noexcept {
+    return block_->refCount.load(std::memory_order_acquire) == 1;
+  }
+
+  Block* block_;
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
+
+#endif
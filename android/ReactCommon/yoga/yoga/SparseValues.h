@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "CompactValue.h"
+
+namespace facebook {
+namespace yoga {
+namespace detail {
+
+// Same interface as `Values`, for groups of values where usually only a few
+// are set, like the edges of margin or padding.
+// Only the values which are not undefined are stored: a bit mask tells which
+// ones are set, and the values are packed in index order. Up to two values are
+// stored inline; more than that are stored in a heap allocated array.
+template <size_t Size>
+class SparseValues {
+  static_assert(Size <= 16, "The mask holds up to 16 values");
+
+public:
+  // Returned by the non-const `operator[]`, so that assigning to a value can
+  // add it to or remove it from the packed values.
+  class Ref {
+  public:
+    Ref(SparseValues& values, size_t index) noexcept
+        : values_(values), index_(index) {}
+
+    operator CompactValue() const noexcept { return values_.get(index_); }
+
+    Ref& operator=(CompactValue value) {
+      values_.set(index_, value);
+      return *this;
+    }
+    Ref& operator=(const Ref& other) {
+      return *this = other.values_.get(other.index_);
+    }
+
+    bool isUndefined() const noexcept {
+      return values_.get(index_).isUndefined();
+    }
+    bool isAuto() const noexcept { return values_.get(index_).isAuto(); }
+
+  private:
+    SparseValues& values_;
+    size_t index_;
+  };
+
+  SparseValues() noexcept : heap_(nullptr) {}
+
+  SparseValues(const SparseValues& other)
+      : mask_(other.mask_), count_(other.count_) {
+    if (isInline()) {
+      std::memcpy(inline_, other.inline_, sizeof(inline_));
+    } else {
+      heap_ = new CompactValue[count()];
+      std::copy(other.heap_, other.heap_ + count(), heap_);
+    }
+  }
+
+  SparseValues(SparseValues&& other) noexcept
+      : mask_(other.mask_), count_(other.count_) {
+    std::memcpy(inline_, other.inline_, sizeof(inline_));
+    other.mask_ = 0;
+    other.count_ = 0;
+  }
+
+  SparseValues& operator=(const SparseValues& other) {
+    if (this != &other) {
+      SparseValues copy{other};
+      swap(copy);
+    }
+    return *this;
+  }
+
+  SparseValues& operator=(SparseValues&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~SparseValues() {
+    if (!isInline()) {
+      delete[] heap_;
+    }
+  }
+
+  CompactValue operator[](size_t i) const noexcept { return get(i); }
+  Ref operator[](size_t i) noexcept { return {*this, i}; }
+
+  template <size_t I>
+  YGValue get() const noexcept {
+    static_assert(I < Size, "Index out of range");
+    return get(I);
+  }
+
+  template <size_t I>
+  void set(YGValue& value) {
+    static_assert(I < Size, "Index out of range");
+    set(I, value);
+  }
+
+  template <size_t I>
+  void set(YGValue&& value) {
+    set<I>(value);
+  }
+
+  // Undefined values are never stored, so equal groups have the same mask and
+  // the same packed values.
+  bool operator==(const SparseValues& other) const noexcept {
+    if (mask_ != other.mask_) {
+      return false;
+    }
+    const CompactValue* values = data();
+    const CompactValue* otherValues = other.data();
+    for (size_t i = 0; i < count(); i++) {
+      if (values[i] != otherValues[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool operator!=(const SparseValues& other) const noexcept {
+    return !(*this == other);
+  }
+
+private:
+  static constexpr size_t inlineCapacity = 2;
+
+  uint16_t mask_ = 0;
+  uint8_t count_ = 0;
+  union {
+    CompactValue inline_[inlineCapacity];
+    CompactValue* heap_;
+  };
+
+  static size_t bitCount(uint32_t bits) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcount(bits));
+#else
+    bits = bits - ((bits >> 1) & 0x5555);
+    bits = (bits & 0x3333) + ((bits >> 2) & 0x3333);
+    bits = (bits + (bits >> 4)) & 0x0f0f;
+    return (bits + (bits >> 8)) & 0x1f;
+#endif
+  }
+
+  size_t count() const noexcept { return count_; }
+  bool isInline() const noexcept { return count() <= inlineCapacity; }
+
+  const CompactValue* data() const noexcept {
+    return isInline() ? inline_ : heap_;
+  }
+
+  // Position of the value with index `i` among the packed values.
+  size_t packedIndex(size_t i) const noexcept {
+    return bitCount(mask_ & ((1u << i) - 1));
+  }
+
+  CompactValue get(size_t i) const noexcept {
+    if ((mask_ & (1u << i)) == 0) {
+      return CompactValue{};
+    }
+    return data()[packedIndex(i)];
+  }
+
+  void set(size_t i, CompactValue value) {
+    const uint16_t bit = static_cast<uint16_t>(1u << i);
+    if (value.isUndefined()) {
+      if ((mask_ & bit) != 0) {
+        erase(i);
+      }
+    } else if ((mask_ & bit) != 0) {
+      const_cast<CompactValue*>(data())[packedIndex(i)] = value;
+    } else {
+      insert(i, value);
+    }
+  }
+
+  void insert(size_t i, CompactValue value) {
+    const size_t oldCount = count();
+    const size_t index = packedIndex(i);
+    const CompactValue* oldValues = data();
+
+    CompactValue values[Size];
+    std::copy(oldValues, oldValues + index, values);
+    values[index] = value;
+    std::copy(oldValues + index, oldValues + oldCount, values + index + 1);
+
+    assign(mask_ | (1u << i), values);
+  }
+
+  void erase(size_t i) {
+    const size_t oldCount = count();
+    const size_t index = packedIndex(i);
+    const CompactValue* oldValues = data();
+
+    CompactValue values[Size];
+    std::copy(oldValues, oldValues + index, values);
+    std::copy(oldValues + index + 1, oldValues + oldCount, values + index);
+
+    assign(mask_ & ~(1u << i), values);
+  }
+
+  void assign(uint32_t mask, const CompactValue* values) {
+    const size_t newCount = bitCount(mask);
+    CompactValue* heap =
+        newCount > inlineCapacity ? new CompactValue[newCount] : nullptr;
+    if (!isInline()) {
+      delete[] heap_;
+    }
+    mask_ = static_cast<uint16_t>(mask);
+    count_ = static_cast<uint8_t>(newCount);
+    if (heap == nullptr) {
+      std::copy(values, values + newCount, inline_);
+    } else {
+      std::copy(values, values + newCount, heap);
+      heap_ = heap;
+    }
+  }
+
+  void swap(SparseValues& other) noexcept {
+    CompactValue storage[inlineCapacity];
+    std::memcpy(storage, inline_, sizeof(inline_));
+    std::memcpy(inline_, other.inline_, sizeof(inline_));
+    std::memcpy(other.inline_, storage, sizeof(inline_));
+    std::swap(mask_, other.mask_);
+    std::swap(count_, other.count_);
+  }
+};
+
+} // namespace detail
+} // namespace yoga
+} // namespace facebook
+
+#endif
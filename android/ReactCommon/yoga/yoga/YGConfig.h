@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include "YGMeasureCache.h"
 #include "Yoga-internal.h"
 #include "Yoga.h"
 
@@ -38,9 +39,17 @@ private:
 public:
   bool useWebDefaults = false;
   bool useLegacyStretchBehaviour = false;
+  bool useRelayoutBoundaries = false;
+  bool deferPixelGridRounding = false;
   bool shouldDiffLayoutWithoutLegacyStretchBehaviour = false;
   bool printTree = false;
   float pointScaleFactor = 1.0f;
+  YGMeasureCacheRef measureCache = nullptr;
+  YGMeasureContentHashFunc measureContentHashFunc = nullptr;
+  // Optional; without it, nodes with equal content hashes share measurements.
+  YGMeasureCache::ContentFunc measureContentFunc = nullptr;
+  YGParallelForFunc parallelForFunc = nullptr;
+  uint32_t parallelLayoutThreshold = 4;
   std::array<bool, facebook::yoga::enums::count<YGExperimentalFeature>()>
       experimentalFeatures = {};
   void* context = nullptr;
@@ -18,6 +18,9 @@ struct YGLayout {
   std::array<float, 4> margin = {};
   std::array<float, 4> border = {};
   std::array<float, 4> padding = {};
+  // The left and top position as computed by the layout algorithm, before
+  // `position` was rounded to the pixel grid.
+  std::array<float, 2> unroundedPosition = {};
 
 private:
   static constexpr size_t directionOffset = 0;
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "YGMeasureCache.h"
+#include <cstring>
+
+static uint32_t YGFloatBits(const float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  return bits;
+}
+
+bool YGMeasureCache::Key::operator==(const Key& other) const {
+  // Sizes are compared bitwise, so undefined (NaN) sizes are equal to each
+  // other.
+  if (contentHash != other.contentHash ||
+      widthMeasureMode != other.widthMeasureMode ||
+      heightMeasureMode != other.heightMeasureMode ||
+      YGFloatBits(width) != YGFloatBits(other.width) ||
+      YGFloatBits(height) != YGFloatBits(other.height)) {
+    return false;
+  }
+
+  if (content == other.content) {
+    return true;
+  }
+  return content != nullptr && other.content != nullptr &&
+      content->isEqual(*other.content);
+}
+
+size_t YGMeasureCache::KeyHash::operator()(const Key& key) const {
+  uint64_t hash = key.contentHash;
+  hash = hash * 31 + YGFloatBits(key.width);
+  hash = hash * 31 + YGFloatBits(key.height);
+  hash = hash * 31 + key.widthMeasureMode;
+  hash = hash * 31 + key.heightMeasureMode;
+  return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+YGMeasureCache::YGMeasureCache(size_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1) {
+  index_.reserve(capacity_);
+}
+
+bool YGMeasureCache::get(const Key& key, YGSize& size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iterator = index_.find(key);
+  if (iterator == index_.end()) {
+    return false;
+  }
+  // Moving the entry to the front of the list (most recently used).
+  entries_.splice(entries_.begin(), entries_, iterator->second);
+  size = iterator->second->second;
+  return true;
+}
+
+void YGMeasureCache::set(const Key& key, const YGSize size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iterator = index_.find(key);
+  if (iterator != index_.end()) {
+    iterator->second->second = size;
+    entries_.splice(entries_.begin(), entries_, iterator->second);
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+
+  entries_.emplace_front(key, size);
+  index_.emplace(key, entries_.begin());
+}
+
+void YGMeasureCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t YGMeasureCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Yoga.h"
+
+// A cache of measure function results which is shared between nodes (and
+// trees). Unlike the per-node cached measurements in `YGLayout`, entries are
+// keyed by a hash of the measured content (supplied by the config's
+// `YGMeasureContentHashFunc`), so identical leaves are measured only once.
+// The least recently used entries are evicted once the capacity is reached.
+// All methods are thread-safe.
+struct YOGA_EXPORT YGMeasureCache {
+  // The measured content of a node. If the config provides it (see
+  // `YGConfig::measureContentFunc`), entries keep the content they were
+  // measured for and lookups compare it in addition to the hash, so contents
+  // with colliding hashes never share measurements.
+  class Content {
+  public:
+    virtual ~Content() = default;
+    virtual bool isEqual(const Content& other) const = 0;
+  };
+  using ContentFunc = std::shared_ptr<const Content> (*)(YGNodeRef node);
+
+  struct Key {
+    uint64_t contentHash;
+    float width;
+    float height;
+    YGMeasureMode widthMeasureMode;
+    YGMeasureMode heightMeasureMode;
+    std::shared_ptr<const Content> content;
+
+    bool operator==(const Key& other) const;
+  };
+
+  explicit YGMeasureCache(size_t capacity);
+
+  // Returns true and sets `size` if there is an entry for `key`.
+  bool get(const Key& key, YGSize& size);
+  void set(const Key& key, YGSize size);
+  void clear();
+
+  size_t size() const;
+  size_t capacity() const { return capacity_; }
+
+private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  using Entries = std::list<std::pair<Key, YGSize>>;
+
+  mutable std::mutex mutex_;
+  const size_t capacity_;
+  Entries entries_;
+  std::unordered_map<Key, Entries::iterator, KeyHash> index_;
+};
@@ -17,6 +17,7 @@ using facebook::yoga::detail::CompactValue;
 YGNode::YGNode(YGNode&& node) {
   context_ = node.context_;
   flags = node.flags;
+  hasDirtyRelayoutBoundary_ = node.hasDirtyRelayoutBoundary_;
   measure_ = node.measure_;
   baseline_ = node.baseline_;
   print_ = node.print_;
@@ -55,14 +56,14 @@ YGFloatOptional YGNode::getLeadingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto leadingPosition = YGComputedEdgeValue(
-        style_.position(), YGEdgeStart, CompactValue::ofUndefined());
+        style_->position(), YGEdgeStart, CompactValue::ofUndefined());
     if (!leadingPosition.isUndefined()) {
       return YGResolveValue(leadingPosition, axisSize);
     }
   }
 
   auto leadingPosition = YGComputedEdgeValue(
-      style_.position(), leading[axis], CompactValue::ofUndefined());
+      style_->position(), leading[axis], CompactValue::ofUndefined());
 
   return leadingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -74,14 +75,14 @@ YGFloatOptional YGNode::getTrailingPosition(
     const float axisSize) const {
   if (YGFlexDirectionIsRow(axis)) {
     auto trailingPosition = YGComputedEdgeValue(
-        style_.position(), YGEdgeEnd, CompactValue::ofUndefined());
+        style_->position(), YGEdgeEnd, CompactValue::ofUndefined());
     if (!trailingPosition.isUndefined()) {
       return YGResolveValue(trailingPosition, axisSize);
     }
   }
 
   auto trailingPosition = YGComputedEdgeValue(
-      style_.position(), trailing[axis], CompactValue::ofUndefined());
+      style_->position(), trailing[axis], CompactValue::ofUndefined());
 
   return trailingPosition.isUndefined()
       ? YGFloatOptional{0}
@@ -91,20 +92,20 @@ YGFloatOptional YGNode::getTrailingPosition(
 bool YGNode::isLeadingPositionDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position(), YGEdgeStart, CompactValue::ofUndefined())
+               style_->position(), YGEdgeStart, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position(), leading[axis], CompactValue::ofUndefined())
+           style_->position(), leading[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
 bool YGNode::isTrailingPosDefined(const YGFlexDirection axis) const {
   return (YGFlexDirectionIsRow(axis) &&
           !YGComputedEdgeValue(
-               style_.position(), YGEdgeEnd, CompactValue::ofUndefined())
+               style_->position(), YGEdgeEnd, CompactValue::ofUndefined())
                .isUndefined()) ||
       !YGComputedEdgeValue(
-           style_.position(), trailing[axis], CompactValue::ofUndefined())
+           style_->position(), trailing[axis], CompactValue::ofUndefined())
            .isUndefined();
 }
 
@@ -112,26 +113,27 @@ YGFloatOptional YGNode::getLeadingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.margin()[YGEdgeStart].isUndefined()) {
-    return YGResolveValueMargin(style_.margin()[YGEdgeStart], widthSize);
+      !style_->margin()[YGEdgeStart].isUndefined()) {
+    return YGResolveValueMargin(style_->margin()[YGEdgeStart], widthSize);
   }
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), leading[axis], CompactValue::ofZero()),
+          style_->margin(), leading[axis], CompactValue::ofZero()),
       widthSize);
 }
 
 YGFloatOptional YGNode::getTrailingMargin(
     const YGFlexDirection axis,
     const float widthSize) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
-    return YGResolveValueMargin(style_.margin()[YGEdgeEnd], widthSize);
+  if (YGFlexDirectionIsRow(axis) &&
+      !style_->margin()[YGEdgeEnd].isUndefined()) {
+    return YGResolveValueMargin(style_->margin()[YGEdgeEnd], widthSize);
   }
 
   return YGResolveValueMargin(
       YGComputedEdgeValue(
-          style_.margin(), trailing[axis], CompactValue::ofZero()),
+          style_->margin(), trailing[axis], CompactValue::ofZero()),
       widthSize);
 }
 
@@ -232,49 +234,57 @@ void YGNode::removeChild(uint32_t index) {
 }
 
 void YGNode::setLayoutDirection(YGDirection direction) {
-  layout_.setDirection(direction);
+  layout_.mutate().setDirection(direction);
 }
 
 void YGNode::setLayoutMargin(float margin, int index) {
-  layout_.margin[index] = margin;
+  layout_.mutate().margin[index] = margin;
 }
 
 void YGNode::setLayoutBorder(float border, int index) {
-  layout_.border[index] = border;
+  layout_.mutate().border[index] = border;
 }
 
 void YGNode::setLayoutPadding(float padding, int index) {
-  layout_.padding[index] = padding;
+  layout_.mutate().padding[index] = padding;
 }
 
 void YGNode::setLayoutLastOwnerDirection(YGDirection direction) {
-  layout_.lastOwnerDirection = direction;
+  layout_.mutate().lastOwnerDirection = direction;
 }
 
 void YGNode::setLayoutComputedFlexBasis(
     const YGFloatOptional computedFlexBasis) {
-  layout_.computedFlexBasis = computedFlexBasis;
+  layout_.mutate().computedFlexBasis = computedFlexBasis;
 }
 
 void YGNode::setLayoutPosition(float position, int index) {
-  layout_.position[index] = position;
+  auto& layout = layout_.mutate();
+  layout.position[index] = position;
+  if (index == YGEdgeLeft || index == YGEdgeTop) {
+    layout.unroundedPosition[index] = position;
+  }
+}
+
+void YGNode::setLayoutRoundedPosition(float position, int index) {
+  layout_.mutate().position[index] = position;
 }
 
 void YGNode::setLayoutComputedFlexBasisGeneration(
     uint32_t computedFlexBasisGeneration) {
-  layout_.computedFlexBasisGeneration = computedFlexBasisGeneration;
+  layout_.mutate().computedFlexBasisGeneration = computedFlexBasisGeneration;
 }
 
 void YGNode::setLayoutMeasuredDimension(float measuredDimension, int index) {
-  layout_.measuredDimensions[index] = measuredDimension;
+  layout_.mutate().measuredDimensions[index] = measuredDimension;
 }
 
 void YGNode::setLayoutHadOverflow(bool hadOverflow) {
-  layout_.setHadOverflow(hadOverflow);
+  layout_.mutate().setHadOverflow(hadOverflow);
 }
 
 void YGNode::setLayoutDimension(float dimension, int index) {
-  layout_.dimensions[index] = dimension;
+  layout_.mutate().dimensions[index] = dimension;
 }
 
 // If both left and right are defined, then use left. Otherwise return +left or
@@ -303,7 +313,7 @@ void YGNode::setPosition(
   const YGDirection directionRespectingRoot =
       owner_ != nullptr ? direction : YGDirectionLTR;
   const YGFlexDirection mainAxis =
-      YGResolveFlexDirection(style_.flexDirection(), directionRespectingRoot);
+      YGResolveFlexDirection(style_->flexDirection(), directionRespectingRoot);
   const YGFlexDirection crossAxis =
       YGFlexDirectionCross(mainAxis, directionRespectingRoot);
 
@@ -333,27 +343,28 @@ void YGNode::setPosition(
 
 YGValue YGNode::marginLeadingValue(const YGFlexDirection axis) const {
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.margin()[YGEdgeStart].isUndefined()) {
-    return style_.margin()[YGEdgeStart];
+      !style_->margin()[YGEdgeStart].isUndefined()) {
+    return style_->margin()[YGEdgeStart];
   } else {
-    return style_.margin()[leading[axis]];
+    return style_->margin()[leading[axis]];
   }
 }
 
 YGValue YGNode::marginTrailingValue(const YGFlexDirection axis) const {
-  if (YGFlexDirectionIsRow(axis) && !style_.margin()[YGEdgeEnd].isUndefined()) {
-    return style_.margin()[YGEdgeEnd];
+  if (YGFlexDirectionIsRow(axis) &&
+      !style_->margin()[YGEdgeEnd].isUndefined()) {
+    return style_->margin()[YGEdgeEnd];
   } else {
-    return style_.margin()[trailing[axis]];
+    return style_->margin()[trailing[axis]];
   }
 }
 
 YGValue YGNode::resolveFlexBasisPtr() const {
-  YGValue flexBasis = style_.flexBasis();
+  YGValue flexBasis = style_->flexBasis();
   if (flexBasis.unit != YGUnitAuto && flexBasis.unit != YGUnitUndefined) {
     return flexBasis;
   }
-  if (!style_.flex().isUndefined() && style_.flex().unwrap() > 0.0f) {
+  if (!style_->flex().isUndefined() && style_->flex().unwrap() > 0.0f) {
     return facebook::yoga::detail::getBooleanData(flags, useWebDefaults_)
         ? YGValueAuto
         : YGValueZero;
@@ -375,11 +386,11 @@ void YGNode::resolveDimension() {
 }
 
 YGDirection YGNode::resolveDirection(const YGDirection ownerDirection) {
-  if (style_.direction() == YGDirectionInherit) {
+  if (style_->direction() == YGDirectionInherit) {
     return ownerDirection > YGDirectionInherit ? ownerDirection
                                                : YGDirectionLTR;
   } else {
-    return style_.direction();
+    return style_->direction();
   }
 }
 
@@ -399,11 +410,64 @@ void YGNode::markDirtyAndPropogate() {
     setDirty(true);
     setLayoutComputedFlexBasis(YGFloatOptional());
     if (owner_) {
-      owner_->markDirtyAndPropogate();
+      if (isRelayoutBoundary()) {
+        owner_->markHasDirtyRelayoutBoundaryAndPropogate();
+      } else {
+        owner_->markDirtyAndPropogate();
+      }
+    }
+  }
+}
+
+void YGNode::markStyleDirtyAndPropogate() {
+  // Unlike changes of the content, changes of the style can affect the size and
+  // the position of the node itself, so they always have to reach the owner.
+  if (!facebook::yoga::detail::getBooleanData(flags, isDirty_)) {
+    setDirty(true);
+    setLayoutComputedFlexBasis(YGFloatOptional());
+  }
+  if (owner_) {
+    owner_->markDirtyAndPropogate();
+  }
+}
+
+void YGNode::markHasDirtyRelayoutBoundaryAndPropogate() {
+  if (!hasDirtyRelayoutBoundary_) {
+    hasDirtyRelayoutBoundary_ = true;
+    if (owner_) {
+      owner_->markHasDirtyRelayoutBoundaryAndPropogate();
     }
   }
 }
 
+bool YGNode::isRelayoutBoundary() const {
+  if (!config_->useRelayoutBoundaries || owner_ == nullptr ||
+      style_->display() == YGDisplayNone) {
+    return false;
+  }
+
+  // The size must be fixed...
+  if (YGValue(style_->dimensions()[YGDimensionWidth]).unit != YGUnitPoint ||
+      YGValue(style_->dimensions()[YGDimensionHeight]).unit != YGUnitPoint ||
+      !style_->aspectRatio().isUndefined()) {
+    return false;
+  }
+
+  // ...and must not be resolved by the owner's flex algorithm.
+  const auto flexBasis = resolveFlexBasisPtr();
+  if (resolveFlexGrow() != 0 || resolveFlexShrink() != 0 ||
+      (flexBasis.unit != YGUnitAuto && flexBasis.unit != YGUnitUndefined)) {
+    return false;
+  }
+
+  // Baseline alignment makes the position of the node depend on its content.
+  const auto alignSelf = style_->alignSelf() == YGAlignAuto
+      ? owner_->getStyle().alignItems()
+      : style_->alignSelf();
+  return alignSelf != YGAlignBaseline &&
+      !facebook::yoga::detail::getBooleanData(flags, isReferenceBaseline_);
+}
+
 void YGNode::markDirtyAndPropogateDownwards() {
   facebook::yoga::detail::setBooleanData(flags, isDirty_, true);
   for_each(children_.begin(), children_.end(), [](YGNodeRef childNode) {
@@ -416,11 +480,11 @@ float YGNode::resolveFlexGrow() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexGrow().isUndefined()) {
-    return style_.flexGrow().unwrap();
+  if (!style_->flexGrow().isUndefined()) {
+    return style_->flexGrow().unwrap();
   }
-  if (!style_.flex().isUndefined() && style_.flex().unwrap() > 0.0f) {
-    return style_.flex().unwrap();
+  if (!style_->flex().isUndefined() && style_->flex().unwrap() > 0.0f) {
+    return style_->flex().unwrap();
   }
   return kDefaultFlexGrow;
 }
@@ -429,12 +493,12 @@ float YGNode::resolveFlexShrink() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (!style_.flexShrink().isUndefined()) {
-    return style_.flexShrink().unwrap();
+  if (!style_->flexShrink().isUndefined()) {
+    return style_->flexShrink().unwrap();
   }
   if (!facebook::yoga::detail::getBooleanData(flags, useWebDefaults_) &&
-      !style_.flex().isUndefined() && style_.flex().unwrap() < 0.0f) {
-    return -style_.flex().unwrap();
+      !style_->flex().isUndefined() && style_->flex().unwrap() < 0.0f) {
+    return -style_->flex().unwrap();
   }
   return facebook::yoga::detail::getBooleanData(flags, useWebDefaults_)
       ? kWebDefaultFlexShrink
@@ -443,37 +507,37 @@ float YGNode::resolveFlexShrink() const {
 
 bool YGNode::isNodeFlexible() {
   return (
-      (style_.positionType() != YGPositionTypeAbsolute) &&
+      (style_->positionType() != YGPositionTypeAbsolute) &&
       (resolveFlexGrow() != 0 || resolveFlexShrink() != 0));
 }
 
 float YGNode::getLeadingBorder(const YGFlexDirection axis) const {
   YGValue leadingBorder;
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.border()[YGEdgeStart].isUndefined()) {
-    leadingBorder = style_.border()[YGEdgeStart];
+      !style_->border()[YGEdgeStart].isUndefined()) {
+    leadingBorder = style_->border()[YGEdgeStart];
     if (leadingBorder.value >= 0) {
       return leadingBorder.value;
     }
   }
 
   leadingBorder = YGComputedEdgeValue(
-      style_.border(), leading[axis], CompactValue::ofZero());
+      style_->border(), leading[axis], CompactValue::ofZero());
   return YGFloatMax(leadingBorder.value, 0.0f);
 }
 
 float YGNode::getTrailingBorder(const YGFlexDirection flexDirection) const {
   YGValue trailingBorder;
   if (YGFlexDirectionIsRow(flexDirection) &&
-      !style_.border()[YGEdgeEnd].isUndefined()) {
-    trailingBorder = style_.border()[YGEdgeEnd];
+      !style_->border()[YGEdgeEnd].isUndefined()) {
+    trailingBorder = style_->border()[YGEdgeEnd];
     if (trailingBorder.value >= 0.0f) {
       return trailingBorder.value;
     }
   }
 
   trailingBorder = YGComputedEdgeValue(
-      style_.border(), trailing[flexDirection], CompactValue::ofZero());
+      style_->border(), trailing[flexDirection], CompactValue::ofZero());
   return YGFloatMax(trailingBorder.value, 0.0f);
 }
 
@@ -481,16 +545,16 @@ YGFloatOptional YGNode::getLeadingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeStart =
-      YGResolveValue(style_.padding()[YGEdgeStart], widthSize);
+      YGResolveValue(style_->padding()[YGEdgeStart], widthSize);
   if (YGFlexDirectionIsRow(axis) &&
-      !style_.padding()[YGEdgeStart].isUndefined() &&
+      !style_->padding()[YGEdgeStart].isUndefined() &&
       !paddingEdgeStart.isUndefined() && paddingEdgeStart.unwrap() >= 0.0f) {
     return paddingEdgeStart;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), leading[axis], CompactValue::ofZero()),
+          style_->padding(), leading[axis], CompactValue::ofZero()),
       widthSize);
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
 }
@@ -499,14 +563,14 @@ YGFloatOptional YGNode::getTrailingPadding(
     const YGFlexDirection axis,
     const float widthSize) const {
   const YGFloatOptional paddingEdgeEnd =
-      YGResolveValue(style_.padding()[YGEdgeEnd], widthSize);
+      YGResolveValue(style_->padding()[YGEdgeEnd], widthSize);
   if (YGFlexDirectionIsRow(axis) && paddingEdgeEnd >= YGFloatOptional{0.0f}) {
     return paddingEdgeEnd;
   }
 
   YGFloatOptional resolvedValue = YGResolveValue(
       YGComputedEdgeValue(
-          style_.padding(), trailing[axis], CompactValue::ofZero()),
+          style_->padding(), trailing[axis], CompactValue::ofZero()),
       widthSize);
 
   return YGFloatOptionalMax(resolvedValue, YGFloatOptional(0.0f));
@@ -527,12 +591,12 @@ YGFloatOptional YGNode::getTrailingPaddingAndBorder(
 }
 
 bool YGNode::didUseLegacyFlag() {
-  bool didUseLegacyFlag = layout_.didUseLegacyFlag();
+  bool didUseLegacyFlag = layout_->didUseLegacyFlag();
   if (didUseLegacyFlag) {
     return true;
   }
   for (const auto& child : children_) {
-    if (child->layout_.didUseLegacyFlag()) {
+    if (child->layout_->didUseLegacyFlag()) {
       didUseLegacyFlag = true;
       break;
     }
@@ -542,18 +606,19 @@ bool YGNode::didUseLegacyFlag() {
 
 void YGNode::setLayoutDoesLegacyFlagAffectsLayout(
     bool doesLegacyFlagAffectsLayout) {
-  layout_.setDoesLegacyStretchFlagAffectsLayout(doesLegacyFlagAffectsLayout);
+  layout_.mutate().setDoesLegacyStretchFlagAffectsLayout(
+      doesLegacyFlagAffectsLayout);
 }
 
 void YGNode::setLayoutDidUseLegacyFlag(bool didUseLegacyFlag) {
-  layout_.setDidUseLegacyFlag(didUseLegacyFlag);
+  layout_.mutate().setDidUseLegacyFlag(didUseLegacyFlag);
 }
 
 bool YGNode::isLayoutTreeEqualToNode(const YGNode& node) const {
   if (children_.size() != node.children_.size()) {
     return false;
   }
-  if (layout_ != node.layout_) {
+  if (*layout_ != *node.layout_) {
     return false;
   }
   if (children_.size() == 0) {
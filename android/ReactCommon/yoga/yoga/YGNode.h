@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include "BitUtils.h"
 #include "CompactValue.h"
+#include "CopyOnWrite.h"
 #include "YGConfig.h"
 #include "YGLayout.h"
 #include "YGStyle.h"
@@ -40,6 +41,7 @@ private:
   void* context_ = nullptr;
   uint8_t flags = 1;
   uint8_t reserved_ = 0;
+  bool hasDirtyRelayoutBoundary_ = false;
   union {
     YGMeasureFunc noContext;
     MeasureWithContextFn withContext;
@@ -53,8 +55,10 @@ private:
     PrintWithContextFn withContext;
   } print_ = {nullptr};
   YGDirtiedFunc dirtied_ = nullptr;
-  YGStyle style_ = {};
-  YGLayout layout_ = {};
+  // Style and layout are shared between copies of a node (e.g. clones of Fabric
+  // shadow nodes) until one of them changes.
+  facebook::yoga::detail::CopyOnWrite<YGStyle> style_ = {};
+  facebook::yoga::detail::CopyOnWrite<YGLayout> layout_ = {};
   uint32_t lineIndex_ = 0;
   YGNodeRef owner_ = nullptr;
   YGVector children_ = {};
@@ -71,8 +75,8 @@ private:
 
   void useWebDefaults() {
     facebook::yoga::detail::setBooleanData(flags, useWebDefaults_, true);
-    style_.flexDirection() = YGFlexDirectionRow;
-    style_.alignContent() = YGAlignStretch;
+    style_.mutate().flexDirection() = YGFlexDirectionRow;
+    style_.mutate().alignContent() = YGAlignStretch;
   }
 
   // DANGER DANGER DANGER!
@@ -135,14 +139,18 @@ public:
   YGDirtiedFunc getDirtied() const { return dirtied_; }
 
   // For Performance reasons passing as reference.
-  YGStyle& getStyle() { return style_; }
+  const YGStyle& getStyle() const { return *style_; }
 
-  const YGStyle& getStyle() const { return style_; }
+  // Copies the style first if it is shared with another node. Only use this
+  // for writing, reading should go through `getStyle()`.
+  YGStyle& getMutableStyle() { return style_.mutate(); }
 
   // For Performance reasons passing as reference.
-  YGLayout& getLayout() { return layout_; }
+  const YGLayout& getLayout() const { return *layout_; }
 
-  const YGLayout& getLayout() const { return layout_; }
+  // Copies the layout first if it is shared with another node. Only use this
+  // for writing, reading should go through `getLayout()`.
+  YGLayout& getMutableLayout() { return layout_.mutate(); }
 
   uint32_t getLineIndex() const { return lineIndex_; }
 
@@ -185,6 +193,15 @@ public:
     return facebook::yoga::detail::getBooleanData(flags, isDirty_);
   }
 
+  // Returns true if some descendant of the node is a dirty relayout boundary
+  // which has to be laid out even though this node is not dirty.
+  bool hasDirtyRelayoutBoundary() const { return hasDirtyRelayoutBoundary_; }
+
+  // A relayout boundary is a node whose own size cannot be affected by its
+  // content (e.g. a fixed-size cell). Changes inside such a node do not have to
+  // be propagated to its owner; the node can be laid out on its own instead.
+  bool isRelayoutBoundary() const;
+
   std::array<YGValue, 2> getResolvedDimensions() const {
     return resolvedDimensions_;
   }
@@ -268,9 +285,9 @@ public:
 
   void setDirtiedFunc(YGDirtiedFunc dirtiedFunc) { dirtied_ = dirtiedFunc; }
 
-  void setStyle(const YGStyle& style) { style_ = style; }
+  void setStyle(const YGStyle& style) { style_.set(style); }
 
-  void setLayout(const YGLayout& layout) { layout_ = layout; }
+  void setLayout(const YGLayout& layout) { layout_.set(layout); }
 
   void setLineIndex(uint32_t lineIndex) { lineIndex_ = lineIndex; }
 
@@ -288,6 +305,9 @@ public:
   YG_DEPRECATED void setConfig(YGConfigRef config) { config_ = config; }
 
   void setDirty(bool isDirty);
+  void setHasDirtyRelayoutBoundary(bool hasDirtyRelayoutBoundary) {
+    hasDirtyRelayoutBoundary_ = hasDirtyRelayoutBoundary;
+  }
   void setLayoutLastOwnerDirection(YGDirection direction);
   void setLayoutComputedFlexBasis(const YGFloatOptional computedFlexBasis);
   void setLayoutComputedFlexBasisGeneration(
@@ -300,6 +320,8 @@ public:
   void setLayoutBorder(float border, int index);
   void setLayoutPadding(float padding, int index);
   void setLayoutPosition(float position, int index);
+  // Sets a position rounded to the pixel grid, keeping the unrounded one.
+  void setLayoutRoundedPosition(float position, int index);
   void setPosition(
       const YGDirection direction,
       const float mainSize,
@@ -326,6 +348,8 @@ public:
 
   void cloneChildrenIfNeeded(void*);
   void markDirtyAndPropogate();
+  void markStyleDirtyAndPropogate();
+  void markHasDirtyRelayoutBoundaryAndPropogate();
   float resolveFlexGrow() const;
   float resolveFlexShrink() const;
   bool isNodeFlexible();
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <type_traits>
 #include "CompactValue.h"
+#include "SparseValues.h"
 #include "YGEnums.h"
 #include "YGFloatOptional.h"
 #include "Yoga-internal.h"
@@ -28,7 +29,8 @@ class YOGA_EXPORT YGStyle {
 
 public:
   using Dimensions = Values<YGDimension>;
-  using Edges = Values<YGEdge>;
+  using Edges = facebook::yoga::detail::SparseValues<
+      facebook::yoga::enums::count<YGEdge>()>;
 
   template <typename T>
   struct BitfieldRef {
@@ -53,7 +55,7 @@ public:
     }
   };
 
-  template <typename Idx, Values<Idx> YGStyle::*Prop>
+  template <typename Idx, typename Group, Group YGStyle::*Prop>
   struct IdxRef {
     struct Ref {
       YGStyle& style;
@@ -67,11 +69,11 @@ public:
     };
 
     YGStyle& style;
-    IdxRef<Idx, Prop>& operator=(const Values<Idx>& values) {
+    IdxRef<Idx, Group, Prop>& operator=(const Group& values) {
       style.*Prop = values;
       return *this;
     }
-    operator const Values<Idx>&() const { return style.*Prop; }
+    operator const Group&() const { return style.*Prop; }
     Ref operator[](Idx idx) { return {style, idx}; }
     CompactValue operator[](Idx idx) const { return (style.*Prop)[idx]; }
   };
@@ -121,7 +123,7 @@ private:
 
 public:
   // for library users needing a type
-  using ValueRepr = std::remove_reference<decltype(margin_[0])>::type;
+  using ValueRepr = std::remove_reference<decltype(dimensions_[0])>::type;
 
   YGDirection direction() const {
     return facebook::yoga::detail::getEnumData<YGDirection>(
@@ -199,27 +201,29 @@ public:
   Ref<CompactValue, &YGStyle::flexBasis_> flexBasis() { return {*this}; }
 
   const Edges& margin() const { return margin_; }
-  IdxRef<YGEdge, &YGStyle::margin_> margin() { return {*this}; }
+  IdxRef<YGEdge, Edges, &YGStyle::margin_> margin() { return {*this}; }
 
   const Edges& position() const { return position_; }
-  IdxRef<YGEdge, &YGStyle::position_> position() { return {*this}; }
+  IdxRef<YGEdge, Edges, &YGStyle::position_> position() { return {*this}; }
 
   const Edges& padding() const { return padding_; }
-  IdxRef<YGEdge, &YGStyle::padding_> padding() { return {*this}; }
+  IdxRef<YGEdge, Edges, &YGStyle::padding_> padding() { return {*this}; }
 
   const Edges& border() const { return border_; }
-  IdxRef<YGEdge, &YGStyle::border_> border() { return {*this}; }
+  IdxRef<YGEdge, Edges, &YGStyle::border_> border() { return {*this}; }
 
   const Dimensions& dimensions() const { return dimensions_; }
-  IdxRef<YGDimension, &YGStyle::dimensions_> dimensions() { return {*this}; }
+  IdxRef<YGDimension, Dimensions, &YGStyle::dimensions_> dimensions() {
+    return {*this};
+  }
 
   const Dimensions& minDimensions() const { return minDimensions_; }
-  IdxRef<YGDimension, &YGStyle::minDimensions_> minDimensions() {
+  IdxRef<YGDimension, Dimensions, &YGStyle::minDimensions_> minDimensions() {
     return {*this};
   }
 
   const Dimensions& maxDimensions() const { return maxDimensions_; }
-  IdxRef<YGDimension, &YGStyle::maxDimensions_> maxDimensions() {
+  IdxRef<YGDimension, Dimensions, &YGStyle::maxDimensions_> maxDimensions() {
     return {*this};
   }
 
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <vector>
 #include "CompactValue.h"
+#include "SparseValues.h"
 #include "Yoga.h"
 
 using YGVector = std::vector<YGNodeRef>;
@@ -145,7 +146,17 @@ static const float kWebDefaultFlexShrink = 1.0f;
 
 extern bool YGFloatsEqual(const float a, const float b);
 extern facebook::yoga::detail::CompactValue YGComputedEdgeValue(
-    const facebook::yoga::detail::Values<
+    const facebook::yoga::detail::SparseValues<
         facebook::yoga::enums::count<YGEdge>()>& edges,
     YGEdge edge,
     facebook::yoga::detail::CompactValue defaultValue);
+
+// Does the same as `YGRoundValueToPixelGrid` for `count` values. `forceCeil`
+// and `forceFloor` hold a flag for every value.
+extern void YGRoundValuesToPixelGrid(
+    const double* values,
+    const bool* forceCeil,
+    const bool* forceFloor,
+    float* results,
+    const size_t count,
+    const double pointScaleFactor);
@@ -13,10 +13,19 @@
 #include <atomic>
 #include <memory>
 #include "Utils.h"
+#include "YGMeasureCache.h"
 #include "YGNode.h"
 #include "YGNodePrint.h"
 #include "Yoga-internal.h"
 #include "event/event.h"
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YG_PIXEL_GRID_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define YG_PIXEL_GRID_NEON 1
+#endif
 #ifdef _MSC_VER
 #include <float.h>
 
@@ -356,7 +365,7 @@ YOGA_EXPORT void YGNodeSetIsReferenceBaseline(
     bool isReferenceBaseline) {
   if (node->isReferenceBaseline() != isReferenceBaseline) {
     node->setIsReferenceBaseline(isReferenceBaseline);
-    node->markDirtyAndPropogate();
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -521,7 +530,7 @@ YOGA_EXPORT void YGNodeCopyStyle(
     const YGNodeRef srcNode) {
   if (!(dstNode->getStyle() == srcNode->getStyle())) {
     dstNode->setStyle(srcNode->getStyle());
-    dstNode->markDirtyAndPropogate();
+    dstNode->markStyleDirtyAndPropogate();
   }
 }
 
@@ -546,9 +555,11 @@ void updateStyle(
     T value,
     NeedsUpdate&& needsUpdate,
     Update&& update) {
-  if (needsUpdate(node->getStyle(), value)) {
-    update(node->getStyle(), value);
-    node->markDirtyAndPropogate();
+  // Reading through the style refs does not write to the style, so that the
+  // style of the node is only copied (if shared) when the value changes.
+  if (needsUpdate(const_cast<YGStyle&>(node->getStyle()), value)) {
+    update(node->getMutableStyle(), value);
+    node->markStyleDirtyAndPropogate();
   }
 }
 
@@ -1005,6 +1016,12 @@ YOGA_EXPORT bool YGNodeLayoutGetDidLegacyStretchFlagAffectLayout(
 
 std::atomic<uint32_t> gCurrentGenerationCount(0);
 
+// Unlike `YGFloatsEqual`, doesn't tolerate any difference. Lets layout skip
+// writes of unchanged values.
+static inline bool YGFloatsIdentical(const float a, const float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
 bool YGLayoutNodeInternal(
     const YGNodeRef node,
     const float availableWidth,
@@ -1022,6 +1039,122 @@ bool YGLayoutNodeInternal(
     const uint32_t depth,
     const uint32_t generationCount);
 
+// Set while a task dispatched to the parallel executor of a config is running
+// on the current thread. Nested batches are laid out serially, so executors
+// never have to wait for tasks they run themselves.
+static thread_local bool gIsInParallelLayout = false;
+
+static void YGMergeLayoutData(LayoutData& into, const LayoutData& from) {
+  into.layouts += from.layouts;
+  into.measures += from.measures;
+  into.maxMeasureCache = std::max(into.maxMeasureCache, from.maxMeasureCache);
+  into.cachedLayouts += from.cachedLayouts;
+  into.cachedMeasures += from.cachedMeasures;
+  into.measureCallbacks += from.measureCallbacks;
+  into.sharedMeasureCacheHits += from.sharedMeasureCacheHits;
+  into.sharedMeasureCacheMisses += from.sharedMeasureCacheMisses;
+  for (size_t i = 0; i < into.measureCallbackReasonsCount.size(); i++) {
+    into.measureCallbackReasonsCount[i] += from.measureCallbackReasonsCount[i];
+  }
+  for (size_t i = 0; i < into.nodeLayoutReasonsCount.size(); i++) {
+    for (size_t j = 0; j < into.nodeLayoutReasonsCount[i].size(); j++) {
+      into.nodeLayoutReasonsCount[i][j] += from.nodeLayoutReasonsCount[i][j];
+    }
+  }
+}
+
+// Calls `layoutChild(index, layoutMarkerData)` for every index in
+// [0, count). The calls must be independent of each other (each of them may
+// only mutate the subtree of one child). If the config has a parallel executor
+// and the batch is large enough, the calls are dispatched to the executor, each
+// with its own `LayoutData` which is merged back afterwards.
+template <typename LayoutChildFn>
+static void YGLayoutChildrenInParallelIfNeeded(
+    const YGConfigRef config,
+    const uint32_t count,
+    LayoutData& layoutMarkerData,
+    LayoutChildFn&& layoutChild) {
+  if (config->parallelForFunc == nullptr ||
+      count < config->parallelLayoutThreshold || count < 2 ||
+      gIsInParallelLayout) {
+    for (uint32_t i = 0; i < count; i++) {
+      layoutChild(i, layoutMarkerData);
+    }
+    return;
+  }
+
+  struct Context {
+    LayoutChildFn* layoutChild;
+    LayoutData* layoutMarkerData;
+  };
+
+  std::vector<LayoutData> taskLayoutMarkerData(count, LayoutData{});
+  Context context{&layoutChild, taskLayoutMarkerData.data()};
+
+  config->parallelForFunc(
+      config,
+      count,
+      [](void* taskContext, uint32_t index) {
+        auto& context = *static_cast<Context*>(taskContext);
+        const bool wasInParallelLayout = gIsInParallelLayout;
+        gIsInParallelLayout = true;
+        (*context.layoutChild)(index, context.layoutMarkerData[index]);
+        gIsInParallelLayout = wasInParallelLayout;
+      },
+      &context);
+
+  for (const auto& data : taskLayoutMarkerData) {
+    YGMergeLayoutData(layoutMarkerData, data);
+  }
+}
+
+// Arguments of a recursive `YGLayoutNodeInternal` call which does not affect
+// the siblings of the child and can be performed later.
+struct YGDeferredChildLayout {
+  YGNodeRef child;
+  float width;
+  float height;
+  YGMeasureMode widthMeasureMode;
+  YGMeasureMode heightMeasureMode;
+  bool performLayout;
+  LayoutPassReason reason;
+};
+
+static void YGLayoutDeferredChildren(
+    const std::vector<YGDeferredChildLayout>& childLayouts,
+    const YGDirection direction,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    const YGConfigRef config,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext,
+    const uint32_t depth,
+    const uint32_t generationCount) {
+  YGLayoutChildrenInParallelIfNeeded(
+      config,
+      static_cast<uint32_t>(childLayouts.size()),
+      layoutMarkerData,
+      [&](const uint32_t index, LayoutData& childLayoutMarkerData) {
+        const YGDeferredChildLayout& childLayout = childLayouts[index];
+        YGLayoutNodeInternal(
+            childLayout.child,
+            childLayout.width,
+            childLayout.height,
+            direction,
+            childLayout.widthMeasureMode,
+            childLayout.heightMeasureMode,
+            availableInnerWidth,
+            availableInnerHeight,
+            childLayout.performLayout,
+            childLayout.reason,
+            config,
+            childLayoutMarkerData,
+            layoutContext,
+            depth,
+            generationCount);
+      });
+}
+
 #ifdef DEBUG
 static void YGNodePrintInternal(
     const YGNodeRef node,
@@ -1719,30 +1852,61 @@ static void YGNodeWithMeasureFuncSetMeasuredDimensions(
             ownerWidth),
         YGDimensionHeight);
   } else {
-    Event::publish<Event::MeasureCallbackStart>(node);
+    // Consulting the measure cache shared between nodes first.
+    const YGConfigRef config = node->getConfig();
+    uint64_t contentHash = config->measureCache != nullptr &&
+            config->measureContentHashFunc != nullptr
+        ? config->measureContentHashFunc(node)
+        : 0;
+    std::shared_ptr<const YGMeasureCache::Content> content;
+    if (contentHash != 0 && config->measureContentFunc != nullptr) {
+      content = config->measureContentFunc(node);
+      if (content == nullptr) {
+        contentHash = 0;
+      }
+    }
+    const YGMeasureCache::Key cacheKey = {contentHash,
+                                          innerWidth,
+                                          innerHeight,
+                                          widthMeasureMode,
+                                          heightMeasureMode,
+                                          std::move(content)};
+
+    YGSize measuredSize;
+    if (contentHash != 0 &&
+        config->measureCache->get(cacheKey, measuredSize)) {
+      layoutMarkerData.sharedMeasureCacheHits += 1;
+    } else {
+      Event::publish<Event::MeasureCallbackStart>(node);
 
-    // Measure the text under the current constraints.
-    const YGSize measuredSize = node->measure(
-        innerWidth,
-        widthMeasureMode,
-        innerHeight,
-        heightMeasureMode,
-        layoutContext);
+      // Measure the text under the current constraints.
+      measuredSize = node->measure(
+          innerWidth,
+          widthMeasureMode,
+          innerHeight,
+          heightMeasureMode,
+          layoutContext);
 
-    layoutMarkerData.measureCallbacks += 1;
-    layoutMarkerData.measureCallbackReasonsCount[static_cast<size_t>(reason)] +=
-        1;
+      layoutMarkerData.measureCallbacks += 1;
+      layoutMarkerData
+          .measureCallbackReasonsCount[static_cast<size_t>(reason)] += 1;
 
-    Event::publish<Event::MeasureCallbackEnd>(
-        node,
-        {layoutContext,
-         innerWidth,
-         widthMeasureMode,
-         innerHeight,
-         heightMeasureMode,
-         measuredSize.width,
-         measuredSize.height,
-         reason});
+      Event::publish<Event::MeasureCallbackEnd>(
+          node,
+          {layoutContext,
+           innerWidth,
+           widthMeasureMode,
+           innerHeight,
+           heightMeasureMode,
+           measuredSize.width,
+           measuredSize.height,
+           reason});
+
+      if (contentHash != 0) {
+        layoutMarkerData.sharedMeasureCacheMisses += 1;
+        config->measureCache->set(cacheKey, measuredSize);
+      }
+    }
 
     node->setLayoutMeasuredDimension(
         YGNodeBoundAxis(
@@ -1867,7 +2031,7 @@ static bool YGNodeFixedSizeSetMeasuredDimensions(
 static void YGZeroOutLayoutRecursivly(
     const YGNodeRef node,
     void* layoutContext) {
-  node->getLayout() = {};
+  node->setLayout({});
   node->setLayoutDimension(0, 0);
   node->setLayoutDimension(0, 1);
   node->setHasNewLayout(true);
@@ -2122,6 +2286,12 @@ static float YGDistributeFreeSpaceSecondPass(
   const bool isMainAxisRow = YGFlexDirectionIsRow(mainAxis);
   const bool isNodeFlexWrap = node->getStyle().flexWrap() != YGWrapNoWrap;
 
+  // The sizes of the items do not depend on the layout of their siblings, so
+  // the recursive layout calls are collected and performed after the loop
+  // (possibly in parallel).
+  std::vector<YGDeferredChildLayout> childLayouts;
+  childLayouts.reserve(collectedFlexItemsValues.relativeChildren.size());
+
   for (auto currentRelativeChild : collectedFlexItemsValues.relativeChildren) {
     childFlexBasis = YGNodeBoundAxisWithinMinAndMax(
                          currentRelativeChild,
@@ -2266,28 +2436,33 @@ static float YGDistributeFreeSpaceSecondPass(
         !isMainAxisRow ? childMainMeasureMode : childCrossMeasureMode;
 
     const bool isLayoutPass = performLayout && !requiresStretchLayout;
-    // Recursively call the layout algorithm for this child with the updated
-    // main size.
-    YGLayoutNodeInternal(
-        currentRelativeChild,
-        childWidth,
-        childHeight,
-        node->getLayout().direction(),
-        childWidthMeasureMode,
-        childHeightMeasureMode,
-        availableInnerWidth,
-        availableInnerHeight,
-        isLayoutPass,
-        isLayoutPass ? LayoutPassReason::kFlexLayout
-                     : LayoutPassReason::kFlexMeasure,
-        config,
-        layoutMarkerData,
-        layoutContext,
-        depth,
-        generationCount);
+    childLayouts.push_back({currentRelativeChild,
+                            childWidth,
+                            childHeight,
+                            childWidthMeasureMode,
+                            childHeightMeasureMode,
+                            isLayoutPass,
+                            isLayoutPass ? LayoutPassReason::kFlexLayout
+                                         : LayoutPassReason::kFlexMeasure});
+  }
+
+  // Recursively call the layout algorithm for the children with the updated
+  // main sizes.
+  YGLayoutDeferredChildren(
+      childLayouts,
+      node->getLayout().direction(),
+      availableInnerWidth,
+      availableInnerHeight,
+      config,
+      layoutMarkerData,
+      layoutContext,
+      depth,
+      generationCount);
+
+  for (const auto& childLayout : childLayouts) {
     node->setLayoutHadOverflow(
         node->getLayout().hadOverflow() |
-        currentRelativeChild->getLayout().hadOverflow());
+        childLayout.child->getLayout().hadOverflow());
   }
   return deltaFreeSpace;
 }
@@ -3105,6 +3280,8 @@ static void YGNodelayoutImpl(
     // STEP 7: CROSS-AXIS ALIGNMENT
     // We can skip child alignment if we're just measuring the container.
     if (performLayout) {
+      // Stretched children are laid out after their positions are set.
+      std::vector<YGDeferredChildLayout> stretchedChildLayouts;
       for (uint32_t i = startOfLineIndex; i < endOfLineIndex; i++) {
         const YGNodeRef child = node->getChild(i);
         if (child->getStyle().display() == YGDisplayNone) {
@@ -3204,22 +3381,13 @@ static void YGNodelayoutImpl(
                   ? YGMeasureModeUndefined
                   : YGMeasureModeExactly;
 
-              YGLayoutNodeInternal(
-                  child,
-                  childWidth,
-                  childHeight,
-                  direction,
-                  childWidthMeasureMode,
-                  childHeightMeasureMode,
-                  availableInnerWidth,
-                  availableInnerHeight,
-                  true,
-                  LayoutPassReason::kStretch,
-                  config,
-                  layoutMarkerData,
-                  layoutContext,
-                  depth,
-                  generationCount);
+              stretchedChildLayouts.push_back({child,
+                                               childWidth,
+                                               childHeight,
+                                               childWidthMeasureMode,
+                                               childHeightMeasureMode,
+                                               true,
+                                               LayoutPassReason::kStretch});
             }
           } else {
             const float remainingCrossDim = containerCrossAxis -
@@ -3249,6 +3417,17 @@ static void YGNodelayoutImpl(
               pos[crossAxis]);
         }
       }
+
+      YGLayoutDeferredChildren(
+          stretchedChildLayouts,
+          direction,
+          availableInnerWidth,
+          availableInnerHeight,
+          config,
+          layoutMarkerData,
+          layoutContext,
+          depth,
+          generationCount);
     }
 
     totalLineCrossDim += collectedFlexItemsValues.crossDim;
@@ -3556,23 +3735,32 @@ static void YGNodelayoutImpl(
 
   if (performLayout) {
     // STEP 10: SIZING AND POSITIONING ABSOLUTE CHILDREN
+    // Absolute children are laid out against the final size of the node and
+    // do not affect each other, so they can be laid out in parallel.
+    std::vector<YGNodeRef> absoluteChildren;
     for (auto child : node->getChildren()) {
-      if (child->getStyle().positionType() != YGPositionTypeAbsolute) {
-        continue;
+      if (child->getStyle().positionType() == YGPositionTypeAbsolute) {
+        absoluteChildren.push_back(child);
       }
-      YGNodeAbsoluteLayoutChild(
-          node,
-          child,
-          availableInnerWidth,
-          isMainAxisRow ? measureModeMainDim : measureModeCrossDim,
-          availableInnerHeight,
-          direction,
-          config,
-          layoutMarkerData,
-          layoutContext,
-          depth,
-          generationCount);
     }
+    YGLayoutChildrenInParallelIfNeeded(
+        config,
+        static_cast<uint32_t>(absoluteChildren.size()),
+        layoutMarkerData,
+        [&](const uint32_t index, LayoutData& childLayoutMarkerData) {
+          YGNodeAbsoluteLayoutChild(
+              node,
+              absoluteChildren[index],
+              availableInnerWidth,
+              isMainAxisRow ? measureModeMainDim : measureModeCrossDim,
+              availableInnerHeight,
+              direction,
+              config,
+              childLayoutMarkerData,
+              layoutContext,
+              depth,
+              generationCount);
+        });
 
     // STEP 11: SETTING TRAILING POSITIONS FOR CHILDREN
     const bool needsMainTrailingPos = mainAxis == YGFlexDirectionRowReverse ||
@@ -3711,6 +3899,129 @@ YOGA_EXPORT float YGRoundValueToPixelGrid(
       : scaledValue / pointScaleFactor;
 }
 
+// Rounds two values at a time where SSE2 or (64-bit) NEON is available.
+YOGA_EXPORT void YGRoundValuesToPixelGrid(
+    const double* values,
+    const bool* forceCeil,
+    const bool* forceFloor,
+    float* results,
+    const size_t count,
+    const double pointScaleFactor) {
+  size_t i = 0;
+#if defined(YG_PIXEL_GRID_SSE2) || defined(YG_PIXEL_GRID_NEON)
+  // Same epsilon as `YGDoubleEqual`.
+  const double epsilon = 0.0001f;
+#endif
+#if defined(YG_PIXEL_GRID_SSE2)
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d half = _mm_set1_pd(0.5);
+  const __m128d eps = _mm_set1_pd(epsilon);
+  const __m128d signMask = _mm_set1_pd(-0.0);
+  const __m128d twoTo52 = _mm_set1_pd(4503599627370496.0);
+  const __m128d scale = _mm_set1_pd(pointScaleFactor);
+  const __m128d scaleIsNaN = _mm_cmpunord_pd(scale, scale);
+  for (; i + 2 <= count; i += 2) {
+    const __m128d scaledValue = _mm_mul_pd(_mm_loadu_pd(values + i), scale);
+
+    // `trunc(scaledValue)`: magnitudes below 2^52 are rounded by adding and
+    // subtracting 2^52 (which rounds to nearest) and corrected downwards,
+    // bigger ones are integral already.
+    const __m128d magnitude = _mm_andnot_pd(signMask, scaledValue);
+    __m128d truncated =
+        _mm_sub_pd(_mm_add_pd(magnitude, twoTo52), twoTo52);
+    truncated = _mm_sub_pd(
+        truncated, _mm_and_pd(_mm_cmpgt_pd(truncated, magnitude), one));
+    const __m128d isSmall = _mm_cmplt_pd(magnitude, twoTo52);
+    truncated = _mm_or_pd(
+        _mm_and_pd(isSmall, truncated), _mm_andnot_pd(isSmall, magnitude));
+    truncated = _mm_or_pd(truncated, _mm_and_pd(signMask, scaledValue));
+
+    // `fmod(scaledValue, 1.0)`, moved to [0, 1) for negative values.
+    __m128d fractial = _mm_sub_pd(scaledValue, truncated);
+    fractial =
+        _mm_add_pd(fractial, _mm_and_pd(_mm_cmplt_pd(fractial, zero), one));
+
+    const __m128d isZero =
+        _mm_cmplt_pd(_mm_andnot_pd(signMask, fractial), eps);
+    const __m128d isOne = _mm_cmplt_pd(
+        _mm_andnot_pd(signMask, _mm_sub_pd(fractial, one)), eps);
+    const __m128d isHalfOrMore = _mm_or_pd(
+        _mm_cmpgt_pd(fractial, half),
+        _mm_cmplt_pd(
+            _mm_andnot_pd(signMask, _mm_sub_pd(fractial, half)), eps));
+    const __m128d ceil = _mm_castsi128_pd(_mm_set_epi64x(
+        forceCeil[i + 1] ? -1 : 0, forceCeil[i] ? -1 : 0));
+    const __m128d floor = _mm_castsi128_pd(_mm_set_epi64x(
+        forceFloor[i + 1] ? -1 : 0, forceFloor[i] ? -1 : 0));
+
+    const __m128d roundsUp = _mm_andnot_pd(
+        isZero,
+        _mm_or_pd(
+            _mm_or_pd(isOne, ceil), _mm_andnot_pd(floor, isHalfOrMore)));
+    const __m128d roundedDown = _mm_sub_pd(scaledValue, fractial);
+    const __m128d rounded = _mm_or_pd(
+        _mm_and_pd(roundsUp, _mm_add_pd(roundedDown, one)),
+        _mm_andnot_pd(roundsUp, roundedDown));
+
+    const __m128d isUndefined =
+        _mm_or_pd(_mm_cmpunord_pd(rounded, rounded), scaleIsNaN);
+    const __m128d result = _mm_or_pd(
+        _mm_and_pd(isUndefined, _mm_set1_pd(YGUndefined)),
+        _mm_andnot_pd(isUndefined, _mm_div_pd(rounded, scale)));
+    _mm_storel_pi(
+        reinterpret_cast<__m64*>(results + i), _mm_cvtpd_ps(result));
+  }
+#elif defined(YG_PIXEL_GRID_NEON)
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  const float64x2_t one = vdupq_n_f64(1.0);
+  const float64x2_t half = vdupq_n_f64(0.5);
+  const float64x2_t eps = vdupq_n_f64(epsilon);
+  const float64x2_t scale = vdupq_n_f64(pointScaleFactor);
+  const float64x2_t undefined = vdupq_n_f64(YGUndefined);
+  const uint64x2_t scaleIsNaN = vreinterpretq_u64_u32(
+      vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64(scale, scale))));
+  for (; i + 2 <= count; i += 2) {
+    const float64x2_t scaledValue = vmulq_f64(vld1q_f64(values + i), scale);
+
+    // `fmod(scaledValue, 1.0)`, moved to [0, 1) for negative values.
+    float64x2_t fractial = vsubq_f64(scaledValue, vrndq_f64(scaledValue));
+    fractial = vbslq_f64(
+        vcltq_f64(fractial, zero), vaddq_f64(fractial, one), fractial);
+
+    const uint64x2_t isZero = vcltq_f64(vabsq_f64(fractial), eps);
+    const uint64x2_t isOne =
+        vcltq_f64(vabsq_f64(vsubq_f64(fractial, one)), eps);
+    const uint64x2_t isHalfOrMore = vorrq_u64(
+        vcgtq_f64(fractial, half),
+        vcltq_f64(vabsq_f64(vsubq_f64(fractial, half)), eps));
+    const uint64x2_t ceil = {
+        forceCeil[i] ? ~0ull : 0ull, forceCeil[i + 1] ? ~0ull : 0ull};
+    const uint64x2_t floor = {
+        forceFloor[i] ? ~0ull : 0ull, forceFloor[i + 1] ? ~0ull : 0ull};
+
+    const uint64x2_t roundsUp = vbicq_u64(
+        vorrq_u64(vorrq_u64(isOne, ceil), vbicq_u64(isHalfOrMore, floor)),
+        isZero);
+    const float64x2_t roundedDown = vsubq_f64(scaledValue, fractial);
+    const float64x2_t rounded =
+        vbslq_f64(roundsUp, vaddq_f64(roundedDown, one), roundedDown);
+
+    const uint64x2_t isUndefined = vorrq_u64(
+        vreinterpretq_u64_u32(
+            vmvnq_u32(vreinterpretq_u32_u64(vceqq_f64(rounded, rounded)))),
+        scaleIsNaN);
+    const float64x2_t result =
+        vbslq_f64(isUndefined, undefined, vdivq_f64(rounded, scale));
+    vst1_f32(results + i, vcvt_f32_f64(result));
+  }
+#endif
+  for (; i < count; i++) {
+    results[i] = YGRoundValueToPixelGrid(
+        values[i], pointScaleFactor, forceCeil[i], forceFloor[i]);
+  }
+}
+
 YOGA_EXPORT bool YGNodeCanUseCachedMeasurement(
     const YGMeasureMode widthMode,
     const float width,
@@ -3807,26 +4118,31 @@ bool YGLayoutNodeInternal(
     void* const layoutContext,
     uint32_t depth,
     const uint32_t generationCount) {
-  YGLayout* layout = &node->getLayout();
-
   depth++;
 
   const bool needToVisitNode =
-      (node->isDirty() && layout->generationCount != generationCount) ||
-      layout->lastOwnerDirection != ownerDirection;
+      (node->isDirty() &&
+       node->getLayout().generationCount != generationCount) ||
+      node->getLayout().lastOwnerDirection != ownerDirection;
 
   if (needToVisitNode) {
     // Invalidate the cached results.
-    layout->nextCachedMeasurementsIndex = 0;
-    layout->cachedLayout.availableWidth = -1;
-    layout->cachedLayout.availableHeight = -1;
-    layout->cachedLayout.widthMeasureMode = YGMeasureModeUndefined;
-    layout->cachedLayout.heightMeasureMode = YGMeasureModeUndefined;
-    layout->cachedLayout.computedWidth = -1;
-    layout->cachedLayout.computedHeight = -1;
+    YGLayout& layout = node->getMutableLayout();
+    layout.nextCachedMeasurementsIndex = 0;
+    layout.cachedLayout.availableWidth = -1;
+    layout.cachedLayout.availableHeight = -1;
+    layout.cachedLayout.widthMeasureMode = YGMeasureModeUndefined;
+    layout.cachedLayout.heightMeasureMode = YGMeasureModeUndefined;
+    layout.cachedLayout.computedWidth = -1;
+    layout.cachedLayout.computedHeight = -1;
   }
 
-  YGCachedMeasurement* cachedResults = nullptr;
+  // The layout is only read until it's known whether the results are cached:
+  // a layout block shared with a clone of the node is copied by the first
+  // write (see `YGNode::getMutableLayout()`), which a cache hit mostly avoids.
+  // The reference is not valid anymore once the layout is written.
+  const YGLayout* layout = &node->getLayout();
+  const YGCachedMeasurement* cachedResults = nullptr;
 
   // Determine whether the results are already cached. We maintain a separate
   // cache for layouts and measurements. A layout operation modifies the
@@ -3902,10 +4218,19 @@ bool YGLayoutNodeInternal(
     }
   }
 
+  const bool isCachedLayout = cachedResults == &layout->cachedLayout;
+
   if (!needToVisitNode && cachedResults != nullptr) {
-    layout->measuredDimensions[YGDimensionWidth] = cachedResults->computedWidth;
-    layout->measuredDimensions[YGDimensionHeight] =
-        cachedResults->computedHeight;
+    const float computedWidth = cachedResults->computedWidth;
+    const float computedHeight = cachedResults->computedHeight;
+    if (!YGFloatsIdentical(
+            layout->measuredDimensions[YGDimensionWidth], computedWidth) ||
+        !YGFloatsIdentical(
+            layout->measuredDimensions[YGDimensionHeight], computedHeight)) {
+      YGLayout& mutableLayout = node->getMutableLayout();
+      mutableLayout.measuredDimensions[YGDimensionWidth] = computedWidth;
+      mutableLayout.measuredDimensions[YGDimensionHeight] = computedHeight;
+    }
 
     (performLayout ? layoutMarkerData.cachedLayouts
                    : layoutMarkerData.cachedMeasures) += 1;
@@ -3928,8 +4253,8 @@ bool YGLayoutNodeInternal(
           YGMeasureModeName(heightMeasureMode, performLayout),
           availableWidth,
           availableHeight,
-          cachedResults->computedWidth,
-          cachedResults->computedHeight,
+          computedWidth,
+          computedHeight,
           LayoutPassReasonToString(reason));
     }
   } else {
@@ -3972,6 +4297,9 @@ bool YGLayoutNodeInternal(
         generationCount,
         reason);
 
+    // Laying the node out wrote its layout, so it's not shared anymore.
+    YGLayout* mutableLayout = &node->getMutableLayout();
+
     if (gPrintChanges) {
       Log::log(
           node,
@@ -3989,35 +4317,36 @@ bool YGLayoutNodeInternal(
           "wm: %s, hm: %s, d: (%f, %f) %s\n",
           YGMeasureModeName(widthMeasureMode, performLayout),
           YGMeasureModeName(heightMeasureMode, performLayout),
-          layout->measuredDimensions[YGDimensionWidth],
-          layout->measuredDimensions[YGDimensionHeight],
+          mutableLayout->measuredDimensions[YGDimensionWidth],
+          mutableLayout->measuredDimensions[YGDimensionHeight],
           LayoutPassReasonToString(reason));
     }
 
-    layout->lastOwnerDirection = ownerDirection;
+    mutableLayout->lastOwnerDirection = ownerDirection;
 
     if (cachedResults == nullptr) {
-      if (layout->nextCachedMeasurementsIndex + 1 >
+      if (mutableLayout->nextCachedMeasurementsIndex + 1 >
           (uint32_t) layoutMarkerData.maxMeasureCache) {
         layoutMarkerData.maxMeasureCache =
-            layout->nextCachedMeasurementsIndex + 1;
+            mutableLayout->nextCachedMeasurementsIndex + 1;
       }
-      if (layout->nextCachedMeasurementsIndex == YG_MAX_CACHED_RESULT_COUNT) {
+      if (mutableLayout->nextCachedMeasurementsIndex ==
+          YG_MAX_CACHED_RESULT_COUNT) {
         if (gPrintChanges) {
           Log::log(node, YGLogLevelVerbose, nullptr, "Out of cache entries!\n");
         }
-        layout->nextCachedMeasurementsIndex = 0;
+        mutableLayout->nextCachedMeasurementsIndex = 0;
       }
 
       YGCachedMeasurement* newCacheEntry;
       if (performLayout) {
         // Use the single layout cache entry.
-        newCacheEntry = &layout->cachedLayout;
+        newCacheEntry = &mutableLayout->cachedLayout;
       } else {
         // Allocate a new measurement cache entry.
-        newCacheEntry =
-            &layout->cachedMeasurements[layout->nextCachedMeasurementsIndex];
-        layout->nextCachedMeasurementsIndex++;
+        newCacheEntry = &mutableLayout->cachedMeasurements
+                             [mutableLayout->nextCachedMeasurementsIndex];
+        mutableLayout->nextCachedMeasurementsIndex++;
       }
 
       newCacheEntry->availableWidth = availableWidth;
@@ -4025,36 +4354,45 @@ bool YGLayoutNodeInternal(
       newCacheEntry->widthMeasureMode = widthMeasureMode;
       newCacheEntry->heightMeasureMode = heightMeasureMode;
       newCacheEntry->computedWidth =
-          layout->measuredDimensions[YGDimensionWidth];
+          mutableLayout->measuredDimensions[YGDimensionWidth];
       newCacheEntry->computedHeight =
-          layout->measuredDimensions[YGDimensionHeight];
+          mutableLayout->measuredDimensions[YGDimensionHeight];
     }
   }
 
   if (performLayout) {
-    node->setLayoutDimension(
-        node->getLayout().measuredDimensions[YGDimensionWidth],
-        YGDimensionWidth);
-    node->setLayoutDimension(
-        node->getLayout().measuredDimensions[YGDimensionHeight],
-        YGDimensionHeight);
+    for (auto dimension : {YGDimensionWidth, YGDimensionHeight}) {
+      const float measuredDimension =
+          node->getLayout().measuredDimensions[dimension];
+      if (!YGFloatsIdentical(
+              node->getLayout().dimensions[dimension], measuredDimension)) {
+        node->setLayoutDimension(measuredDimension, dimension);
+      }
+    }
 
     node->setHasNewLayout(true);
     node->setDirty(false);
   }
 
-  layout->generationCount = generationCount;
+  // The generation only tells whether a dirty node was visited in the current
+  // pass. Using cached results doesn't visit the node, and a node using them
+  // is either clean or was visited in this pass already.
+  if (needToVisitNode || cachedResults == nullptr) {
+    node->getMutableLayout().generationCount = generationCount;
+  }
 
   LayoutType layoutType;
   if (performLayout) {
-    layoutType = !needToVisitNode && cachedResults == &layout->cachedLayout
+    layoutType = !needToVisitNode && isCachedLayout
         ? LayoutType::kCachedLayout
         : LayoutType::kLayout;
   } else {
     layoutType = cachedResults != nullptr ? LayoutType::kCachedMeasure
                                           : LayoutType::kMeasure;
   }
-  Event::publish<Event::NodeLayout>(node, {layoutType, layoutContext});
+  layoutMarkerData.nodeLayoutReasonsCount[static_cast<size_t>(layoutType)]
+                                        [static_cast<size_t>(reason)] += 1;
+  Event::publish<Event::NodeLayout>(node, {layoutType, layoutContext, reason});
 
   return (needToVisitNode || cachedResults == nullptr);
 }
@@ -4076,77 +4414,358 @@ YOGA_EXPORT void YGConfigSetPointScaleFactor(
   }
 }
 
+// Rounding is done for batches of siblings, so that their positions and
+// dimensions can be gathered and rounded together.
+static constexpr uint32_t kPixelGridBatchSize = 8;
+
+// Rounds the layout of up to `kPixelGridBatchSize` nodes with the same owner,
+// whose unrounded position relative to the root is `ownerAbsoluteLeft` and
+// `ownerAbsoluteTop`. The unrounded positions of the nodes relative to the root
+// are stored in `absoluteLefts` and `absoluteTops`.
+static void YGRoundNodeBatchToPixelGrid(
+    const YGNodeRef* nodes,
+    const uint32_t count,
+    const double pointScaleFactor,
+    const double ownerAbsoluteLeft,
+    const double ownerAbsoluteTop,
+    double* absoluteLefts,
+    double* absoluteTops) {
+  // For every node: the left and top position, the absolute left and top
+  // position and the absolute right and bottom position, in this order.
+  constexpr uint32_t valuesPerNode = 6;
+  double values[valuesPerNode * kPixelGridBatchSize] = {};
+  bool forceCeil[valuesPerNode * kPixelGridBatchSize] = {};
+  bool forceFloor[valuesPerNode * kPixelGridBatchSize] = {};
+  float results[valuesPerNode * kPixelGridBatchSize];
+
+  for (uint32_t i = 0; i < count; i++) {
+    const YGLayout& layout = nodes[i]->getLayout();
+    const double nodeLeft = layout.position[YGEdgeLeft];
+    const double nodeTop = layout.position[YGEdgeTop];
+    const double nodeWidth = layout.dimensions[YGDimensionWidth];
+    const double nodeHeight = layout.dimensions[YGDimensionHeight];
+
+    absoluteLefts[i] = ownerAbsoluteLeft + nodeLeft;
+    absoluteTops[i] = ownerAbsoluteTop + nodeTop;
+
+    // If a node has a custom measure function we never want to round down its
+    // size as this could lead to unwanted text truncation.
+    const bool textRounding = nodes[i]->getNodeType() == YGNodeTypeText;
+
+    // We multiply dimension by scale factor and if the result is close to the
+    // whole number, we don't have any fraction To verify if the result is
+    // close to whole number we want to check both floor and ceil numbers
+    const bool hasFractionalWidth = textRounding &&
+        !YGDoubleEqual(fmod(nodeWidth * pointScaleFactor, 1.0), 0) &&
+        !YGDoubleEqual(fmod(nodeWidth * pointScaleFactor, 1.0), 1.0);
+    const bool hasFractionalHeight = textRounding &&
+        !YGDoubleEqual(fmod(nodeHeight * pointScaleFactor, 1.0), 0) &&
+        !YGDoubleEqual(fmod(nodeHeight * pointScaleFactor, 1.0), 1.0);
+
+    const double nodeValues[valuesPerNode] = {
+        nodeLeft,
+        nodeTop,
+        absoluteLefts[i],
+        absoluteTops[i],
+        absoluteLefts[i] + nodeWidth,
+        absoluteTops[i] + nodeHeight};
+    const bool nodeForceCeil[valuesPerNode] = {
+        false, false, false, false, hasFractionalWidth, hasFractionalHeight};
+    const bool nodeForceFloor[valuesPerNode] = {
+        textRounding,
+        textRounding,
+        textRounding,
+        textRounding,
+        textRounding && !hasFractionalWidth,
+        textRounding && !hasFractionalHeight};
+    for (uint32_t j = 0; j < valuesPerNode; j++) {
+      values[j * count + i] = nodeValues[j];
+      forceCeil[j * count + i] = nodeForceCeil[j];
+      forceFloor[j * count + i] = nodeForceFloor[j];
+    }
+  }
+
+  YGRoundValuesToPixelGrid(
+      values,
+      forceCeil,
+      forceFloor,
+      results,
+      valuesPerNode * count,
+      pointScaleFactor);
+
+  for (uint32_t i = 0; i < count; i++) {
+    nodes[i]->setLayoutRoundedPosition(results[i], YGEdgeLeft);
+    nodes[i]->setLayoutRoundedPosition(results[count + i], YGEdgeTop);
+    nodes[i]->setLayoutDimension(
+        results[4 * count + i] - results[2 * count + i], YGDimensionWidth);
+    nodes[i]->setLayoutDimension(
+        results[5 * count + i] - results[3 * count + i], YGDimensionHeight);
+  }
+}
+
+static void YGRoundNodesToPixelGrid(
+    const YGNodeRef* nodes,
+    const uint32_t count,
+    const double pointScaleFactor,
+    const double ownerAbsoluteLeft,
+    const double ownerAbsoluteTop,
+    double* absoluteLefts,
+    double* absoluteTops) {
+  for (uint32_t start = 0; start < count; start += kPixelGridBatchSize) {
+    YGRoundNodeBatchToPixelGrid(
+        nodes + start,
+        std::min(kPixelGridBatchSize, count - start),
+        pointScaleFactor,
+        ownerAbsoluteLeft,
+        ownerAbsoluteTop,
+        absoluteLefts + start,
+        absoluteTops + start);
+  }
+}
+
+static void YGRoundDescendantsToPixelGrid(
+    const YGNodeRef node,
+    const double pointScaleFactor,
+    const double absoluteLeft,
+    const double absoluteTop) {
+  const YGVector& children = node->getChildren();
+  const uint32_t childCount = static_cast<uint32_t>(children.size());
+  for (uint32_t start = 0; start < childCount; start += kPixelGridBatchSize) {
+    const uint32_t count = std::min(kPixelGridBatchSize, childCount - start);
+    double absoluteLefts[kPixelGridBatchSize];
+    double absoluteTops[kPixelGridBatchSize];
+    YGRoundNodeBatchToPixelGrid(
+        children.data() + start,
+        count,
+        pointScaleFactor,
+        absoluteLeft,
+        absoluteTop,
+        absoluteLefts,
+        absoluteTops);
+    for (uint32_t i = 0; i < count; i++) {
+      YGRoundDescendantsToPixelGrid(
+          children[start + i],
+          pointScaleFactor,
+          absoluteLefts[i],
+          absoluteTops[i]);
+    }
+  }
+}
+
 static void YGRoundToPixelGrid(
     const YGNodeRef node,
     const double pointScaleFactor,
     const double absoluteLeft,
     const double absoluteTop) {
-  if (pointScaleFactor == 0.0f) {
+  if (pointScaleFactor == 0.0f || node->getConfig()->deferPixelGridRounding) {
     return;
   }
 
-  const double nodeLeft = node->getLayout().position[YGEdgeLeft];
-  const double nodeTop = node->getLayout().position[YGEdgeTop];
-
-  const double nodeWidth = node->getLayout().dimensions[YGDimensionWidth];
-  const double nodeHeight = node->getLayout().dimensions[YGDimensionHeight];
+  YGNodeRef nodes[] = {node};
+  double absoluteNodeLeft;
+  double absoluteNodeTop;
+  YGRoundNodeBatchToPixelGrid(
+      nodes,
+      1,
+      pointScaleFactor,
+      absoluteLeft,
+      absoluteTop,
+      &absoluteNodeLeft,
+      &absoluteNodeTop);
+  YGRoundDescendantsToPixelGrid(
+      node, pointScaleFactor, absoluteNodeLeft, absoluteNodeTop);
+}
+
+YOGA_EXPORT void YGNodesRoundToPixelGrid(
+    const YGNodeRef* nodes,
+    const uint32_t count,
+    const float pointScaleFactor,
+    const double ownerAbsoluteLeft,
+    const double ownerAbsoluteTop,
+    double* absoluteLefts,
+    double* absoluteTops) {
+  if (pointScaleFactor == 0.0f) {
+    for (uint32_t i = 0; i < count; i++) {
+      absoluteLefts[i] =
+          ownerAbsoluteLeft + nodes[i]->getLayout().position[YGEdgeLeft];
+      absoluteTops[i] =
+          ownerAbsoluteTop + nodes[i]->getLayout().position[YGEdgeTop];
+    }
+    return;
+  }
 
-  const double absoluteNodeLeft = absoluteLeft + nodeLeft;
-  const double absoluteNodeTop = absoluteTop + nodeTop;
+  YGRoundNodesToPixelGrid(
+      nodes,
+      count,
+      pointScaleFactor,
+      ownerAbsoluteLeft,
+      ownerAbsoluteTop,
+      absoluteLefts,
+      absoluteTops);
+}
+
+// Lays out a dirty relayout boundary on its own, reusing the inputs its owner
+// provided during the last layout pass. `ownerAbsoluteLeft` and
+// `ownerAbsoluteTop` are the unrounded absolute position of the owner, so the
+// result is rounded to the pixel grid exactly as in a full layout pass.
+// Returns true if the relayout was not contained after all (the size or the
+// overflow of the node changed, or the baseline of the node might affect some
+// ancestor); in this case the owner is marked dirty.
+static bool YGLayoutRelayoutBoundary(
+    const YGNodeRef node,
+    const YGNodeRef owner,
+    const double ownerAbsoluteLeft,
+    const double ownerAbsoluteTop,
+    const bool isBaselineSensitive,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext,
+    const uint32_t generationCount) {
+  if (isBaselineSensitive) {
+    // Some ancestor uses baseline alignment, so the content of the node might
+    // affect the position of the ancestor.
+    owner->markDirtyAndPropogate();
+    return true;
+  }
 
-  const double absoluteNodeRight = absoluteNodeLeft + nodeWidth;
-  const double absoluteNodeBottom = absoluteNodeTop + nodeHeight;
+  const YGLayout& layout = node->getLayout();
+  const YGLayout& ownerLayout = owner->getLayout();
+
+  const float width = layout.measuredDimensions[YGDimensionWidth];
+  const float height = layout.measuredDimensions[YGDimensionHeight];
+  const bool hadOverflow = layout.hadOverflow();
+  const std::array<float, 2> unroundedPosition = layout.unroundedPosition;
+
+  // Margins are resolved against the inner width of the owner (see
+  // `YGNodeAbsoluteLayoutChild` and `YGNodeComputeFlexBasisForChildren`).
+  const float ownerInnerWidth =
+      ownerLayout.measuredDimensions[YGDimensionWidth] -
+      ownerLayout.padding[YGEdgeLeft] - ownerLayout.padding[YGEdgeRight] -
+      ownerLayout.border[YGEdgeLeft] - ownerLayout.border[YGEdgeRight];
+  const float ownerInnerHeight =
+      ownerLayout.measuredDimensions[YGDimensionHeight] -
+      ownerLayout.padding[YGEdgeTop] - ownerLayout.padding[YGEdgeBottom] -
+      ownerLayout.border[YGEdgeTop] - ownerLayout.border[YGEdgeBottom];
+  const float marginRow =
+      node->getMarginForAxis(YGFlexDirectionRow, ownerInnerWidth).unwrap();
+  const float marginColumn =
+      node->getMarginForAxis(YGFlexDirectionColumn, ownerInnerWidth).unwrap();
+
+  // Absolutely positioned children are laid out with their own size
+  // (including margins) as the owner size; all other children get the inner
+  // size of the owner.
+  float ownerWidth = ownerInnerWidth;
+  float ownerHeight = ownerInnerHeight;
+  if (node->getStyle().positionType() == YGPositionTypeAbsolute) {
+    ownerWidth = width + marginRow;
+    ownerHeight = height + marginColumn;
+  }
 
-  // If a node has a custom measure function we never want to round down its
-  // size as this could lead to unwanted text truncation.
-  const bool textRounding = node->getNodeType() == YGNodeTypeText;
+  YGLayoutNodeInternal(
+      node,
+      width + marginRow,
+      height + marginColumn,
+      layout.lastOwnerDirection,
+      YGMeasureModeExactly,
+      YGMeasureModeExactly,
+      ownerWidth,
+      ownerHeight,
+      true,
+      LayoutPassReason::kInitial,
+      node->getConfig(),
+      layoutMarkerData,
+      layoutContext,
+      0,
+      generationCount);
 
-  node->setLayoutPosition(
-      YGRoundValueToPixelGrid(nodeLeft, pointScaleFactor, false, textRounding),
-      YGEdgeLeft);
+  // The position of the node was rounded in the last pass; rounding starts
+  // from the unrounded one, as it does when the owner positions the node.
+  node->setLayoutPosition(unroundedPosition[YGEdgeLeft], YGEdgeLeft);
+  node->setLayoutPosition(unroundedPosition[YGEdgeTop], YGEdgeTop);
+  YGRoundToPixelGrid(
+      node,
+      node->getConfig()->pointScaleFactor,
+      ownerAbsoluteLeft,
+      ownerAbsoluteTop);
+
+  // Laying out the node might have replaced its (shared) layout, so `layout`
+  // cannot be used anymore.
+  const YGLayout& newLayout = node->getLayout();
+  const bool isContained =
+      YGFloatsEqual(newLayout.measuredDimensions[YGDimensionWidth], width) &&
+      YGFloatsEqual(newLayout.measuredDimensions[YGDimensionHeight], height) &&
+      newLayout.hadOverflow() == hadOverflow;
+  if (!isContained) {
+    owner->markDirtyAndPropogate();
+  }
+  return !isContained;
+}
 
-  node->setLayoutPosition(
-      YGRoundValueToPixelGrid(nodeTop, pointScaleFactor, false, textRounding),
-      YGEdgeTop);
+// Finds (following the `hasDirtyRelayoutBoundary` marks) and lays out the dirty
+// relayout boundaries which were not reached by the regular layout pass
+// because their ancestors were clean. The nodes on the way are marked as having
+// a new layout, so the clients traversing the tree can reach the boundaries.
+// `absoluteLeft` and `absoluteTop` are the unrounded absolute position of the
+// owner of `node`.
+// Returns true if another layout pass is needed.
+static bool YGLayoutDirtyRelayoutBoundaries(
+    const YGNodeRef node,
+    const double absoluteLeft,
+    const double absoluteTop,
+    const bool isBaselineSensitive,
+    LayoutData& layoutMarkerData,
+    void* const layoutContext,
+    const uint32_t generationCount) {
+  if (!node->hasDirtyRelayoutBoundary()) {
+    return false;
+  }
 
-  // We multiply dimension by scale factor and if the result is close to the
-  // whole number, we don't have any fraction To verify if the result is close
-  // to whole number we want to check both floor and ceil numbers
-  const bool hasFractionalWidth =
-      !YGDoubleEqual(fmod(nodeWidth * pointScaleFactor, 1.0), 0) &&
-      !YGDoubleEqual(fmod(nodeWidth * pointScaleFactor, 1.0), 1.0);
-  const bool hasFractionalHeight =
-      !YGDoubleEqual(fmod(nodeHeight * pointScaleFactor, 1.0), 0) &&
-      !YGDoubleEqual(fmod(nodeHeight * pointScaleFactor, 1.0), 1.0);
-
-  node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
-          absoluteNodeRight,
-          pointScaleFactor,
-          (textRounding && hasFractionalWidth),
-          (textRounding && !hasFractionalWidth)) -
-          YGRoundValueToPixelGrid(
-              absoluteNodeLeft, pointScaleFactor, false, textRounding),
-      YGDimensionWidth);
+  node->setHasDirtyRelayoutBoundary(false);
+  node->setHasNewLayout(true);
 
-  node->setLayoutDimension(
-      YGRoundValueToPixelGrid(
-          absoluteNodeBottom,
-          pointScaleFactor,
-          (textRounding && hasFractionalHeight),
-          (textRounding && !hasFractionalHeight)) -
-          YGRoundValueToPixelGrid(
-              absoluteNodeTop, pointScaleFactor, false, textRounding),
-      YGDimensionHeight);
+  const double absoluteNodeLeft =
+      absoluteLeft + node->getLayout().unroundedPosition[YGEdgeLeft];
+  const double absoluteNodeTop =
+      absoluteTop + node->getLayout().unroundedPosition[YGEdgeTop];
+  const bool isChildBaselineSensitive =
+      isBaselineSensitive || YGIsBaselineLayout(node);
 
+  bool needsAnotherPass = false;
   const uint32_t childCount = YGNodeGetChildCount(node);
   for (uint32_t i = 0; i < childCount; i++) {
-    YGRoundToPixelGrid(
-        YGNodeGetChild(node, i),
-        pointScaleFactor,
+    YGNodeRef child = node->getChild(i);
+    if (!child->isDirty() && !child->hasDirtyRelayoutBoundary()) {
+      continue;
+    }
+
+    if (child->getOwner() != node) {
+      child = node->getConfig()->cloneNode(child, node, i, layoutContext);
+      child->setOwner(node);
+      node->replaceChild(child, i);
+    }
+
+    if (child->isDirty()) {
+      needsAnotherPass |= YGLayoutRelayoutBoundary(
+          child,
+          node,
+          absoluteNodeLeft,
+          absoluteNodeTop,
+          isChildBaselineSensitive,
+          layoutMarkerData,
+          layoutContext,
+          generationCount);
+    }
+
+    needsAnotherPass |= YGLayoutDirtyRelayoutBoundaries(
+        child,
         absoluteNodeLeft,
-        absoluteNodeTop);
+        absoluteNodeTop,
+        isChildBaselineSensitive,
+        layoutMarkerData,
+        layoutContext,
+        generationCount);
   }
+
+  return needsAnotherPass;
 }
 
 static void unsetUseLegacyFlagRecursively(YGNodeRef node) {
@@ -4242,6 +4861,41 @@ YOGA_EXPORT void YGNodeCalculateLayoutWithContext(
 #endif
   }
 
+  // Laying out dirty relayout boundaries that the pass above did not reach. If
+  // some of them turn out to affect their owners, the owners are marked dirty
+  // and another (regular) pass is performed.
+  while (YGLayoutDirtyRelayoutBoundaries(
+      node,
+      0.0,
+      0.0,
+      false,
+      markerData,
+      layoutContext,
+      gCurrentGenerationCount.load(std::memory_order_relaxed))) {
+    gCurrentGenerationCount.fetch_add(1, std::memory_order_relaxed);
+    if (YGLayoutNodeInternal(
+            node,
+            width,
+            height,
+            ownerDirection,
+            widthMeasureMode,
+            heightMeasureMode,
+            ownerWidth,
+            ownerHeight,
+            true,
+            LayoutPassReason::kInitial,
+            node->getConfig(),
+            markerData,
+            layoutContext,
+            0, // tree root
+            gCurrentGenerationCount.load(std::memory_order_relaxed))) {
+      node->setPosition(
+          node->getLayout().direction(), ownerWidth, ownerHeight, ownerWidth);
+      YGRoundToPixelGrid(
+          node, node->getConfig()->pointScaleFactor, 0.0f, 0.0f);
+    }
+  }
+
   Event::publish<Event::LayoutPassEnd>(node, {layoutContext, &markerData});
 
   // We want to get rid off `useLegacyStretchBehaviour` from YGConfig. But we
@@ -4387,6 +5041,50 @@ YOGA_EXPORT void YGConfigSetUseLegacyStretchBehaviour(
   config->useLegacyStretchBehaviour = useLegacyStretchBehaviour;
 }
 
+YOGA_EXPORT YGMeasureCacheRef YGMeasureCacheNew(const uint32_t capacity) {
+  return new YGMeasureCache{capacity};
+}
+
+YOGA_EXPORT void YGMeasureCacheFree(const YGMeasureCacheRef cache) {
+  delete cache;
+}
+
+YOGA_EXPORT void YGMeasureCacheClear(const YGMeasureCacheRef cache) {
+  cache->clear();
+}
+
+YOGA_EXPORT void YGConfigSetMeasureCache(
+    const YGConfigRef config,
+    const YGMeasureCacheRef cache,
+    const YGMeasureContentHashFunc hashFunc) {
+  config->measureCache = cache;
+  config->measureContentHashFunc = hashFunc;
+}
+
+YOGA_EXPORT void YGConfigSetParallelForFunc(
+    const YGConfigRef config,
+    const YGParallelForFunc parallelFor) {
+  config->parallelForFunc = parallelFor;
+}
+
+YOGA_EXPORT void YGConfigSetParallelLayoutThreshold(
+    const YGConfigRef config,
+    const uint32_t threshold) {
+  config->parallelLayoutThreshold = threshold;
+}
+
+YOGA_EXPORT void YGConfigSetUseRelayoutBoundaries(
+    const YGConfigRef config,
+    const bool useRelayoutBoundaries) {
+  config->useRelayoutBoundaries = useRelayoutBoundaries;
+}
+
+YOGA_EXPORT void YGConfigSetDeferPixelGridRounding(
+    const YGConfigRef config,
+    const bool deferPixelGridRounding) {
+  config->deferPixelGridRounding = deferPixelGridRounding;
+}
+
 bool YGConfigGetUseWebDefaults(const YGConfigRef config) {
   return config->useWebDefaults;
 }
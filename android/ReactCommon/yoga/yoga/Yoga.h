@@ -31,6 +31,8 @@ typedef struct YGSize {
 
 typedef struct YGConfig* YGConfigRef;
 
+typedef struct YGMeasureCache* YGMeasureCacheRef;
+
 typedef struct YGNode* YGNodeRef;
 typedef const struct YGNode* YGNodeConstRef;
 
@@ -52,6 +54,13 @@ typedef int (*YGLogger)(
     va_list args);
 typedef YGNodeRef (
     *YGCloneNodeFunc)(YGNodeRef oldNode, YGNodeRef owner, int childIndex);
+typedef uint64_t (*YGMeasureContentHashFunc)(YGNodeRef node);
+typedef void (*YGParallelTaskFunc)(void* taskContext, uint32_t index);
+typedef void (*YGParallelForFunc)(
+    YGConfigRef config,
+    uint32_t count,
+    YGParallelTaskFunc task,
+    void* taskContext);
 
 // YGNode
 WIN_EXPORT YGNodeRef YGNodeNew(void);
@@ -322,6 +331,62 @@ WIN_EXPORT void YGConfigSetUseLegacyStretchBehaviour(
     YGConfigRef config,
     bool useLegacyStretchBehaviour);
 
+// Enables relayout boundaries: changes inside nodes with fixed dimensions (which
+// are not flexible and not aligned by baseline) stop propagating dirtiness at
+// those nodes, and the nodes are laid out on their own without re-entering
+// their clean ancestors.
+WIN_EXPORT void YGConfigSetUseRelayoutBoundaries(
+    YGConfigRef config,
+    bool useRelayoutBoundaries);
+
+// Leaves rounding the layout to the pixel grid to the client:
+// YGNodeCalculateLayout does not round it, and the client calls
+// YGNodesRoundToPixelGrid for the nodes it reads while walking the tree from the
+// root, so that every node is visited once.
+WIN_EXPORT void YGConfigSetDeferPixelGridRounding(
+    YGConfigRef config,
+    bool deferPixelGridRounding);
+
+// Sets an executor used to lay out independent children (flex items with
+// resolved sizes, stretched items and absolutely positioned children) of the
+// same node concurrently. The executor must call `task(taskContext, index)` for
+// every index in [0, count), possibly on other threads, and return only after
+// all of the calls have finished. Batches of fewer than `threshold` children
+// (and batches started from inside a task) are laid out on the calling thread.
+//
+// While an executor is set, the following can be called concurrently from the
+// executor's threads during YGNodeCalculateLayout:
+// - measure and baseline functions, for different nodes (never for the same
+//   node at the same time);
+// - the clone function of the config, for children of different owners (the
+//   children of one owner are always cloned on the same thread);
+// - the logger and Event subscribers (see yoga/event/event.h).
+// A measure cache set with YGConfigSetMeasureCache is already thread-safe.
+// The tree itself must not be mutated, or laid out from another thread, until
+// YGNodeCalculateLayout returns.
+WIN_EXPORT void YGConfigSetParallelForFunc(
+    YGConfigRef config,
+    YGParallelForFunc parallelFor);
+WIN_EXPORT void YGConfigSetParallelLayoutThreshold(
+    YGConfigRef config,
+    uint32_t threshold);
+
+// Sets a measure cache shared by all nodes using the config (and by other
+// configs using the same cache). Before calling the measure function of a node,
+// Yoga asks `hashFunc` for a hash of the content of the node; nodes with the
+// same non-zero hash are assumed to produce the same measurements for the same
+// constraints. Returning zero opts the node out of the shared cache. C++
+// clients can also set `YGConfig::measureContentFunc` to have the cache compare
+// the contents themselves, which rules out hash collisions. The cache is owned
+// by the caller and must outlive the configs using it.
+WIN_EXPORT YGMeasureCacheRef YGMeasureCacheNew(uint32_t capacity);
+WIN_EXPORT void YGMeasureCacheFree(YGMeasureCacheRef cache);
+WIN_EXPORT void YGMeasureCacheClear(YGMeasureCacheRef cache);
+WIN_EXPORT void YGConfigSetMeasureCache(
+    YGConfigRef config,
+    YGMeasureCacheRef cache,
+    YGMeasureContentHashFunc hashFunc);
+
 // YGConfig
 WIN_EXPORT YGConfigRef YGConfigNew(void);
 WIN_EXPORT void YGConfigFree(YGConfigRef config);
@@ -357,6 +422,20 @@ WIN_EXPORT float YGRoundValueToPixelGrid(
     bool forceCeil,
     bool forceFloor);
 
+// Rounds the layout of `count` nodes with the same owner (but not of their
+// descendants) to the pixel grid. `ownerAbsoluteLeft` and `ownerAbsoluteTop`
+// are the unrounded position of the owner relative to the root; the unrounded
+// positions of the nodes are stored in `absoluteLefts` and `absoluteTops`, to
+// be used when rounding their children.
+WIN_EXPORT void YGNodesRoundToPixelGrid(
+    const YGNodeRef* nodes,
+    uint32_t count,
+    float pointScaleFactor,
+    double ownerAbsoluteLeft,
+    double ownerAbsoluteTop,
+    double* absoluteLefts,
+    double* absoluteTops);
+
 YG_EXTERN_C_END
 
 #ifdef __cplusplus
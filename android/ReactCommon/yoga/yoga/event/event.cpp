@@ -12,6 +12,21 @@
 namespace facebook {
 namespace yoga {
 
+const char* LayoutTypeToString(const LayoutType value) {
+  switch (value) {
+    case LayoutType::kLayout:
+      return "layout";
+    case LayoutType::kMeasure:
+      return "measure";
+    case LayoutType::kCachedLayout:
+      return "cached_layout";
+    case LayoutType::kCachedMeasure:
+      return "cached_measure";
+    default:
+      return "unknown";
+  }
+}
+
 const char* LayoutPassReasonToString(const LayoutPassReason value) {
   switch (value) {
     case LayoutPassReason::kInitial:
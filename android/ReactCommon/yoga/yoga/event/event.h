@@ -23,7 +23,8 @@ enum struct LayoutType : int {
   kLayout = 0,
   kMeasure = 1,
   kCachedLayout = 2,
-  kCachedMeasure = 3
+  kCachedMeasure = 3,
+  COUNT
 };
 
 enum struct LayoutPassReason : int {
@@ -45,10 +46,18 @@ struct LayoutData {
   int cachedLayouts;
   int cachedMeasures;
   int measureCallbacks;
+  int sharedMeasureCacheHits;
+  int sharedMeasureCacheMisses;
   std::array<int, static_cast<uint8_t>(LayoutPassReason::COUNT)>
       measureCallbackReasonsCount;
+  // Number of `NodeLayout` events, by `LayoutType` and `LayoutPassReason`.
+  std::array<
+      std::array<int, static_cast<uint8_t>(LayoutPassReason::COUNT)>,
+      static_cast<uint8_t>(LayoutType::COUNT)>
+      nodeLayoutReasonsCount;
 };
 
+const char* LayoutTypeToString(const LayoutType value);
 const char* LayoutPassReasonToString(const LayoutPassReason value);
 
 struct YOGA_EXPORT Event {
@@ -140,6 +149,7 @@ template <>
 struct Event::TypedData<Event::NodeLayout> {
   LayoutType layoutType;
   void* layoutContext;
+  LayoutPassReason reason;
 };
 
 } // namespace yoga
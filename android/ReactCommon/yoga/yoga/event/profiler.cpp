@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace facebook {
+namespace yoga {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kMaxPassCount = 64;
+constexpr size_t kMaxSlowestMeasureCount = 16;
+
+// Layout passes and measure callbacks can be nested (e.g. a measure callback
+// can lay out another tree), so start times are kept on per-thread stacks.
+thread_local std::vector<Clock::time_point> passStartTimes;
+thread_local std::vector<Clock::time_point> measureStartTimes;
+
+double popDurationMs(std::vector<Clock::time_point>& startTimes) {
+  if (startTimes.empty()) {
+    // The profiler subscribed in the middle of the pass or callback.
+    return -1;
+  }
+  const auto duration = Clock::now() - startTimes.back();
+  startTimes.pop_back();
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void appendString(std::string& json, const std::string& value) {
+  json += '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          json += buffer;
+        } else {
+          json += c;
+        }
+    }
+  }
+  json += '"';
+}
+
+void appendNumber(std::string& json, const double value) {
+  if (std::isnan(value) || std::isinf(value)) {
+    json += "null";
+    return;
+  }
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.9g", value);
+  json += buffer;
+}
+
+void appendKey(std::string& json, const char* key) {
+  if (json.back() != '{') {
+    json += ',';
+  }
+  json += '"';
+  json += key;
+  json += "\":";
+}
+
+double ratio(const int part, const int total) {
+  return total == 0 ? 0 : static_cast<double>(part) / total;
+}
+
+void appendLayoutData(std::string& json, const LayoutData& data) {
+  appendKey(json, "layouts");
+  appendNumber(json, data.layouts);
+  appendKey(json, "measures");
+  appendNumber(json, data.measures);
+  appendKey(json, "cachedLayouts");
+  appendNumber(json, data.cachedLayouts);
+  appendKey(json, "cachedMeasures");
+  appendNumber(json, data.cachedMeasures);
+  appendKey(json, "layoutCacheHitRate");
+  appendNumber(
+      json, ratio(data.cachedLayouts, data.layouts + data.cachedLayouts));
+  appendKey(json, "measureCacheHitRate");
+  appendNumber(
+      json, ratio(data.cachedMeasures, data.measures + data.cachedMeasures));
+  appendKey(json, "maxMeasureCache");
+  appendNumber(json, data.maxMeasureCache);
+  appendKey(json, "measureCallbacks");
+  appendNumber(json, data.measureCallbacks);
+  appendKey(json, "sharedMeasureCacheHits");
+  appendNumber(json, data.sharedMeasureCacheHits);
+  appendKey(json, "sharedMeasureCacheMisses");
+  appendNumber(json, data.sharedMeasureCacheMisses);
+
+  appendKey(json, "measureCallbackReasons");
+  json += '{';
+  for (size_t reason = 0; reason < data.measureCallbackReasonsCount.size();
+       reason++) {
+    appendKey(
+        json,
+        LayoutPassReasonToString(static_cast<LayoutPassReason>(reason)));
+    appendNumber(json, data.measureCallbackReasonsCount[reason]);
+  }
+  json += '}';
+
+  appendKey(json, "nodeLayouts");
+  json += '{';
+  for (size_t type = 0; type < data.nodeLayoutReasonsCount.size(); type++) {
+    appendKey(json, LayoutTypeToString(static_cast<LayoutType>(type)));
+    json += '{';
+    for (size_t reason = 0; reason < data.nodeLayoutReasonsCount[type].size();
+         reason++) {
+      appendKey(
+          json,
+          LayoutPassReasonToString(static_cast<LayoutPassReason>(reason)));
+      appendNumber(json, data.nodeLayoutReasonsCount[type][reason]);
+    }
+    json += '}';
+  }
+  json += '}';
+}
+
+void addLayoutData(LayoutData& into, const LayoutData& from) {
+  into.layouts += from.layouts;
+  into.measures += from.measures;
+  into.maxMeasureCache = std::max(into.maxMeasureCache, from.maxMeasureCache);
+  into.cachedLayouts += from.cachedLayouts;
+  into.cachedMeasures += from.cachedMeasures;
+  into.measureCallbacks += from.measureCallbacks;
+  into.sharedMeasureCacheHits += from.sharedMeasureCacheHits;
+  into.sharedMeasureCacheMisses += from.sharedMeasureCacheMisses;
+  for (size_t i = 0; i < into.measureCallbackReasonsCount.size(); i++) {
+    into.measureCallbackReasonsCount[i] += from.measureCallbackReasonsCount[i];
+  }
+  for (size_t i = 0; i < into.nodeLayoutReasonsCount.size(); i++) {
+    for (size_t j = 0; j < into.nodeLayoutReasonsCount[i].size(); j++) {
+      into.nodeLayoutReasonsCount[i][j] += from.nodeLayoutReasonsCount[i][j];
+    }
+  }
+}
+
+} // namespace
+
+LayoutProfiler& LayoutProfiler::shared() {
+  // Never destroyed: there is no way to unsubscribe from events.
+  static auto profiler = new LayoutProfiler();
+  return *profiler;
+}
+
+void LayoutProfiler::setEnabled(const bool enabled) {
+  if (enabled) {
+    std::call_once(subscribeFlag_, [this]() {
+      Event::subscribe(
+          [this](const YGNode& node, Event::Type type, Event::Data data) {
+            onEvent(node, type, data);
+          });
+    });
+  }
+  enabled_ = enabled;
+}
+
+bool LayoutProfiler::isEnabled() const {
+  return enabled_;
+}
+
+void LayoutProfiler::setNodeDescriber(NodeDescriber nodeDescriber) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nodeDescriber_ = std::move(nodeDescriber);
+}
+
+void LayoutProfiler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  passes_.clear();
+  passCount_ = 0;
+  totalDurationMs_ = 0;
+  totals_ = {};
+  slowestMeasures_.clear();
+}
+
+size_t LayoutProfiler::getPassCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return passCount_;
+}
+
+LayoutData LayoutProfiler::getTotals() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return totals_;
+}
+
+void LayoutProfiler::onEvent(
+    const YGNode& node,
+    const Event::Type type,
+    const Event::Data& data) {
+  // Start times are tracked even while the profiler is disabled, so the
+  // durations stay paired correctly when it is toggled in the middle of a pass.
+  switch (type) {
+    case Event::LayoutPassStart:
+      passStartTimes.push_back(Clock::now());
+      break;
+    case Event::LayoutPassEnd: {
+      const double durationMs = popDurationMs(passStartTimes);
+      if (enabled_ && durationMs >= 0) {
+        recordPass(durationMs, *data.get<Event::LayoutPassEnd>().layoutData);
+      }
+      break;
+    }
+    case Event::MeasureCallbackStart:
+      measureStartTimes.push_back(Clock::now());
+      break;
+    case Event::MeasureCallbackEnd: {
+      const double durationMs = popDurationMs(measureStartTimes);
+      if (enabled_ && durationMs >= 0) {
+        recordMeasure(
+            node, durationMs, data.get<Event::MeasureCallbackEnd>());
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void LayoutProfiler::recordPass(
+    const double durationMs,
+    const LayoutData& layoutData) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  passes_.push_back({durationMs, layoutData});
+  if (passes_.size() > kMaxPassCount) {
+    passes_.pop_front();
+  }
+  passCount_++;
+  totalDurationMs_ += durationMs;
+  addLayoutData(totals_, layoutData);
+}
+
+void LayoutProfiler::recordMeasure(
+    const YGNode& node,
+    const double durationMs,
+    const Event::TypedData<Event::MeasureCallbackEnd>& data) {
+  NodeDescriber nodeDescriber;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (slowestMeasures_.size() == kMaxSlowestMeasureCount &&
+        slowestMeasures_.back().durationMs >= durationMs) {
+      return;
+    }
+    nodeDescriber = nodeDescriber_;
+  }
+
+  // Describing the node outside of the lock; the describer might be slow.
+  std::string description;
+  if (nodeDescriber) {
+    description = nodeDescriber(node);
+  } else {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%p", static_cast<const void*>(&node));
+    description = buffer;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto measure = Measure{std::move(description),
+                         durationMs,
+                         data.width,
+                         data.widthMeasureMode,
+                         data.height,
+                         data.heightMeasureMode,
+                         data.measuredWidth,
+                         data.measuredHeight,
+                         data.reason};
+  auto position = std::upper_bound(
+      slowestMeasures_.begin(),
+      slowestMeasures_.end(),
+      measure,
+      [](const Measure& lhs, const Measure& rhs) {
+        return lhs.durationMs > rhs.durationMs;
+      });
+  slowestMeasures_.insert(position, std::move(measure));
+  if (slowestMeasures_.size() > kMaxSlowestMeasureCount) {
+    slowestMeasures_.pop_back();
+  }
+}
+
+std::string LayoutProfiler::toJSON() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::string json = "{";
+  appendKey(json, "passCount");
+  appendNumber(json, passCount_);
+  appendKey(json, "totalDurationMs");
+  appendNumber(json, totalDurationMs_);
+
+  appendKey(json, "totals");
+  json += '{';
+  appendLayoutData(json, totals_);
+  json += '}';
+
+  appendKey(json, "passes");
+  json += '[';
+  for (const auto& pass : passes_) {
+    if (json.back() != '[') {
+      json += ',';
+    }
+    json += '{';
+    appendKey(json, "durationMs");
+    appendNumber(json, pass.durationMs);
+    appendLayoutData(json, pass.layoutData);
+    json += '}';
+  }
+  json += ']';
+
+  appendKey(json, "slowestMeasures");
+  json += '[';
+  for (const auto& measure : slowestMeasures_) {
+    if (json.back() != '[') {
+      json += ',';
+    }
+    json += '{';
+    appendKey(json, "node");
+    appendString(json, measure.node);
+    appendKey(json, "durationMs");
+    appendNumber(json, measure.durationMs);
+    appendKey(json, "width");
+    appendNumber(json, measure.width);
+    appendKey(json, "widthMeasureMode");
+    appendString(json, YGMeasureModeToString(measure.widthMeasureMode));
+    appendKey(json, "height");
+    appendNumber(json, measure.height);
+    appendKey(json, "heightMeasureMode");
+    appendString(json, YGMeasureModeToString(measure.heightMeasureMode));
+    appendKey(json, "measuredWidth");
+    appendNumber(json, measure.measuredWidth);
+    appendKey(json, "measuredHeight");
+    appendNumber(json, measure.measuredHeight);
+    appendKey(json, "reason");
+    appendString(json, LayoutPassReasonToString(measure.reason));
+    json += '}';
+  }
+  json += ']';
+
+  json += '}';
+  return json;
+}
+
+} // namespace yoga
+} // namespace facebook
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "event.h"
+
+namespace facebook {
+namespace yoga {
+
+// Aggregates Yoga events into a profile of layout passes that can be exported
+// as JSON. The profile contains the duration and the `LayoutData` (node visits
+// by `LayoutType` and `LayoutPassReason`, cache usage) of the recent layout
+// passes, totals over all profiled passes, and the slowest measure callbacks.
+//
+// The profiler subscribes to the events when it is enabled for the first time
+// and ignores them while it is disabled. Note that events are only published
+// if Yoga is built with `YG_ENABLE_EVENTS`, which is off by default (see the
+// `yoga.enable_events` Buck config, `YOGA_ENABLE_EVENTS` for Android.mk and
+// for the podspec); otherwise the profile stays empty.
+class YOGA_EXPORT LayoutProfiler {
+public:
+  using NodeDescriber = std::function<std::string(const YGNode&)>;
+
+  static LayoutProfiler& shared();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  // Sets a function describing the nodes of the slowest measure callbacks
+  // (e.g. by the name of the component). By default, nodes are described by
+  // their addresses.
+  void setNodeDescriber(NodeDescriber nodeDescriber);
+
+  void reset();
+  std::string toJSON() const;
+
+  // The number of profiled passes and their aggregated `LayoutData`.
+  size_t getPassCount() const;
+  LayoutData getTotals() const;
+
+private:
+  struct Pass {
+    double durationMs;
+    LayoutData layoutData;
+  };
+
+  struct Measure {
+    std::string node;
+    double durationMs;
+    float width;
+    YGMeasureMode widthMeasureMode;
+    float height;
+    YGMeasureMode heightMeasureMode;
+    float measuredWidth;
+    float measuredHeight;
+    LayoutPassReason reason;
+  };
+
+  LayoutProfiler() = default;
+
+  void onEvent(const YGNode& node, Event::Type type, const Event::Data& data);
+  void recordPass(double durationMs, const LayoutData& layoutData);
+  void recordMeasure(
+      const YGNode& node,
+      double durationMs,
+      const Event::TypedData<Event::MeasureCallbackEnd>& data);
+
+  std::atomic<bool> enabled_{false};
+  std::once_flag subscribeFlag_;
+
+  mutable std::mutex mutex_;
+  NodeDescriber nodeDescriber_;
+  std::deque<Pass> passes_;
+  size_t passCount_ = 0;
+  double totalDurationMs_ = 0;
+  LayoutData totals_ = {};
+  // Sorted by duration, the slowest first.
+  std::vector<Measure> slowestMeasures_;
+};
+
+} // namespace yoga
+} // namespace facebook